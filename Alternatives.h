@@ -0,0 +1,547 @@
+#ifndef ALTERNATIVES_H
+#define ALTERNATIVES_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "Reseau.h"
+#include "Recherche.h"
+#include "Fermetures.h"
+#include "Virages.h"
+
+/* ===================== Itinéraires multiples ===================== */
+/*
+ * Deux façons de proposer plusieurs itinéraires :
+ *  - les k plus courts chemins sans boucle (Yen) pour une métrique fixe. L'arbre des plus courts
+ *    chemins vers la cible est calculé une fois : une déviation dont la suite sur l'arbre n'est pas
+ *    bloquée la prend telle quelle, sinon un A* guidé par les distances de l'arbre (exactes tant
+ *    que rien n'est bloqué) la trouve en visitant peu de nœuds. Les déviations ne partent que du
+ *    point où le chemin parent s'écarte du sien (Lawler) ;
+ *  - des alternatives « utiles » : coût au plus etirementMax fois l'optimal, et pas plus de
+ *    partageMax de leur longueur en commun avec une alternative déjà retenue. Chaque itinéraire
+ *    trouvé voit ses arêtes pénalisées avant la recherche suivante. La recherche est confiée à un
+ *    oracle : Dijkstra, recherche sur les arêtes avec virages, routage multiniveau...
+ */
+
+/* Oracle : itinéraire de source à cible quand le coût de chaque arête d'origine e est multiplié par
+   penalite[e]. modifiees liste les arêtes dont la pénalité a changé depuis l'appel précédent. */
+typedef Itineraire (*OracleItineraire)(void* contexte, const double* penalite, const int* modifiees, int nbModifiees,
+                                       int source, int cible);
+/* Coût réel (sans pénalité) d'un itinéraire, INFINITY s'il est impraticable */
+typedef double (*CoutItineraire)(void* contexte, const Itineraire* it);
+
+typedef struct {
+    int nbMax;               // Nombre d'itinéraires voulus, le meilleur compris
+    double etirementMax;     // Coût maximal, en multiple du meilleur (ex. 1.4)
+    double partageMax;       // Part maximale de la longueur commune avec un itinéraire retenu (ex. 0.6)
+    double facteurPenalite;  // Multiplie le coût des arêtes de chaque itinéraire trouvé (ex. 1.5)
+    int essaisMax;           // Appels à l'oracle au plus
+} ParametresAlternatives;
+
+/* Réglages usuels : au plus 40 % plus long que le meilleur, 60 % de longueur commune au plus */
+static inline ParametresAlternatives alternatives_parametres(int nbMax) {
+    ParametresAlternatives prm = { nbMax, 1.4, 0.6, 1.5, 4 * nbMax };
+    return prm;
+}
+
+/* Chemin sous forme d'arêtes (indices CSR) */
+typedef struct {
+    int* aretes;
+    int nbAretes;
+    int deviation;           // Rang de l'arête où il quitte son parent (Yen)
+    double cout;
+} CheminAretes;
+
+typedef struct {
+    int nbNoeuds;
+    int nbAretes;            // Arcs du réseau
+    int nbAretesOrigine;     // Plus grand idArete + 1
+    EspaceRecherche espace;  // Recherches de déviation
+    double* versCible;       // Distance de chaque nœud à la cible sur l'arbre
+    int* suivant;            // Arête (CSR) suivante vers la cible sur l'arbre, -1 si aucune
+    int* debutEntrantes;     // Arêtes entrantes du nœud v : entrantes[debutEntrantes[v] .. debutEntrantes[v+1]-1]
+    int* entrantes;
+    int* origine;            // Nœud de départ de chaque arête (CSR)
+    unsigned int* bloqueNoeud; // Bloqué pendant la déviation numéro 'tampon'
+    unsigned int* bloqueArete;
+    unsigned int* marqueArete; // Arêtes d'origine de l'itinéraire numéro 'tampon' (partage)
+    unsigned int tampon;
+    double* penalite;        // Par arête d'origine, 1 hors des recherches
+    int* modifiees;          // Arêtes dont la pénalité a changé depuis le dernier appel à l'oracle
+    int nbModifiees;
+} EspaceAlternatives;
+
+void espace_alternatives_liberer(EspaceAlternatives* e) {
+    espace_liberer(&e->espace);
+    free(e->versCible);
+    free(e->suivant);
+    free(e->debutEntrantes);
+    free(e->entrantes);
+    free(e->origine);
+    free(e->bloqueNoeud);
+    free(e->bloqueArete);
+    free(e->marqueArete);
+    free(e->penalite);
+    free(e->modifiees);
+    memset(e, 0, sizeof(EspaceAlternatives));
+}
+
+/**
+ * Prépare l'espace de travail pour le réseau r (arêtes entrantes de chaque nœud comprises).
+ */
+int espace_alternatives_init(EspaceAlternatives* e, const Reseau* r) {
+    int n = r->nbNoeuds, m = r->nbAretes, u, k;
+    memset(e, 0, sizeof(EspaceAlternatives));
+    e->nbNoeuds = n;
+    e->nbAretes = m;
+    for (k = 0; k < m; k++)
+        if (r->idArete[k] + 1 > e->nbAretesOrigine) e->nbAretesOrigine = r->idArete[k] + 1;
+    int mo = e->nbAretesOrigine > 0 ? e->nbAretesOrigine : 1;
+    e->versCible = (double*)malloc(sizeof(double) * (n > 0 ? n : 1));
+    e->suivant = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    e->debutEntrantes = (int*)calloc(n + 1, sizeof(int));
+    e->entrantes = (int*)malloc(sizeof(int) * (m > 0 ? m : 1));
+    e->origine = (int*)malloc(sizeof(int) * (m > 0 ? m : 1));
+    e->bloqueNoeud = (unsigned int*)calloc(n > 0 ? n : 1, sizeof(unsigned int));
+    e->bloqueArete = (unsigned int*)calloc(m > 0 ? m : 1, sizeof(unsigned int));
+    e->marqueArete = (unsigned int*)calloc(mo, sizeof(unsigned int));
+    e->penalite = (double*)malloc(sizeof(double) * mo);
+    e->modifiees = (int*)malloc(sizeof(int) * mo);
+    if (!e->versCible || !e->suivant || !e->debutEntrantes || !e->entrantes || !e->origine || !e->bloqueNoeud || !e->bloqueArete ||
+        !e->marqueArete || !e->penalite || !e->modifiees || !espace_init(&e->espace, n)) {
+        espace_alternatives_liberer(e);
+        return 0;
+    }
+    for (k = 0; k < mo; k++) e->penalite[k] = 1.0;
+    // Arêtes entrantes, par comptage
+    for (k = 0; k < m; k++) e->debutEntrantes[r->cible[k] + 1]++;
+    for (u = 0; u < n; u++) e->debutEntrantes[u + 1] += e->debutEntrantes[u];
+    for (u = 0; u < n; u++)
+        for (k = r->debut[u]; k < r->debut[u + 1]; k++) {
+            e->entrantes[e->debutEntrantes[r->cible[k]]++] = k;
+            e->origine[k] = u;
+        }
+    for (u = n; u > 0; u--) e->debutEntrantes[u] = e->debutEntrantes[u - 1];
+    e->debutEntrantes[0] = 0;
+    return 1;
+}
+
+/* Nouveau numéro de marquage (les tableaux sont remis à zéro quand il reboucle) */
+static unsigned int alternatives_tampon(EspaceAlternatives* e) {
+    if (++e->tampon == 0) {
+        memset(e->bloqueNoeud, 0, sizeof(unsigned int) * (e->nbNoeuds > 0 ? e->nbNoeuds : 1));
+        memset(e->bloqueArete, 0, sizeof(unsigned int) * (e->nbAretes > 0 ? e->nbAretes : 1));
+        memset(e->marqueArete, 0, sizeof(unsigned int) * (e->nbAretesOrigine > 0 ? e->nbAretesOrigine : 1));
+        e->tampon = 1;
+    }
+    return e->tampon;
+}
+
+/* Coût de l'arête k (indice CSR) : métrique par arête d'origine, ou longueur ; INFINITY si fermée */
+static inline double alternatives_cout(const Reseau* r, const double* metrique, const Fermetures* f, int k) {
+    double c = metrique ? metrique[r->idArete[k]] : r->poids[k];
+    return fermetures_cout(f, r->idArete[k], c);
+}
+
+/* Arbre inverse des plus courts chemins vers la cible (Dijkstra sur les arêtes entrantes) */
+static void alternatives_arbre(const Reseau* r, const double* metrique, const Fermetures* f, int cible,
+                               EspaceAlternatives* e) {
+    int u, j;
+    for (u = 0; u < r->nbNoeuds; u++) {
+        e->versCible[u] = INFINITY;
+        e->suivant[u] = -1;
+    }
+    Tas* tas = &e->espace.tas;
+    tas->taille = 0;
+    e->versCible[cible] = 0.0;
+    tas_inserer(tas, 0.0, cible);
+    while (tas->taille > 0) {
+        ElementTas x = tas_extraire(tas);
+        int v = x.valeur;
+        if (x.cle > e->versCible[v]) continue;
+        for (j = e->debutEntrantes[v]; j < e->debutEntrantes[v + 1]; j++) {
+            int k = e->entrantes[j];
+            double c = alternatives_cout(r, metrique, f, k);
+            int w = e->origine[k];
+            if (c == INFINITY || x.cle + c >= e->versCible[w]) continue;
+            e->versCible[w] = x.cle + c;
+            e->suivant[w] = k;
+            tas_inserer(tas, x.cle + c, w);
+        }
+    }
+}
+
+static void chemin_aretes_liberer(CheminAretes* c) {
+    free(c->aretes);
+    c->aretes = NULL;
+    c->nbAretes = 0;
+}
+
+/* Nœuds d'un chemin d'arêtes (la source, puis le bout de chaque arête) */
+static Itineraire chemin_vers_itineraire(const Reseau* r, const CheminAretes* c, int source) {
+    Itineraire it = { NULL, 0, 0.0 };
+    int i;
+    it.noeuds = (int*)malloc(sizeof(int) * (c->nbAretes + 1));
+    if (!it.noeuds) return it;
+    it.noeuds[0] = source;
+    for (i = 0; i < c->nbAretes; i++) it.noeuds[i + 1] = r->cible[c->aretes[i]];
+    it.longueur = c->nbAretes + 1;
+    it.cout = c->cout;
+    return it;
+}
+
+/*
+ * A* de depart à cible guidé par versCible, qui reste une borne inférieure tant que les coûts ne
+ * font que croître : nœuds et arêtes bloqués (numéro 'tampon') évités, coût de chaque arête
+ * multiplié par penalite (par arête d'origine, NULL : aucune). Retourne 1 si la cible est atteinte.
+ */
+static int alternatives_astar(const Reseau* r, const double* metrique, const Fermetures* f, const double* penalite,
+                              int depart, int cible, EspaceAlternatives* e) {
+    unsigned int t = e->tampon;
+    int k;
+    EspaceRecherche* es = &e->espace;
+    espace_nouvelle_recherche(es);
+    if (e->versCible[depart] == INFINITY) return 0;
+    espace_fixer(es, depart, 0.0, -1, -1);
+    tas_inserer(&es->tas, e->versCible[depart], depart);
+    while (es->tas.taille > 0) {
+        ElementTas x = tas_extraire(&es->tas);
+        int u = x.valeur;
+        double du = espace_dist(es, u);
+        if (x.cle > du + e->versCible[u] + 1e-9) continue;
+        if (u == cible) return 1;
+        for (k = r->debut[u]; k < r->debut[u + 1]; k++) {
+            int v = r->cible[k];
+            if (e->bloqueArete[k] == t || e->bloqueNoeud[v] == t || e->versCible[v] == INFINITY) continue;
+            double c = alternatives_cout(r, metrique, f, k);
+            if (c == INFINITY) continue;
+            if (penalite) c *= penalite[r->idArete[k]];
+            if (du + c < espace_dist(es, v)) {
+                espace_fixer(es, v, du + c, u, k);
+                tas_inserer(&es->tas, du + c + e->versCible[v], v);
+            }
+        }
+    }
+    return 0;
+}
+
+/*
+ * Déviation depuis le nœud 'depart' vers la cible en évitant les nœuds et arêtes bloqués : la suite
+ * sur l'arbre si elle est libre, sinon A*. Les arêtes sont écrites dans 'aretes' (capacité : une
+ * arête par nœud) ; retourne leur nombre, -1 si la cible est inaccessible.
+ */
+static int alternatives_deviation(const Reseau* r, const double* metrique, const Fermetures* f, int depart, int cible,
+                                  EspaceAlternatives* e, int* aretes, double* cout) {
+    unsigned int t = e->tampon;
+    int u = depart, n = 0;
+    while (u != cible && e->suivant[u] >= 0 && e->bloqueArete[e->suivant[u]] != t &&
+           e->bloqueNoeud[r->cible[e->suivant[u]]] != t) {
+        aretes[n++] = e->suivant[u];
+        u = r->cible[e->suivant[u]];
+    }
+    if (u == cible) {
+        *cout = e->versCible[depart];
+        return n;
+    }
+    if (!alternatives_astar(r, metrique, f, NULL, depart, cible, e)) return -1;
+    EspaceRecherche* es = &e->espace;
+    *cout = es->dist[cible];
+    n = 0;
+    for (u = cible; u != depart; u = es->parent[u]) n++;
+    int i = n;
+    for (u = cible; u != depart; u = es->parent[u]) aretes[--i] = es->parentArete[u];
+    return n;
+}
+
+static int chemins_egaux(const CheminAretes* a, const CheminAretes* b) {
+    return a->nbAretes == b->nbAretes && memcmp(a->aretes, b->aretes, sizeof(int) * a->nbAretes) == 0;
+}
+
+/**
+ * Les k plus courts chemins sans boucle de source à cible pour la métrique donnée (par arête
+ * d'origine, NULL : longueurs du réseau), arêtes fermées exclues. Remplit chemins[0 .. k-1] par
+ * coût croissant et retourne leur nombre (moins de k si le réseau n'en a pas autant).
+ */
+int yen_k_plus_courts(const Reseau* r, const double* metrique, const Fermetures* f, int source, int cible, int k,
+                      Itineraire* chemins, EspaceAlternatives* e) {
+    CheminAretes* A = (CheminAretes*)calloc(k > 0 ? k : 1, sizeof(CheminAretes));
+    CheminAretes* B = NULL;
+    int nbA = 0, nbB = 0, capaciteB = 0, i, j, p;
+    int* tampon = (int*)malloc(sizeof(int) * (r->nbNoeuds + 1));
+    if (!A || !tampon || source < 0 || source >= r->nbNoeuds || cible < 0 || cible >= r->nbNoeuds || k <= 0) {
+        free(A);
+        free(tampon);
+        return 0;
+    }
+    alternatives_arbre(r, metrique, f, cible, e);
+    // Le plus court chemin suit l'arbre
+    alternatives_tampon(e);
+    double c;
+    int n = alternatives_deviation(r, metrique, f, source, cible, e, tampon, &c);
+    if (n >= 0) {
+        A[0].aretes = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+        if (A[0].aretes) {
+            memcpy(A[0].aretes, tampon, sizeof(int) * n);
+            A[0].nbAretes = n;
+            A[0].cout = c;
+            nbA = 1;
+        }
+    }
+    while (nbA > 0 && nbA < k) {
+        CheminAretes* dernier = &A[nbA - 1];
+        double coutRacine = 0.0;
+        for (i = 0; i < dernier->deviation; i++) coutRacine += alternatives_cout(r, metrique, f, dernier->aretes[i]);
+        for (i = dernier->deviation; i < dernier->nbAretes; i++) {
+            int depart = i == 0 ? source : r->cible[dernier->aretes[i - 1]];
+            unsigned int t = alternatives_tampon(e);
+            // Nœuds de la racine bloqués ; arête suivante bloquée pour chaque chemin de même racine
+            e->bloqueNoeud[source] = t;
+            for (j = 0; j < i; j++) e->bloqueNoeud[r->cible[dernier->aretes[j]]] = t;
+            e->bloqueNoeud[depart] = 0;
+            for (p = 0; p < nbA; p++)
+                if (A[p].nbAretes > i && memcmp(A[p].aretes, dernier->aretes, sizeof(int) * i) == 0)
+                    e->bloqueArete[A[p].aretes[i]] = t;
+            memcpy(tampon, dernier->aretes, sizeof(int) * i);
+            n = alternatives_deviation(r, metrique, f, depart, cible, e, tampon + i, &c);
+            if (n >= 0) {
+                CheminAretes candidat = { tampon, i + n, i, coutRacine + c };
+                int connu = 0;
+                for (p = 0; p < nbB && !connu; p++) connu = chemins_egaux(&B[p], &candidat);
+                for (p = 0; p < nbA && !connu; p++) connu = chemins_egaux(&A[p], &candidat);
+                if (!connu) {
+                    if (nbB == capaciteB) {
+                        int cap = capaciteB ? 2 * capaciteB : 16;
+                        CheminAretes* t2 = (CheminAretes*)realloc(B, sizeof(CheminAretes) * cap);
+                        if (!t2) break;
+                        B = t2;
+                        capaciteB = cap;
+                    }
+                    B[nbB] = candidat;
+                    B[nbB].aretes = (int*)malloc(sizeof(int) * (candidat.nbAretes > 0 ? candidat.nbAretes : 1));
+                    if (!B[nbB].aretes) break;
+                    memcpy(B[nbB].aretes, tampon, sizeof(int) * candidat.nbAretes);
+                    nbB++;
+                }
+            }
+            coutRacine += alternatives_cout(r, metrique, f, dernier->aretes[i]);
+        }
+        if (nbB == 0) break;
+        // Le meilleur candidat devient le chemin suivant
+        int meilleur = 0;
+        for (p = 1; p < nbB; p++)
+            if (B[p].cout < B[meilleur].cout) meilleur = p;
+        A[nbA++] = B[meilleur];
+        B[meilleur] = B[--nbB];
+    }
+    for (p = 0; p < nbA; p++) {
+        chemins[p] = chemin_vers_itineraire(r, &A[p], source);
+        chemin_aretes_liberer(&A[p]);
+    }
+    for (p = 0; p < nbB; p++) chemin_aretes_liberer(&B[p]);
+    free(A);
+    free(B);
+    free(tampon);
+    return nbA;
+}
+
+/* Arêtes d'origine d'un itinéraire (entre deux nœuds, la plus courte) ; longueur totale retournée */
+static double alternatives_marquer(const Reseau* r, const Itineraire* it, unsigned int* marque, unsigned int t) {
+    double longueur = 0.0;
+    int i, k;
+    for (i = 1; i < it->longueur; i++) {
+        int meilleure = -1;
+        for (k = r->debut[it->noeuds[i - 1]]; k < r->debut[it->noeuds[i - 1] + 1]; k++)
+            if (r->cible[k] == it->noeuds[i] && (meilleure < 0 || r->poids[k] < r->poids[meilleure])) meilleure = k;
+        if (meilleure < 0) continue;
+        if (marque) marque[r->idArete[meilleure]] = t;
+        longueur += r->poids[meilleure];
+    }
+    return longueur;
+}
+
+/* Longueur de l'itinéraire sur les arêtes marquées t */
+static double alternatives_commun(const Reseau* r, const Itineraire* it, const unsigned int* marque, unsigned int t) {
+    double commun = 0.0;
+    int i, k;
+    for (i = 1; i < it->longueur; i++) {
+        int meilleure = -1;
+        for (k = r->debut[it->noeuds[i - 1]]; k < r->debut[it->noeuds[i - 1] + 1]; k++)
+            if (r->cible[k] == it->noeuds[i] && (meilleure < 0 || r->poids[k] < r->poids[meilleure])) meilleure = k;
+        if (meilleure >= 0 && marque[r->idArete[meilleure]] == t) commun += r->poids[meilleure];
+    }
+    return commun;
+}
+
+/**
+ * Alternatives par pénalités : le premier itinéraire de l'oracle est retenu, puis ses arêtes sont
+ * pénalisées et l'oracle rappelé. Un itinéraire est retenu si son coût réel ne dépasse pas
+ * etirementMax fois celui du premier et s'il ne partage pas plus de partageMax de sa longueur avec
+ * chacun des itinéraires déjà retenus. Remplit resultats (prm->nbMax places) et retourne leur nombre.
+ */
+int alternatives_itineraires(const Reseau* r, const ParametresAlternatives* prm, OracleItineraire oracle,
+                             CoutItineraire cout, void* contexte, int source, int cible, Itineraire* resultats,
+                             EspaceAlternatives* e) {
+    int nb = 0, essai, i, nbPenalisees = 0;
+    double meilleur = INFINITY;
+    // Toutes les arêtes pénalisées, pour tout remettre à 1 à la fin
+    int* penalisees = (int*)malloc(sizeof(int) * (e->nbAretesOrigine > 0 ? e->nbAretesOrigine : 1));
+    if (!penalisees) return 0;
+    for (essai = 0; essai < prm->essaisMax && nb < prm->nbMax; essai++) {
+        Itineraire it = oracle(contexte, e->penalite, e->modifiees, e->nbModifiees, source, cible);
+        e->nbModifiees = 0;
+        if (it.longueur == 0) break;
+        double c = cout(contexte, &it);
+        int retenu = 0;
+        if (nb == 0) {
+            if (c == INFINITY) {
+                itineraire_liberer(&it);
+                break;
+            }
+            retenu = 1;
+            meilleur = c;
+        } else if (c <= prm->etirementMax * meilleur) {
+            double longueur = alternatives_marquer(r, &it, NULL, 0);
+            retenu = longueur > 0.0; // Source et cible confondues : un seul itinéraire
+            for (i = 0; i < nb && retenu; i++) {
+                unsigned int t = alternatives_tampon(e);
+                alternatives_marquer(r, &resultats[i], e->marqueArete, t);
+                retenu = alternatives_commun(r, &it, e->marqueArete, t) <= prm->partageMax * longueur;
+            }
+        }
+        // Pénalité sur les arêtes de l'itinéraire, retenu ou non, pour chercher ailleurs
+        unsigned int t = alternatives_tampon(e);
+        alternatives_marquer(r, &it, e->marqueArete, t);
+        int j;
+        for (i = 1; i < it.longueur; i++)
+            for (j = r->debut[it.noeuds[i - 1]]; j < r->debut[it.noeuds[i - 1] + 1]; j++) {
+                int a = r->idArete[j];
+                if (r->cible[j] != it.noeuds[i] || e->marqueArete[a] != t) continue;
+                e->marqueArete[a] = 0; // Une seule fois par itinéraire
+                if (e->penalite[a] == 1.0) penalisees[nbPenalisees++] = a;
+                e->penalite[a] *= prm->facteurPenalite;
+                e->modifiees[e->nbModifiees++] = a;
+            }
+        if (retenu) {
+            it.cout = c;
+            resultats[nb++] = it;
+        } else {
+            itineraire_liberer(&it);
+        }
+    }
+    // Pénalités remises à 1 ; l'oracle en est prévenu au premier appel de la requête suivante
+    for (i = 0; i < nbPenalisees; i++) {
+        e->penalite[penalisees[i]] = 1.0;
+        e->modifiees[i] = penalisees[i];
+    }
+    e->nbModifiees = nbPenalisees;
+    free(penalisees);
+    // Par coût croissant (tri par insertion : peu d'itinéraires)
+    for (i = 1; i < nb; i++) {
+        Itineraire x = resultats[i];
+        int j = i - 1;
+        while (j >= 0 && resultats[j].cout > x.cout) {
+            resultats[j + 1] = resultats[j];
+            j--;
+        }
+        resultats[j + 1] = x;
+    }
+    return nb;
+}
+
+/* Oracle sur une métrique fixe : A* guidé par l'arbre vers la cible calculé sans pénalité */
+typedef struct {
+    const Reseau* r;
+    const double* metrique;
+    const Fermetures* fermetures;
+    EspaceAlternatives* espace;
+} OracleMetrique;
+
+static Itineraire oracle_metrique(void* contexte, const double* penalite, const int* modifiees, int nbModifiees,
+                                  int source, int cible) {
+    OracleMetrique* o = (OracleMetrique*)contexte;
+    Itineraire it = { NULL, 0, 0.0 };
+    (void)modifiees;
+    (void)nbModifiees;
+    alternatives_tampon(o->espace); // Rien de bloqué
+    if (alternatives_astar(o->r, o->metrique, o->fermetures, penalite, source, cible, o->espace))
+        it = espace_itineraire(&o->espace->espace, source, cible);
+    return it;
+}
+
+static double cout_metrique(void* contexte, const Itineraire* it) {
+    OracleMetrique* o = (OracleMetrique*)contexte;
+    const Reseau* r = o->r;
+    double cout = 0.0;
+    int i, k;
+    for (i = 1; i < it->longueur; i++) {
+        double meilleur = INFINITY;
+        for (k = r->debut[it->noeuds[i - 1]]; k < r->debut[it->noeuds[i - 1] + 1]; k++)
+            if (r->cible[k] == it->noeuds[i]) {
+                double c = alternatives_cout(r, o->metrique, o->fermetures, k);
+                if (c < meilleur) meilleur = c;
+            }
+        cout += meilleur;
+    }
+    return cout;
+}
+
+/**
+ * Alternatives pour une métrique fixe (par arête d'origine, NULL : longueurs du réseau).
+ */
+int alternatives_metrique(const Reseau* r, const double* metrique, const Fermetures* f,
+                          const ParametresAlternatives* prm, int source, int cible, Itineraire* resultats,
+                          EspaceAlternatives* e) {
+    OracleMetrique o = { r, metrique, f, e };
+    if (source < 0 || source >= r->nbNoeuds || cible < 0 || cible >= r->nbNoeuds) return 0;
+    alternatives_arbre(r, metrique, f, cible, e);
+    return alternatives_itineraires(r, prm, oracle_metrique, cout_metrique, &o, source, cible, resultats, e);
+}
+
+/* Oracle avec virages et feux : les pénalités ralentissent les arêtes (facteurArete) */
+typedef struct {
+    const Reseau* r;
+    const ParametresTemporels* base;
+    ParametresTemporels prm;     // Copie de base, facteurArete pointant sur 'facteur'
+    double* facteur;             // Par arête d'origine : facteur de base × pénalité
+    const Virages* virages;
+    EspaceVirages* espace;
+    double depart;
+} OracleVirages;
+
+static Itineraire oracle_virages(void* contexte, const double* penalite, const int* modifiees, int nbModifiees,
+                                 int source, int cible) {
+    OracleVirages* o = (OracleVirages*)contexte;
+    int i;
+    for (i = 0; i < nbModifiees; i++) {
+        int a = modifiees[i];
+        o->facteur[a] = (o->base->facteurArete ? o->base->facteurArete[a] : 1.0) * penalite[a];
+    }
+    return itineraire_virages(o->r, &o->prm, o->virages, source, cible, o->depart, o->espace);
+}
+
+static double cout_virages(void* contexte, const Itineraire* it) {
+    OracleVirages* o = (OracleVirages*)contexte;
+    return itineraire_duree_virages(o->r, o->base, o->virages, it, o->depart) - o->depart;
+}
+
+/**
+ * Alternatives à l'itinéraire le plus rapide partant à la date 'depart', virages et feux compris.
+ * Le coût des itinéraires rendus est leur durée.
+ */
+int alternatives_virages(const Reseau* r, const ParametresTemporels* prm, const Virages* v,
+                         const ParametresAlternatives* pa, int source, int cible, double depart,
+                         Itineraire* resultats, EspaceAlternatives* e, EspaceVirages* ev) {
+    OracleVirages o = { r, prm, *prm, NULL, v, ev, depart };
+    int a, nb;
+    if (source < 0 || source >= r->nbNoeuds || cible < 0 || cible >= r->nbNoeuds) return 0;
+    o.facteur = (double*)malloc(sizeof(double) * (e->nbAretesOrigine > 0 ? e->nbAretesOrigine : 1));
+    if (!o.facteur) return 0;
+    for (a = 0; a < e->nbAretesOrigine; a++) o.facteur[a] = prm->facteurArete ? prm->facteurArete[a] : 1.0;
+    o.prm.facteurArete = o.facteur;
+    nb = alternatives_itineraires(r, pa, oracle_virages, cout_virages, &o, source, cible, resultats, e);
+    free(o.facteur);
+    return nb;
+}
+
+#endif
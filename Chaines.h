@@ -0,0 +1,98 @@
+#ifndef CHAINES_H
+#define CHAINES_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ===================== Table de chaînes internées ===================== */
+/*
+ * Chaque chaîne distincte n'est stockée qu'une fois, à la suite des autres dans un seul
+ * tampon, et désignée par sa position dans ce tampon. Les noms de types ("Station",
+ * "Carrefour"...) répétés sur des milliers de nœuds ne coûtent alors qu'un entier par nœud.
+ * Une table de hachage à adressage ouvert retrouve la position d'une chaîne déjà connue.
+ */
+
+typedef struct {
+    char* textes;      // Chaînes terminées par '\0', à la suite
+    int taille, capacite;
+    int* cases;        // Position de la chaîne + 1, 0 si la case est vide
+    int nbCases;       // Puissance de 2
+    int nbChaines;
+} TableChaines;
+
+void chaines_init(TableChaines* t) {
+    memset(t, 0, sizeof(TableChaines));
+}
+
+void chaines_liberer(TableChaines* t) {
+    free(t->textes);
+    free(t->cases);
+    chaines_init(t);
+}
+
+static unsigned int chaines_hachage(const char* s, int longueur) {
+    unsigned int h = 2166136261u;
+    int i;
+    for (i = 0; i < longueur; i++) {
+        h ^= (unsigned char)s[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/* Double le nombre de cases et replace les chaînes connues */
+static int chaines_agrandir(TableChaines* t) {
+    int nbCases = t->nbCases ? 2 * t->nbCases : 64, i;
+    int* cases = (int*)calloc(nbCases, sizeof(int));
+    if (!cases) return 0;
+    for (i = 0; i < t->nbCases; i++) {
+        if (!t->cases[i]) continue;
+        const char* s = t->textes + t->cases[i] - 1;
+        unsigned int c = chaines_hachage(s, (int)strlen(s)) & (nbCases - 1);
+        while (cases[c]) c = (c + 1) & (nbCases - 1);
+        cases[c] = t->cases[i];
+    }
+    free(t->cases);
+    t->cases = cases;
+    t->nbCases = nbCases;
+    return 1;
+}
+
+/**
+ * Retourne la position de la chaîne (longueur donnée, sans '\0' obligatoire), ajoutée si elle
+ * est nouvelle, ou -1 en cas d'erreur d'allocation.
+ */
+int chaines_interner(TableChaines* t, const char* s, int longueur) {
+    if (2 * (t->nbChaines + 1) > t->nbCases && !chaines_agrandir(t))
+        return -1;
+    unsigned int c = chaines_hachage(s, longueur) & (t->nbCases - 1);
+    while (t->cases[c]) {
+        const char* connue = t->textes + t->cases[c] - 1;
+        if (strncmp(connue, s, longueur) == 0 && connue[longueur] == '\0')
+            return t->cases[c] - 1;
+        c = (c + 1) & (t->nbCases - 1);
+    }
+    if (t->taille + longueur + 1 > t->capacite) {
+        int capacite = t->capacite ? t->capacite : 1024;
+        while (capacite < t->taille + longueur + 1) capacite *= 2;
+        char* textes = (char*)realloc(t->textes, capacite);
+        if (!textes) return -1;
+        t->textes = textes;
+        t->capacite = capacite;
+    }
+    int position = t->taille;
+    memcpy(t->textes + position, s, longueur);
+    t->textes[position + longueur] = '\0';
+    t->taille += longueur + 1;
+    t->cases[c] = position + 1;
+    t->nbChaines++;
+    return position;
+}
+
+/* Chaîne à une position retournée par chaines_interner ("" si la position est invalide) */
+static inline const char* chaines_texte(const TableChaines* t, int position) {
+    return (position >= 0 && position < t->taille) ? t->textes + position : "";
+}
+
+#endif
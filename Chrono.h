@@ -0,0 +1,30 @@
+#ifndef CHRONO_H
+#define CHRONO_H
+
+#include <time.h>
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+/**
+ * Horloge monotone en secondes, pour mesurer les temps d'exécution.
+ */
+double chrono_secondes(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+/**
+ * Pic de mémoire résidente du processus en Ko (-1 si la mesure n'est pas disponible).
+ */
+long memoire_pic_ko(void) {
+#ifndef _WIN32
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+        return usage.ru_maxrss; // Ko sous Linux
+#endif
+    return -1;
+}
+
+#endif
@@ -3,45 +3,61 @@
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>    // Pour sleep()
+#include <sys/wait.h>
 #include <time.h>
 #include <math.h>
+#include "Chrono.h"
+#include "Feux.h"
+#include "Reseau.h"
+#include "SimulationParallele.h"
+#include "RoutageTemporel.h"
+#include "Pool.h"
+#include "Demande.h"
+#include "Trajectoires.h"
+#include "FormatCarte.h"
+#include "Instantane.h"
+#include "ImportOSM.h"
+#include "Chaines.h"
+#include "Renumerotation.h"
+#include "ReseauCompact.h"
+#include "ReseauDynamique.h"
+#include "Fermetures.h"
+#include "RoutageMultiniveau.h"
+#include "Partition.h"
+#include "Virages.h"
+#include "Alternatives.h"
+#include "Isochrones.h"
+#include "LotRequetes.h"
+#include "Scenario.h"
 
 #define INF 1000000000
+#define FACTEUR_PANNE 3.0   // Cot d'une arte en panne (pnalise) par rapport  son cot normal
+#define FACTEUR_EMBOUTEILLAGE 2.0 // Cot d'une arte embouteille dans la mtrique du routage multiniveau
+#define COUT_VIRAGE_DROITE 2.0   // Temps perdu (s)  tourner  droite
+#define COUT_VIRAGE_GAUCHE 6.0   //  gauche (traverse de la voie oppose)
+#define COUT_DEMI_TOUR 20.0      // pour un demi-tour
+#define SUPPLEMENT_GAUCHE_FEU 8.0 // Attente d'un trou dans le flot oppos pour tourner  gauche aux feux
+#define CRP_TAILLE_CELLULE 128    // Nombre de nuds vis par cellule de niveau 0
+#define CRP_BITS_NIVEAU 2         // Chaque cellule regroupe 2^CRP_BITS_NIVEAU cellules du niveau en dessous
+#define PARTITION_TOLERANCE 0.03  // cart de taille tolr entre parties (rgions, cellules)
+#define NB_ALTERNATIVES 3         // Itinraires proposs, le plus rapide compris
+#define VITESSE_SIMULATION 10.0   // Vitesse des vhicules simuls sans vhicule dsign
 
 /* ===================== Structures de Base ===================== */
 
-/* Structure pour reprsenter un nud (arrt) */
-typedef struct {
-    int ID;
-    char Nom[50];
-    char Type[50];
-    int X;
-    int Y;
-} Noeud;
+/* Les nuds (arrts) et les artes (trajets) sont rangs en colonnes dans le graphe : les
+   recherches ne parcourent que les coordonnes, l'adjacence et les distances, contigus en
+   mmoire. Les noms et les attributs rarement lus sont dans des tables  part. */
 
-/* Structure pour reprsenter une arte (trajet) */
+/* Attributs d'une arte peu utiliss par les recherches (mme indice que l'arte) */
 typedef struct {
-    int Source;
-    int Destination;
-    double Distance;
-    int Prioritaire;
     int feuxRouges;
     int capacite;
     int embouteillage ;
     int passagers;
-    int etat; // 0 = Normal, 1 = Accident, 2 = Panne
+    int etat; // 0 = Normal, 1 = Accident, 2 = Panne (voir definir_etat_arete)
     int flow;
-} Arete;
-
-/* Structure pour reprsenter un feu rouge */
-typedef struct {
-    int ID;
-    int PositionNoeud;
-    int Etat;      // 0 = Vert, 1 = Rouge
-    int DureeRouge;
-    int DureeVert;
-    int TempsRestant;
-} FeuRouge;
+} AttributsArete;
 
 /* Structure pour reprsenter un passager */
 typedef struct Passager {
@@ -50,6 +66,13 @@ typedef struct Passager {
     struct Passager* suivant;
 } Passager;
 
+/* Passagers  bord allant au mme arrt (case d'une table  adressage ouvert) */
+typedef struct {
+    int destination;   // Arrt de destination, -1 si la case est vide
+    int nombre;        // Nombre de passagers de la case
+    Passager* tete;    // Passagers de la case, chans par 'suivant'
+} CompartimentPassagers;
+
 /* Structure pour reprsenter un vhicule */
 typedef struct {
     int ID;
@@ -59,36 +82,33 @@ typedef struct {
     int positionNoeud;
     int destinationNoeud;
     double vitesse;
-    Passager* passagers;
+    CompartimentPassagers* compartiments; // Passagers  bord par destination (allou au premier embarquement)
+    int nbCompartiments;                  // Taille de la table (puissance de 2, au moins 2 x capaciteMax)
 } Vehicule;
 
-/* Structure pour reprsenter un nud dans la file/pile de vhicules */
-typedef struct Node {
-    Vehicule vehicule;
-    struct Node* suivant;
-} Node;
-
-/* Structure pour reprsenter une file (queue) */
+/* File (FIFO) de vhicules : tampon circulaire d'indices dans le registre des vhicules.
+   La capacit (puissance de 2) double quand le tampon est plein et n'est jamais rendue :
+   en rgime tabli, enfiler/dfiler n'allouent plus rien. */
 typedef struct {
-    Node* tete;
-    Node* queue;
+    int* elements;
+    int capacite;
+    int debut;     // Position du premier vhicule
+    int taille;
 } File;
 
-/* Structure pour reprsenter une pile */
+/* Passager en attente  un arrt */
 typedef struct {
-    Node* sommet;
-} Pile;
-
-/* Structure pour reprsenter un nud dans la file dattente des passagers */
-typedef struct PassagerNode {
-    Passager passager;
-    struct PassagerNode* suivant;
-} PassagerNode;
+    int ID;
+    int destination;
+} PassagerAttente;
 
-/* Structure pour reprsenter une file dattente de passagers */
+/* Structure pour reprsenter une file dattente de passagers : tampon circulaire
+   (capacit puissance de 2, agrandie au besoin et conserve) */
 typedef struct {
-    PassagerNode* tete;
-    PassagerNode* queue;
+    PassagerAttente* elements;
+    int capacite;
+    int debut;
+    int taille;
 } FilePassagers;
 
 /* Structure pour reprsenter un graphe */
@@ -96,141 +116,228 @@ typedef struct {
     int nbnoeuds;
     int nbaretes;
     int nbFeux;
-    int nbVehicules;
-    Noeud* N;
-    Arete* A;
+    int capaciteNoeuds;        // Places alloues : les ajouts au-del agrandissent les colonnes
+    int capaciteAretes;
+    int capaciteFeux;
+    int nbVehicules;           // Vhicules enregistrs (le vhicule principal est le n 0)
+    int capaciteVehicules;
+    Vehicule* vehicules;       // Registre des vhicules, rfrencs par indice dans les files
+    /* Nuds */
+    int* X;                    // Coordonnes
+    int* Y;
+    int* nom;                  // Nom et type : positions dans la table des chanes
+    int* type;
+    TableChaines chaines;      // Noms et types, chacun stock une seule fois
+    /* Artes */
+    int* source;
+    int* destination;
+    double* distance;
+    unsigned char* prioritaire;
+    AttributsArete* attributs;
+    Reseau* reseau;            // Adjacence compacte (CSR) utilise par les recherches
+    int reseauAJour;           // 0 si une arte a chang depuis la construction du rseau
+    Fermetures fermetures;     // Artes fermes (accident) ou pnalises (panne), lues par toutes les recherches
+    Virages virages;           // Cot des virages et virages interdits, par nud
     FeuRouge* F;
     File* filesFeux;           // Une file par feu rouge
-    Vehicule principal;
     File fileTrafic;
-    Pile historiqueDeplacements;
+    Trajectoires trajets;        // Dplacements des vhicules, en mmoire borne
     FilePassagers* filesAttente; // Une file d'attente de passagers par arrt
+    PoolObjets poolPassagers;    // Passagers embarqus (Passager)
+    double horloge;              // Temps simul (s)
+    RoueTemporelle roueFeux;     // Changements de phase  venir des feux
+    IndexFeux indexFeux;         // Feux de chaque nud
+    int indexFeuxAJour;          // 0 si un feu a t ajout depuis la construction de l'index
+    int* occupationNoeud;        // Nombre de vhicules en attente  chaque nud
 } Graphe;
 
 
-/* ===================== Fonctions de gestion de file et pile ===================== */
+/* ===================== Fonctions de gestion des files ===================== */
+
+/* Nombre d'allocations faites par les files (agrandissements des tampons) */
+long allocationsFiles = 0;
+
+/* Agrandit un tampon d'indices (capacit double, 8 au minimum) ; retourne 0 en cas d'chec */
+static int agrandir_tampon(int** elements, int* capacite) {
+    int nouvelle = *capacite ? 2 * *capacite : 8;
+    int* t = (int*)realloc(*elements, sizeof(int) * nouvelle);
+    if (!t) return 0;
+    allocationsFiles++;
+    *elements = t;
+    *capacite = nouvelle;
+    return 1;
+}
 
-void enfiler(File* file, Vehicule vehicule) {
-    // Allocation de mmoire pour un nouveau nud
-    Node* newNode = (Node*)malloc(sizeof(Node));
-    if (!newNode) return; // Vrification de l'allocation
-    // Initialisation du nouveau nud avec le vhicule et un pointeur suivant NULL
-    newNode->vehicule = vehicule;
-    newNode->suivant = NULL;
-    // Si la file n'est pas vide, ajouter le nouveau nud  la fin
-    if (file->queue)
-        file->queue->suivant = newNode;
-    // Mettre  jour la queue de la file
-    file->queue = newNode;
-    // Si la file tait vide, mettre  jour la tte
-    if (!file->tete)
-        file->tete = newNode;
+void enfiler(File* file, int vehicule) {
+    // Tampon plein : on double sa capacit
+    if (file->taille == file->capacite) {
+        int ancienne = file->capacite;
+        if (!agrandir_tampon(&file->elements, &file->capacite)) return; // Vrification de l'allocation
+        // Les lments qui rebouclaient au dbut du tampon sont recopis aprs l'ancienne fin
+        int i;
+        for (i = 0; i < file->debut; i++)
+            file->elements[ancienne + i] = file->elements[i];
+    }
+    // Ajout  la fin de la file (le masque remplace le modulo, la capacit tant une puissance de 2)
+    file->elements[(file->debut + file->taille) & (file->capacite - 1)] = vehicule;
+    file->taille++;
 }
 
-Vehicule defiler(File* file) {
+int defiler(File* file) {
     // Vrifier si la file est vide
-    if (!file->tete) {
-        Vehicule v = {-1, "", 0, 0, 0, 0, 0.0, NULL}; // Valeur par dfaut
-        return v;
-    }
-     // Sauvegarder l'lment  retirer
-    Node* temp = file->tete;
-    Vehicule v = temp->vehicule;
-    // Mettre  jour la tte de la file
-    file->tete = temp->suivant;
-    // Si la file devient vide, mettre  jour la queue
-    if (!file->tete)
-        file->queue = NULL; 
-    // Librer la mmoire de l'ancien premier lment
-    free(temp);
+    if (file->taille == 0)
+        return -1; // Valeur par dfaut
+    // Retrait du premier lment
+    int v = file->elements[file->debut];
+    file->debut = (file->debut + 1) & (file->capacite - 1);
+    file->taille--;
     return v;
 }
 
-void empiler(Pile* pile, Vehicule vehicule) {
-    // Allocation de mmoire pour un nouveau nud
-    Node* newNode = (Node*)malloc(sizeof(Node));
-    if (!newNode) return; // Vrification de l'allocation
-    // Initialisation du nouveau nud avec le vhicule et l'ancien sommet
-    newNode->vehicule = vehicule;
-    newNode->suivant = pile->sommet;
-    // Mise  jour du sommet de la pile
-    pile->sommet = newNode;
-}
-
-Vehicule depiler(Pile* pile) {
-    // Vrifier si la pile est vide
-    if (!pile->sommet) {
-        Vehicule v = {-1, "", 0, 0, 0, 0, 0.0, NULL}; // Valeur par dfaut
-        return v;
-    }
-    // Sauvegarder l'lment  retirer
-    Node* temp = pile->sommet;
-    Vehicule v = temp->vehicule;
-    // Mettre  jour le sommet de la pile
-    pile->sommet = temp->suivant;
-    // Librer la mmoire de l'ancien sommet
-    free(temp);
-    return v;
+/* Libre le tampon d'une file */
+void liberer_file(File* file) {
+    free(file->elements);
+    file->elements = NULL;
+    file->capacite = file->debut = file->taille = 0;
+}
+
+/* Agrandit un tableau de 'ancienne'  'nouvelle' lments, la partie ajoute remplie de 'octet' */
+static int agrandir_colonne(void** tableau, int ancienne, int nouvelle, size_t taille, int octet) {
+    void* t = realloc(*tableau, taille * nouvelle);
+    if (!t) return 0;
+    memset((char*)t + taille * ancienne, octet, taille * (nouvelle - ancienne));
+    *tableau = t;
+    return 1;
 }
+
+/**
+ * Garantit la place de nbNoeuds nuds, nbAretes artes et nbFeux feux. Les capacits doublent :
+ * ajouter des lments un par un cote O(1) amorti. Les nouvelles artes sont invalides (source
+ * -1) et les nouveaux feux sans cycle tant qu'ils ne sont pas dfinis. Retourne 0 si la mmoire manque.
+ */
+int graphe_reserver(Graphe* graph, int nbNoeuds, int nbAretes, int nbFeux) {
+    if (nbNoeuds > graph->capaciteNoeuds) {
+        int c = graph->capaciteNoeuds, n = c * 2 > nbNoeuds ? c * 2 : nbNoeuds;
+        if (!agrandir_colonne((void**)&graph->X, c, n, sizeof(int), 0) ||
+            !agrandir_colonne((void**)&graph->Y, c, n, sizeof(int), 0) ||
+            !agrandir_colonne((void**)&graph->nom, c, n, sizeof(int), 0xFF) ||
+            !agrandir_colonne((void**)&graph->type, c, n, sizeof(int), 0xFF) ||
+            !agrandir_colonne((void**)&graph->filesAttente, c, n, sizeof(FilePassagers), 0) ||
+            !agrandir_colonne((void**)&graph->occupationNoeud, c, n, sizeof(int), 0))
+            return 0;
+        graph->capaciteNoeuds = n;
+    }
+    if (nbAretes > graph->capaciteAretes) {
+        int c = graph->capaciteAretes, m = c * 2 > nbAretes ? c * 2 : nbAretes;
+        if (!agrandir_colonne((void**)&graph->source, c, m, sizeof(int), 0xFF) ||
+            !agrandir_colonne((void**)&graph->destination, c, m, sizeof(int), 0xFF) ||
+            !agrandir_colonne((void**)&graph->distance, c, m, sizeof(double), 0) ||
+            !agrandir_colonne((void**)&graph->prioritaire, c, m, 1, 0) ||
+            !agrandir_colonne((void**)&graph->attributs, c, m, sizeof(AttributsArete), 0) ||
+            !fermetures_agrandir(&graph->fermetures, m))
+            return 0;
+        graph->capaciteAretes = m;
+    }
+    if (nbFeux > graph->capaciteFeux) {
+        int c = graph->capaciteFeux, f = c * 2 > nbFeux ? c * 2 : nbFeux;
+        if (!agrandir_colonne((void**)&graph->F, c, f, sizeof(FeuRouge), 0) ||
+            !agrandir_colonne((void**)&graph->filesFeux, c, f, sizeof(File), 0))
+            return 0;
+        graph->capaciteFeux = f;
+    }
+    return 1;
+}
+
 /* ===================== Fonctions d'ajout ===================== */
 /* Ajouter un noeud */
 void ajouternoeud(Graphe* graph, int id, char* name, char* type, int x, int y) {
-    // Vrification si l'ID du nud est valide
-    if (id >= graph->nbnoeuds) {
+    // Vrification si l'ID du nud est valide (au-del du nombre de nuds, le graphe grandit)
+    if (id < 0 || !graphe_reserver(graph, id + 1, 0, 0)) {
         printf("ID du noeud hors limite\n");
         return;
     }
-    // Rcupration du nud et initialisation de ses attributs
-    Noeud* noeud = &graph->N[id];
-    noeud->ID = id;
-    strcpy(noeud->Nom, name);
-    strcpy(noeud->Type, type);
-    noeud->X = x;
-    noeud->Y = y;
+    if (id >= graph->nbnoeuds) {
+        graph->nbnoeuds = id + 1;
+        graph->reseauAJour = graph->indexFeuxAJour = 0;
+    }
+    // Coordonnes, nom et type (interns) du nud
+    graph->X[id] = x;
+    graph->Y[id] = y;
+    graph->nom[id] = chaines_interner(&graph->chaines, name, (int)strlen(name));
+    graph->type[id] = chaines_interner(&graph->chaines, type, (int)strlen(type));
+}
+
+/* Nom et type d'un nud ("" si le nud n'est pas dfini) */
+const char* noeud_nom(const Graphe* graph, int id) {
+    return chaines_texte(&graph->chaines, graph->nom[id]);
+}
+
+const char* noeud_type(const Graphe* graph, int id) {
+    return chaines_texte(&graph->chaines, graph->type[id]);
 }
 
 /* Ajouter une arte (sans capacit, on pourra par la suite la dfinir) */
 void ajouterarete(Graphe* graph, int indice, int source, int destination, double distance, int prioritaire) {
-    // Vrification si l'indice de l'arte est valide
-    if (indice >= graph->nbaretes) {
+    // Vrification si l'indice de l'arte est valide (au-del du nombre d'artes, le graphe grandit)
+    if (indice < 0 || !graphe_reserver(graph, 0, indice + 1, 0)) {
         printf("ID d'arete hors limite\n");
         return;
     }
+    if (indice >= graph->nbaretes) graph->nbaretes = indice + 1;
     // Initialisation de l'arte avec les valeurs fournies
-    Arete* arete = &graph->A[indice];
-    arete->Source = source;
-    arete->Destination = destination;
-    arete->Distance = distance;
-    arete->Prioritaire = prioritaire;
+    graph->source[indice] = source;
+    graph->destination[indice] = destination;
+    graph->distance[indice] = distance;
+    graph->prioritaire[indice] = prioritaire != 0;
+    AttributsArete* arete = &graph->attributs[indice];
     arete->capacite = 0; // Capacit initialise  0
     arete->flow = 0; // Flux initialis  0
     arete->etat = 0; // tat initialis  0
+    graph->reseauAJour = 0;
 }
 
 /* Ajouter une arte avec capacit (pour la gestion des flux) */
 void ajouter_arete_flux(Graphe* graph, int indice, int source, int destination, double distance, int prioritaire, int capacity) {
-    // Vrification si l'indice de l'arte est valide
-    if (indice >= graph->nbaretes) {
+    // Vrification si l'indice de l'arte est valide (au-del du nombre d'artes, le graphe grandit)
+    if (indice < 0 || !graphe_reserver(graph, 0, indice + 1, 0)) {
         printf("ID d'arete hors limite\n");
         return;
     }
+    if (indice >= graph->nbaretes) graph->nbaretes = indice + 1;
     // Initialisation de l'arte avec les valeurs fournies
-    Arete* arete = &graph->A[indice];
-    arete->Source = source;
-    arete->Destination = destination;
-    arete->Distance = distance;
-    arete->Prioritaire = prioritaire;
+    graph->source[indice] = source;
+    graph->destination[indice] = destination;
+    graph->distance[indice] = distance;
+    graph->prioritaire[indice] = prioritaire != 0;
+    AttributsArete* arete = &graph->attributs[indice];
     arete->capacite = capacity; // Dfinition de la capacit
     arete->flow = 0; // Flux initialis  0
+    graph->reseauAJour = 0;
+}
+
+/**
+ * Change l'tat d'une arte (0 = Normal, 1 = Accident, 2 = Panne). Un accident ferme l'arte,
+ * une panne multiplie son cot par FACTEUR_PANNE. Cot O(1) : le rseau compact n'est pas
+ * reconstruit, les recherches lisent directement les fermetures.
+ */
+void definir_etat_arete(Graphe* graph, int indice, int etat) {
+    if (indice < 0 || indice >= graph->nbaretes) {
+        printf("ID d'arete hors limite\n");
+        return;
+    }
+    graph->attributs[indice].etat = etat;
+    fermer_arete(&graph->fermetures, indice, etat == 1);
+    penaliser_arete(&graph->fermetures, indice, etat == 2);
 }
 
 /*fonction pour ajouter les feux rouges*/
 void ajouterFeuRouge(Graphe* graph, int id, int position, int etat, int dureeRouge, int dureeVert) {
-    // Vrification si l'ID du feu rouge est valide
-    if (id >= graph->nbFeux) {
+    // Vrification si l'ID du feu rouge est valide (au-del du nombre de feux, le graphe grandit)
+    if (id < 0 || !graphe_reserver(graph, 0, 0, id + 1)) {
         printf("ID de feu rouge hors limite\n");
         return;
     }
+    if (id >= graph->nbFeux) graph->nbFeux = id + 1;
     // Initialisation du feu rouge avec les valeurs fournies
     FeuRouge* feu = &graph->F[id];
     feu->ID = id;
@@ -238,50 +345,90 @@ void ajouterFeuRouge(Graphe* graph, int id, int position, int etat, int dureeRou
     feu->Etat = etat;
     feu->DureeRouge = dureeRouge;
     feu->DureeVert = dureeVert;
-    feu->TempsRestant = dureeRouge; // Temps restant initialis  la dure rouge
+    feu->Decalage = etat ? 0 : dureeVert; // Un feu cr vert commence par sa phase verte
+    // tat et temps restant calculs  l'heure courante, puis planification du prochain changement
+    feu_actualiser(feu, graph->horloge);
+    if (feu->DureeRouge > 0)
+        roue_planifier(&graph->roueFeux, graph->horloge + feu_temps_restant(feu, graph->horloge), id);
+    graph->indexFeuxAJour = 0; // L'index nud -> feux sera reconstruit au prochain accs
+}
+
+/* Retourne l'index nud -> feux, reconstruit seulement si des feux ont t ajouts ; NULL si la
+   construction a chou (mmoire puise) */
+IndexFeux* index_feux(Graphe* graph) {
+    if (!graph->indexFeuxAJour) {
+        index_feux_liberer(&graph->indexFeux);
+        graph->indexFeuxAJour = index_feux_construire(&graph->indexFeux, graph->F, graph->nbFeux, graph->nbnoeuds);
+    }
+    return graph->indexFeuxAJour ? &graph->indexFeux : NULL;
+}
+
+/* Tables de virages ranges par nud (aprs l'ajout d'exceptions ou de nuds) */
+Virages* virages_graphe(Graphe* graph) {
+    if (virages_a_indexer(&graph->virages, graph->nbnoeuds))
+        virages_indexer(&graph->virages, graph->nbnoeuds);
+    return &graph->virages;
+}
+
+/* Fait avancer le temps simul : les feux qui changent de phase sont mis  jour par la roue temporelle */
+void avancer_horloge(Graphe* graph, double duree) {
+    graph->horloge += duree;
+    feux_avancer(&graph->roueFeux, graph->F, graph->horloge);
 }
 /* ========================================================================= */
 /*                Fonctions de Gestion des Vehicules                     */
 /* ========================================================================= */
 
+/* Enregistre un vhicule et retourne son indice (-1 en cas d'chec).
+   Les pointeurs vers le registre restent valides jusqu'au prochain enregistrement. */
+int enregistrer_vehicule(Graphe* graph, Vehicule v) {
+    if (graph->nbVehicules == graph->capaciteVehicules) {
+        int capacite = graph->capaciteVehicules ? 2 * graph->capaciteVehicules : 8;
+        Vehicule* t = (Vehicule*)realloc(graph->vehicules, sizeof(Vehicule) * capacite);
+        if (!t) return -1;
+        graph->vehicules = t;
+        graph->capaciteVehicules = capacite;
+    }
+    graph->vehicules[graph->nbVehicules] = v;
+    return graph->nbVehicules++;
+}
+
+/* Vhicule principal (toujours le premier du registre) */
+Vehicule* vehicule_principal(Graphe* graph) {
+    return &graph->vehicules[0];
+}
+
 /* Ajoute le vhicule en attente dans la file gnrale */
-void ajouterVehiculeEnAttente(Graphe* graph, Vehicule v) {
+void ajouterVehiculeEnAttente(Graphe* graph, int vehicule) {
+    Vehicule* v = &graph->vehicules[vehicule];
     // Affichage du vhicule ajout  la file d'attente
-    printf("%s ID %d en attente a l'arret %d\n", v.type, v.ID, v.positionNoeud);
+    printf("%s ID %d en attente a l'arret %d\n", v->type, v->ID, v->positionNoeud);
     // Ajout du vhicule  la file de trafic
-    enfiler(&graph->fileTrafic, v);
+    enfiler(&graph->fileTrafic, vehicule);
 }
 
 /* Gre le passage des vhicules en attente */
 void gererVehiculesEnAttente(Graphe* graph) {
     // Vrifie s'il y a des vhicules en attente
-    if (graph->fileTrafic.tete) {
-        Vehicule v = defiler(&graph->fileTrafic);
-        printf("%s ID %d avance depuis l'arret %d\n", v.type, v.ID, v.positionNoeud);
-        // Ajoute le vhicule dans l'historique des dplacements
-        empiler(&graph->historiqueDeplacements, v);
+    if (graph->fileTrafic.taille > 0) {
+        int indice = defiler(&graph->fileTrafic);
+        Vehicule* v = &graph->vehicules[indice];
+        printf("%s ID %d avance depuis l'arret %d\n", v->type, v->ID, v->positionNoeud);
+        // Enregistre le dpart dans les trajectoires
+        trajectoires_enregistrer(&graph->trajets, v->ID, graph->horloge, v->positionNoeud, -1);
     }
 }
 
 /* Ajoute un vhicule dans la file d'un feu rouge */
-void ajouterVehiculeFileFeu(Graphe* graph, int feuID, Vehicule v) {
+void ajouterVehiculeFileFeu(Graphe* graph, int feuID, int vehicule) {
     // Vrifie si l'ID du feu est valide
     if (feuID >= graph->nbFeux) return;
-    // Rcupre la file du feu rouge correspondant
-    File* file = &graph->filesFeux[feuID];
-    // Cration d'un nouveau nud pour stocker le vhicule
-    Node* newNode = (Node*)malloc(sizeof(Node));
-    if (!newNode) return;
-    newNode->vehicule = v;
-    newNode->suivant = NULL;
-    // Ajoute le nud  la fin de la file
-    if (file->queue)
-        file->queue->suivant = newNode;
-    file->queue = newNode;
-    // Si la file tait vide, mettre  jour la tte
-    if (!file->tete)
-        file->tete = newNode;
-    printf("%s ID %d ajoute dans la file du feu rouge %d\n", v.type, v.ID, feuID);
+    // Ajoute l'indice du vhicule  la fin de la file du feu
+    enfiler(&graph->filesFeux[feuID], vehicule);
+    // Un vhicule de plus en attente au nud du feu
+    graph->occupationNoeud[graph->F[feuID].PositionNoeud]++;
+    Vehicule* v = &graph->vehicules[vehicule];
+    printf("%s ID %d ajoute dans la file du feu rouge %d\n", v->type, v->ID, feuID);
 }
 
 /* Libre les vhicules dans la file d'un feu rouge */
@@ -291,113 +438,218 @@ void libererVehiculesFeu(Graphe* graph, int feuID) {
     // Rcupre la file du feu rouge correspondant
     File* file = &graph->filesFeux[feuID];
     // Libre tous les vhicules en attente au feu rouge
-    while (file->tete) {
-        Node* temp = file->tete;
-        Vehicule v = temp->vehicule;
-        printf("%s ID %d avance depuis le feu rouge %d\n", v.type, v.ID, feuID);
+    while (file->taille > 0) {
+        Vehicule* v = &graph->vehicules[defiler(file)];
+        printf("%s ID %d avance depuis le feu rouge %d\n", v->type, v->ID, feuID);
         sleep(1); // Simulation du temps d'attente
-        // Mise  jour de la tte de la file
-        file->tete = temp->suivant;
-        // Si la file devient vide, mettre  jour la queue
-        if (!file->tete)
-            file->queue = NULL;
-        // Libration de la mmoire du nud
-        free(temp);
+        graph->occupationNoeud[graph->F[feuID].PositionNoeud]--;
     }
 }
 
-/* Retourne le nombre de vhicules  un arrt */
+/* Retourne le nombre de vhicules  un arrt (compteur tenu  jour par les files des feux) */
 int nombreVehiculesArret(Graphe* graph, int arretID) {
-    int count = 0;
+    int count = graph->occupationNoeud[arretID];
     // Vrifie si le vhicule principal est  l'arrt donn
-    if (graph->principal.positionNoeud == arretID)
+    if (vehicule_principal(graph)->positionNoeud == arretID)
         count++;
-    // Parcours des feux pour compter les vhicules en attente
-    int i;
-    for (i = 0; i < graph->nbFeux; i++) {
-        if (graph->F[i].PositionNoeud == arretID) {
-            Node* current = graph->filesFeux[i].tete;
-            while (current) {
-                count++;
-                current = current->suivant;
-            }
-        }
-    }
     return count;
 }
 /* ========================================================================= */
 /*                Fonctions de Gestion des Passagers                    */
 /* ========================================================================= */
 
+/* Affichage de chaque embarquement et dbarquement (dsactiv par les bancs d'essai) */
+int journalPassagers = 1;
+
+/* Ajoute un passager  la fin de la file d'attente d'un arrt */
+int ajouterPassagerArret(Graphe* graph, int arret, int id, int destination) {
+    if (arret < 0 || arret >= graph->nbnoeuds) return 0;
+    FilePassagers* file = &graph->filesAttente[arret];
+    // Tampon plein : capacit double, la partie qui rebouclait au dbut est recopie  la suite
+    if (file->taille == file->capacite) {
+        int ancienne = file->capacite, i;
+        int capacite = ancienne ? 2 * ancienne : 16;
+        PassagerAttente* t = (PassagerAttente*)realloc(file->elements, sizeof(PassagerAttente) * capacite);
+        if (!t) return 0;
+        allocationsFiles++;
+        for (i = 0; i < file->debut; i++)
+            t[ancienne + i] = t[i];
+        file->elements = t;
+        file->capacite = capacite;
+    }
+    PassagerAttente* p = &file->elements[(file->debut + file->taille) & (file->capacite - 1)];
+    p->ID = id;
+    p->destination = destination;
+    file->taille++;
+    return 1;
+}
+
+/* Case de la table du vhicule pour une destination : la case de la destination si des passagers
+   y vont, sinon la case vide o l'ajouter (la table n'est jamais pleine) */
+static int compartiment_destination(const Vehicule* vehicule, int destination) {
+    int masque = vehicule->nbCompartiments - 1;
+    int i = (int)(((unsigned int)destination * 2654435761u) & masque);
+    while (vehicule->compartiments[i].destination != -1 && vehicule->compartiments[i].destination != destination)
+        i = (i + 1) & masque;
+    return i;
+}
+
+/* (R)alloue la table des passagers  bord, dimensionne pour que chaque passager puisse avoir sa
+   propre destination ; les compartiments existants sont replacs si la capacit a augment */
+static int preparer_compartiments(Vehicule* vehicule) {
+    int taille = 8, i;
+    while (taille < 2 * vehicule->capaciteMax) taille *= 2;
+    CompartimentPassagers* ancienne = vehicule->compartiments;
+    int ancienneTaille = vehicule->nbCompartiments;
+    vehicule->compartiments = (CompartimentPassagers*)malloc(sizeof(CompartimentPassagers) * taille);
+    if (!vehicule->compartiments) {
+        vehicule->compartiments = ancienne;
+        return 0;
+    }
+    vehicule->nbCompartiments = taille;
+    for (i = 0; i < taille; i++) {
+        vehicule->compartiments[i].destination = -1;
+        vehicule->compartiments[i].nombre = 0;
+        vehicule->compartiments[i].tete = NULL;
+    }
+    for (i = 0; i < ancienneTaille; i++)
+        if (ancienne[i].destination != -1)
+            vehicule->compartiments[compartiment_destination(vehicule, ancienne[i].destination)] = ancienne[i];
+    free(ancienne);
+    return 1;
+}
+
+/* Nombre de passagers  bord qui descendent  l'arrt donn, en O(1) */
+int passagers_vers(const Vehicule* vehicule, int destination) {
+    if (!vehicule->compartiments) return 0;
+    return vehicule->compartiments[compartiment_destination(vehicule, destination)].nombre;
+}
+
 /* Embarque les passagers depuis la file d'attente de l'arrt dans le vhicule */
 void embarquer_passagers(Graphe* graph, Vehicule* vehicule) {
     // Rcupration de la file d'attente des passagers  la position actuelle du vhicule
     FilePassagers* file = &graph->filesAttente[vehicule->positionNoeud];
+    if (file->taille == 0 || vehicule->Npassager >= vehicule->capaciteMax)
+        return;
+    if (vehicule->nbCompartiments < 2 * vehicule->capaciteMax && !preparer_compartiments(vehicule))
+        return;
     // Tant que le vhicule n'est pas plein et qu'il reste des passagers en attente
-    while (vehicule->Npassager < vehicule->capaciteMax && file->tete) {
-        // Rcupration du premier passager dans la file d'attente
-        PassagerNode* pnode = file->tete;
-        file->tete = file->tete->suivant; // Avancement de la file d'attente
-        // Si la file devient vide, mettre  jour le pointeur de la queue
-        if (!file->tete)
-            file->queue = NULL;
-        // Allocation d'un nouvel espace mmoire pour le passager embarqu
-        Passager* newPassager = (Passager*)malloc(sizeof(Passager));
-        *newPassager = pnode->passager; // Copie des donnes du passager
-        // Ajout du passager en tte de la liste des passagers du vhicule
-        newPassager->suivant = vehicule->passagers;
-        vehicule->passagers = newPassager;
+    while (vehicule->Npassager < vehicule->capaciteMax && file->taille > 0) {
+        // Passager embarqu pris dans le pool
+        Passager* newPassager = (Passager*)pool_allouer(&graph->poolPassagers);
+        if (!newPassager) break;
+        // Retrait du premier passager de la file d'attente
+        PassagerAttente* premier = &file->elements[file->debut];
+        newPassager->ID = premier->ID;
+        newPassager->destination = premier->destination;
+        file->debut = (file->debut + 1) & (file->capacite - 1);
+        file->taille--;
+        // Rangement avec les passagers qui descendent au mme arrt
+        CompartimentPassagers* c = &vehicule->compartiments[compartiment_destination(vehicule, newPassager->destination)];
+        c->destination = newPassager->destination;
+        newPassager->suivant = c->tete;
+        c->tete = newPassager;
+        c->nombre++;
         vehicule->Npassager++; // Incrmentation du nombre de passagers
         // Affichage de l'embarquement du passager
-        printf("Passager ID %d embarqu, destination: %d\n", newPassager->ID, newPassager->destination);
-        // Libration de l'ancienne structure du passager dans la file
-        free(pnode);
+        if (journalPassagers)
+            printf("Passager ID %d embarqu, destination: %d\n", newPassager->ID, newPassager->destination);
     }
 }
 
-/* Dbarque les passagers arrivs  destination */
-void debarquer_passagers(Vehicule* vehicule) {
-    Passager* prev = NULL;
-    Passager* current = vehicule->passagers;
-    // Parcours de la liste des passagers
+/* Dbarque les passagers arrivs  destination : seul le compartiment de l'arrt courant est parcouru */
+void debarquer_passagers(Graphe* graph, Vehicule* vehicule) {
+    if (!vehicule->compartiments || vehicule->Npassager == 0)
+        return;
+    int masque = vehicule->nbCompartiments - 1;
+    int i = compartiment_destination(vehicule, vehicule->positionNoeud);
+    CompartimentPassagers* c = &vehicule->compartiments[i];
+    if (c->destination == -1)
+        return; // Personne ne descend ici
+    Passager* current = c->tete;
     while (current) {
-        // Vrification si le passager est arriv  destination
-        if (current->destination == vehicule->positionNoeud) {
+        Passager* suivant = current->suivant;
+        if (journalPassagers)
             printf("Passager ID %d a dbarqu\n", current->ID);
-            // Suppression du passager de la liste
-            if (prev)
-                prev->suivant = current->suivant;
-            else
-                vehicule->passagers = current->suivant;
-            // Libration de la mmoire alloue au passager
-            Passager* temp = current;
-            current = (prev) ? prev->suivant : vehicule->passagers;
-            free(temp);
-            vehicule->Npassager--; // Dcrmentation du nombre de passagers
-        } else {
-            prev = current;
-            current = current->suivant;
+        // Le passager retourne au pool
+        pool_rendre(&graph->poolPassagers, current);
+        current = suivant;
+    }
+    vehicule->Npassager -= c->nombre; // Dcrmentation du nombre de passagers
+    // Suppression de la case : les cases suivantes de la mme srie sont remontes pour
+    // que les recherches ne s'arrtent pas sur le trou
+    int j = i;
+    for (;;) {
+        j = (j + 1) & masque;
+        if (vehicule->compartiments[j].destination == -1)
+            break;
+        int k = (int)(((unsigned int)vehicule->compartiments[j].destination * 2654435761u) & masque);
+        // La case j peut combler le trou i si sa position idale k n'est pas dans ]i, j]
+        if ((j > i && (k <= i || k > j)) || (j < i && (k <= i && k > j))) {
+            vehicule->compartiments[i] = vehicule->compartiments[j];
+            i = j;
         }
     }
+    vehicule->compartiments[i].destination = -1;
+    vehicule->compartiments[i].nombre = 0;
+    vehicule->compartiments[i].tete = NULL;
+}
+
+/* Fin de scnario : vide d'un coup les files d'attente et les vhicules, les blocs des pools sont conservs */
+void reinitialiserPassagers(Graphe* graph) {
+    int i;
+    for (i = 0; i < graph->nbnoeuds; i++)
+        graph->filesAttente[i].debut = graph->filesAttente[i].taille = 0;
+    for (i = 0; i < graph->nbVehicules; i++) {
+        Vehicule* v = &graph->vehicules[i];
+        int j;
+        for (j = 0; j < v->nbCompartiments; j++) {
+            v->compartiments[j].destination = -1;
+            v->compartiments[j].nombre = 0;
+            v->compartiments[j].tete = NULL;
+        }
+        v->Npassager = 0;
+    }
+    pool_reinitialiser(&graph->poolPassagers);
 }
 
 /* Simule l'attente d'un vhicule au feu rouge */
 void attendre_feu_rouge(Graphe* graph, int feuID) {
     if (feuID >= 0) {
-        // Affichage d'un message d'attente
-        printf("Feu rouge dtect  l'arrt %d ! Attente de %d secondes...\n",
-        graph->F[feuID].PositionNoeud, graph->F[feuID].DureeRouge);
-        // Pause du programme pendant la dure du feu rouge
-        sleep(graph->F[feuID].DureeRouge);
-        // Passage au feu vert
-        graph->F[feuID].Etat = 0; // 0 reprsente le vert
-        graph->F[feuID].TempsRestant = graph->F[feuID].DureeVert;
+        // L'attente restante est dduite du cycle du feu  l'heure courante
+        double attente = feu_attente(&graph->F[feuID], graph->horloge);
+        printf("Feu rouge dtect  l'arrt %d ! Attente de %.0f secondes...\n",
+        graph->F[feuID].PositionNoeud, ceil(attente));
+        // Pause du programme jusqu'au passage au vert
+        sleep((unsigned int)ceil(attente));
+        avancer_horloge(graph, attente);
         printf("Feu vert ! Le vhicule peut continuer.\n");
+        // Les vhicules en attente au feu repartent
+        libererVehiculesFeu(graph, feuID);
     }
 }
 
 /* ===================== Cration et initialisation du graphe ===================== */
 
+/* Libre les colonnes des nuds et des artes, la table des chanes et le rseau compact */
+static void liberer_colonnes(Graphe* graph) {
+    free(graph->X);
+    free(graph->Y);
+    free(graph->nom);
+    free(graph->type);
+    chaines_liberer(&graph->chaines);
+    free(graph->source);
+    free(graph->destination);
+    free(graph->distance);
+    free(graph->prioritaire);
+    free(graph->attributs);
+    fermetures_liberer(&graph->fermetures);
+    virages_liberer(&graph->virages);
+    reseau_liberer(graph->reseau);
+    graph->reseau = NULL;
+    graph->reseauAJour = 0;
+}
+
 /* Cre un graphe avec le nombre spcifi de nuds, d'artes et de feux de signalisation */
 Graphe* creergraphe(int Nbnoeuds, int Nbaretes, int NbFeux) {
     // Allocation de mmoire pour la structure Graphe
@@ -410,96 +662,217 @@ Graphe* creergraphe(int Nbnoeuds, int Nbaretes, int NbFeux) {
     graph->nbnoeuds = Nbnoeuds;
     graph->nbaretes = Nbaretes;
     graph->nbFeux = NbFeux;
-    graph->nbVehicules = 0;
-    graph->fileTrafic.tete = graph->fileTrafic.queue = NULL;
-    graph->historiqueDeplacements.sommet = NULL;
-    // Allocation de mmoire pour les nuds, artes et feux
-    graph->N = (Noeud*)malloc(sizeof(Noeud) * Nbnoeuds);
-    graph->A = (Arete*)malloc(sizeof(Arete) * Nbaretes);
-    graph->F = (FeuRouge*)malloc(sizeof(FeuRouge) * NbFeux);
-    graph->filesFeux = (File*)malloc(sizeof(File) * NbFeux);
+    graph->capaciteNoeuds = Nbnoeuds > 0 ? Nbnoeuds : 1;
+    graph->capaciteAretes = Nbaretes > 0 ? Nbaretes : 1;
+    graph->capaciteFeux = NbFeux > 0 ? NbFeux : 1;
+    graph->nbVehicules = graph->capaciteVehicules = 0;
+    graph->vehicules = NULL;
+    graph->fileTrafic = (File){ NULL, 0, 0, 0 };
+    trajectoires_init(&graph->trajets, 8u << 20, 0.0, NULL); // 8 Mo, sans fichier de dbordement
+    // Allocation de mmoire pour les colonnes des nuds et des artes, et pour les feux
+    int n = Nbnoeuds > 0 ? Nbnoeuds : 1, m = Nbaretes > 0 ? Nbaretes : 1;
+    chaines_init(&graph->chaines);
+    graph->X = (int*)malloc(sizeof(int) * n);
+    graph->Y = (int*)malloc(sizeof(int) * n);
+    graph->nom = (int*)malloc(sizeof(int) * n);
+    graph->type = (int*)malloc(sizeof(int) * n);
+    graph->source = (int*)malloc(sizeof(int) * m);
+    graph->destination = (int*)malloc(sizeof(int) * m);
+    graph->distance = (double*)malloc(sizeof(double) * m);
+    graph->prioritaire = (unsigned char*)calloc(m, 1);
+    graph->attributs = (AttributsArete*)calloc(m, sizeof(AttributsArete));
+    int fermeturesOk = fermetures_init(&graph->fermetures, m, FACTEUR_PANNE);
+    virages_init(&graph->virages, COUT_VIRAGE_DROITE, COUT_VIRAGE_GAUCHE, COUT_DEMI_TOUR, SUPPLEMENT_GAUCHE_FEU);
+    graph->reseau = NULL;
+    graph->reseauAJour = 0;
+    graph->F = (FeuRouge*)calloc(NbFeux > 0 ? NbFeux : 1, sizeof(FeuRouge)); // Feux non dfinis : toujours verts
+    graph->filesFeux = (File*)calloc(NbFeux > 0 ? NbFeux : 1, sizeof(File)); // Files vides, sans tampon
     // Vrification de l'allocation mmoire
-    if (!graph->N || !graph->A || !graph->F || !graph->filesFeux) {
+    if (!graph->X || !graph->Y || !graph->nom || !graph->type || !graph->source || !graph->destination ||
+        !graph->distance || !graph->prioritaire || !graph->attributs || !fermeturesOk || !graph->F || !graph->filesFeux) {
         printf("Erreur d'allocation mmoire !\n");
-        if (graph->N) free(graph->N);
-        if (graph->A) free(graph->A);
+        liberer_colonnes(graph);
         if (graph->F) free(graph->F);
         if (graph->filesFeux) free(graph->filesFeux);
         free(graph);
         return NULL;
     }
-    // Initialisation des files associes aux feux
-    int i;
-    for (i = 0; i < NbFeux; i++) {
-        graph->filesFeux[i].tete = NULL;
-        graph->filesFeux[i].queue = NULL;
-    }
-    // Allocation de mmoire pour les files d'attente des passagers
-    graph->filesAttente = (FilePassagers*)malloc(sizeof(FilePassagers) * Nbnoeuds);
-    if (!graph->filesAttente) {
+    // Allocation de mmoire pour les files d'attente des passagers et l'occupation des nuds
+    graph->filesAttente = (FilePassagers*)calloc(Nbnoeuds > 0 ? Nbnoeuds : 1, sizeof(FilePassagers)); // Files vides, sans tampon
+    graph->occupationNoeud = (int*)calloc(Nbnoeuds > 0 ? Nbnoeuds : 1, sizeof(int));
+    if (!graph->filesAttente || !graph->occupationNoeud) {
         printf("Erreur d'allocation mmoire pour les files d'attente !\n");
-        free(graph->N);
-        free(graph->A);
+        free(graph->filesAttente);
+        free(graph->occupationNoeud);
+        liberer_colonnes(graph);
+        free(graph->F);
+        free(graph->filesFeux);
+        free(graph);
+        return NULL;
+    }
+    // Nuds non dfinis : sans nom ni type
+    memset(graph->nom, 0xFF, sizeof(int) * n);
+    memset(graph->type, 0xFF, sizeof(int) * n);
+    // Artes non dfinies : invalides, ignores par le rseau compact
+    memset(graph->source, 0xFF, sizeof(int) * m);
+    memset(graph->destination, 0xFF, sizeof(int) * m);
+    // Horloge de simulation et roue temporelle des feux
+    graph->horloge = 0.0;
+    roue_init(&graph->roueFeux, 1.0, NbFeux);
+    graph->indexFeux.debut = graph->indexFeux.feux = NULL;
+    graph->indexFeuxAJour = 0;
+    // Initialisation du vhicule principal (indice 0 du registre)
+    Vehicule principal = {0, "", 0, 0, 0, 0, 5.0, NULL, 0};
+    if (enregistrer_vehicule(graph, principal) < 0) {
+        printf("Erreur d'allocation mmoire pour les vhicules !\n");
+        free(graph->filesAttente);
+        free(graph->occupationNoeud);
+        liberer_colonnes(graph);
         free(graph->F);
         free(graph->filesFeux);
+        roue_liberer(&graph->roueFeux);
         free(graph);
         return NULL;
     }
-    // Initialisation du vhicule principal
-    Vehicule* v = &graph->principal;
-    v->vitesse = 5.0;
-    // Initialisation des files d'attente des passagers
-    for (i = 0; i < Nbnoeuds; i++) {
-        graph->filesAttente[i].tete = NULL;
-        graph->filesAttente[i].queue = NULL;
+    // Pool des passagers embarqus (blocs de 4096 objets)
+    pool_init(&graph->poolPassagers, sizeof(Passager), 4096);
+    return graph;
+}
+
+/* Libre le graphe et tout ce qu'il contient (files, vhicules, passagers, feux) */
+void libererGraphe(Graphe* graph) {
+    int i;
+    if (!graph) return;
+    for (i = 0; i < graph->nbFeux; i++)
+        liberer_file(&graph->filesFeux[i]);
+    liberer_file(&graph->fileTrafic);
+    trajectoires_liberer(&graph->trajets);
+    // Passagers embarqus (pool) et en attente (tampons des arrts)
+    for (i = 0; i < graph->nbVehicules; i++)
+        free(graph->vehicules[i].compartiments);
+    pool_liberer(&graph->poolPassagers);
+    for (i = 0; i < graph->nbnoeuds; i++)
+        free(graph->filesAttente[i].elements);
+    free(graph->vehicules);
+    free(graph->filesFeux);
+    free(graph->filesAttente);
+    free(graph->occupationNoeud);
+    roue_liberer(&graph->roueFeux);
+    index_feux_liberer(&graph->indexFeux);
+    liberer_colonnes(graph);
+    free(graph->F);
+    free(graph);
+}
+
+/* Cre le graphe dcrit par une carte charge depuis un fichier (voir FormatCarte.h) */
+Graphe* graphe_depuis_carte(const Carte* carte) {
+    int i;
+    Graphe* graph = creergraphe(carte->nbNoeuds > 0 ? carte->nbNoeuds : 1,
+                                carte->nbAretes > 0 ? carte->nbAretes : 1, carte_nb_feux(carte));
+    if (!graph) return NULL;
+    graph->nbnoeuds = carte->nbNoeuds;
+    graph->nbaretes = carte->nbAretes;
+    for (i = 0; i < carte->nbNoeuds; i++) {
+        const NoeudCarte* noeud = &carte->noeuds[i];
+        const char* nom = carte_texte(carte, noeud->nom);
+        const char* type = carte_texte(carte, noeud->type);
+        graph->X[i] = noeud->x;
+        graph->Y[i] = noeud->y;
+        graph->nom[i] = chaines_interner(&graph->chaines, nom, (int)strlen(nom));
+        graph->type[i] = chaines_interner(&graph->chaines, type, (int)strlen(type));
+    }
+    for (i = 0; i < carte->nbAretes; i++) {
+        const AreteCarte* a = &carte->aretes[i];
+        ajouterarete(graph, i, a->source, a->destination, a->distance, a->prioritaire);
+        graph->attributs[i].capacite = a->capacite;
+        graph->attributs[i].feuxRouges = (a->drapeaux & CARTE_FEU) != 0;
+        graph->attributs[i].embouteillage = (a->drapeaux & CARTE_EMBOUTEILLAGE) != 0;
+        graph->attributs[i].passagers = (a->drapeaux & CARTE_PASSAGERS) != 0;
+    }
+    for (i = 0; i < carte->nbFeux; i++) {
+        const FeuCarte* f = &carte->feux[i];
+        ajouterFeuRouge(graph, f->id, f->position, f->etat, f->dureeRouge, f->dureeVert);
     }
     return graph;
 }
 
+/* Charge un graphe depuis un fichier de carte (texte ou binaire) */
+Graphe* charger_graphe(const char* fichier) {
+    Carte carte;
+    char erreur[256];
+    if (!carte_charger(&carte, fichier, erreur, sizeof(erreur))) {
+        printf("Erreur lors du chargement de la carte : %s\n", erreur);
+        return NULL;
+    }
+    Graphe* graph = graphe_depuis_carte(&carte);
+    carte_liberer(&carte);
+    return graph;
+}
+
+/* Construit le rseau compact (artes regroupes par nud source)  partir du graphe */
+Reseau* construire_reseau(Graphe* graph) {
+    return reseau_creer(graph->nbnoeuds, graph->nbaretes, graph->source, graph->destination, graph->distance,
+                        graph->X, graph->Y);
+}
+
+/* Retourne le rseau compact du graphe, reconstruit seulement si des artes ont chang.
+   Il appartient au graphe : ne pas le librer. */
+Reseau* reseau_graphe(Graphe* graph) {
+    if (!graph->reseauAJour) {
+        reseau_liberer(graph->reseau);
+        graph->reseau = construire_reseau(graph);
+        graph->reseauAJour = graph->reseau != NULL;
+    }
+    return graph->reseau;
+}
+
 /* ========================================================================= */
 /*                   Dplacement du Vhicule Principal                   */
 /* ========================================================================= */
 
 void deplacerVehiculePrincipal(Graphe* graph) {
-    Vehicule* v = &graph->principal;
+    Vehicule* v = vehicule_principal(graph);
     // Si le vhicule est arriv  destination, on termine la simulation
     if (v->positionNoeud == v->destinationNoeud) {
         printf("\nLe vehicule principal est arrive a destination (noeud %d).\n", v->destinationNoeud);
         exit(0);
     }
     printf("\n>> Deplacement du vehicule principal depuis l'arret %d\n", v->positionNoeud);
-    int i ;
-    // Si un feu rouge bloque le passage
-    for (i = 0; i < graph->nbFeux; i++) {
-        if (graph->F[i].PositionNoeud == v->positionNoeud && graph->F[i].Etat == 1) {
-            printf(">> Feu rouge detecte ! Ajout du vehicule en file d'attente...\n");
-            ajouterVehiculeFileFeu(graph, i, *v);
-            attendre_feu_rouge(graph, i);
-            return;
-        }
+    // Si un feu rouge bloque le passage (seuls les feux du nud courant sont consults)
+    const IndexFeux* index = index_feux(graph);
+    if (!index) {
+        printf("Erreur d'allocation memoire pour les feux !\n");
+        exit(1);
+    }
+    int feu = feux_rouge_au_noeud(index, graph->F, v->positionNoeud, graph->horloge);
+    if (feu >= 0) {
+        printf(">> Feu rouge detecte ! Ajout du vehicule en file d'attente...\n");
+        ajouterVehiculeFileFeu(graph, feu, 0);
+        attendre_feu_rouge(graph, feu);
+        return;
     }
     // Vrifier l'embouteillage
     if (nombreVehiculesArret(graph, v->positionNoeud) > 3) {
         printf(">> EMBOUTEILLAGE detecte ! Attente...\n");
         sleep(3);
+        avancer_horloge(graph, 3.0);
         return;
     }
-    // Trouver la prochaine route
-    Arete* prochaine_route = NULL;
-    for (i = 0; i < graph->nbaretes; i++) {
-        if (graph->A[i].Source == v->positionNoeud) {
-            prochaine_route = &graph->A[i];
-            break;
-        }
-    }
-    if (!prochaine_route) {
+    // Trouver la prochaine route : la premire arte sortante non ferme (les artes d'un nud gardent leur ordre)
+    Reseau* r = reseau_graphe(graph);
+    int k = r ? r->debut[v->positionNoeud] : 0;
+    while (r && k < r->debut[v->positionNoeud + 1] && arete_fermee(&graph->fermetures, r->idArete[k])) k++;
+    if (!r || k == r->debut[v->positionNoeud + 1]) {
         printf(">> Aucun chemin disponible.\n");
         return;
     }
-    double tempsDeplacement = prochaine_route->Distance / v->vitesse;
+    int prochaine_route = r->idArete[k];
+    double tempsDeplacement = fermetures_cout(&graph->fermetures, prochaine_route, graph->distance[prochaine_route]) / v->vitesse;
     printf(">> Deplacement en cours... Temps estime : %.2f secondes\n", tempsDeplacement);
     sleep((int)tempsDeplacement);
-    v->positionNoeud = prochaine_route->Destination;
+    avancer_horloge(graph, tempsDeplacement);
+    v->positionNoeud = graph->destination[prochaine_route];
+    trajectoires_enregistrer(&graph->trajets, v->ID, graph->horloge, v->positionNoeud, prochaine_route);
     printf(">> Le vehicule principal est arrive a l'arret %d\n", v->positionNoeud);
 }
 
@@ -510,6 +883,8 @@ void deplacerVehiculePrincipal(Graphe* graph) {
 
 /* --- Dijkstra Standard pour calculer le chemin le plus court --- */
 void Dijkstra(Graphe* graph, int source, int target){
+    Reseau* r = reseau_graphe(graph); // Artes sortantes de chaque nud, contigus
+    if (!r) return;
     int n = graph->nbnoeuds; // Nombre de noeuds du graphe 
     int dist[n] /* Contient la distance minimale connue depuis la source jusqu' chaque nud */,
 	prev[n] /* Tableau des prcdents */, 
@@ -533,17 +908,15 @@ void Dijkstra(Graphe* graph, int source, int target){
         visited[u] = 1; // Marquer la visite de l'arte 
         if(u == target) break; // Si u est le nud cible, on peut arrter car le chemin le plus court a t trouv /* Parcours de tous les nuds jusqu' trouver le nuds cible (target)*/
         // Mise  jour des distances (relaxation)
-        /* Parcours de toutes les artes sortant de u */
-        for(k = 0; k < graph->nbaretes; k++){ // Pour le nud actuellement slectionn u, on parcourt toutes les artes du graphe
-            Arete* a = &graph->A[k];
-            if(a->Source == u){ // Pour chaque arte qui part de u, on identifie le nud voisin v (la destination de l'arte)
-                int v = a->Destination;
-                if(!visited[v]){ // Si v na pas encore t visit, on calcule une nouvelle distance potentielle alt pour atteindre v en passant par u (le cours)
-                    int alt = dist[u] + (int)a->Distance; // (int) indique juste la partie entiere de a->Distance  
-                    if(alt < dist[v]){ // Si cette nouvelle distance alt est infrieure  la distance actuelle enregistre pour v (dist[v]), on met  jour
-                        dist[v] = alt; // La nouvelle distance
-                        prev[v] = u; // Pour indiquer que le meilleur chemin pour atteindre v passe par u
-                    }
+        /* Parcours des artes sortant de u : elles occupent les indices [debut[u], debut[u+1]) du rseau */
+        for(k = r->debut[u]; k < r->debut[u + 1]; k++){ // Pour chaque arte qui part de u, on identifie le nud voisin v (la destination de l'arte)
+            int v = r->cible[k];
+            if(arete_fermee(&graph->fermetures, r->idArete[k])) continue; // Route ferme (accident)
+            if(!visited[v]){ // Si v na pas encore t visit, on calcule une nouvelle distance potentielle alt pour atteindre v en passant par u (le cours)
+                int alt = dist[u] + (int)fermetures_cout(&graph->fermetures, r->idArete[k], r->poids[k]); // (int) indique juste la partie entiere de la distance
+                if(alt < dist[v]){ // Si cette nouvelle distance alt est infrieure  la distance actuelle enregistre pour v (dist[v]), on met  jour
+                    dist[v] = alt; // La nouvelle distance
+                    prev[v] = u; // Pour indiquer que le meilleur chemin pour atteindre v passe par u
                 }
             }
         }
@@ -570,6 +943,8 @@ void Dijkstra(Graphe* graph, int source, int target){
 // Mme fonctionnalit que Dijkstra Standard, mais avant d'ajouter le cot d'une arte, on vrifie si celle-ci est prioritaire. Si c'est le cas, le cot est multipli par un facteur de rduction pour favoriser ces routes
 /* Algorithme de Dijkstra modifi avec priorit pour les routes prioritaires */
 void Dijkstra_priority(Graphe* graph, int source, int target, double reduction_factor){
+    Reseau* r = reseau_graphe(graph);
+    if (!r) return;
     int n = graph->nbnoeuds;
     int dist[n], prev[n], visited[n], i, j, k;
     // Initialisation des tableaux de distances, prdcesseurs et tat de visite
@@ -593,20 +968,18 @@ void Dijkstra_priority(Graphe* graph, int source, int target, double reduction_f
         visited[u] = 1;
         if(u == target) break;
         // Mise  jour des distances des voisins du nud actuel
-        for(k = 0; k < graph->nbaretes; k++){
-            Arete* a = &graph->A[k];
-            if(a->Source == u){
-                int v = a->Destination;
-                if(!visited[v]){
-                    double weight = a->Distance;
-                    if(a->Prioritaire){
-                        weight *= reduction_factor;  // Rduction du poids pour les routes prioritaires
-                    }
-                    int alt = dist[u] + (int)weight;
-                    if(alt < dist[v]){
-                        dist[v] = alt;
-                        prev[v] = u;
-                    }
+        for(k = r->debut[u]; k < r->debut[u + 1]; k++){
+            int v = r->cible[k];
+            if(arete_fermee(&graph->fermetures, r->idArete[k])) continue; // Route ferme (accident)
+            if(!visited[v]){
+                double weight = fermetures_cout(&graph->fermetures, r->idArete[k], r->poids[k]);
+                if(graph->prioritaire[r->idArete[k]]){
+                    weight *= reduction_factor;  // Rduction du poids pour les routes prioritaires
+                }
+                int alt = dist[u] + (int)weight;
+                if(alt < dist[v]){
+                    dist[v] = alt;
+                    prev[v] = u;
                 }
             }
         }
@@ -628,12 +1001,15 @@ void Dijkstra_priority(Graphe* graph, int source, int target, double reduction_f
 }
 
 /* Fonction utilitaire : calcul de la distance euclidienne entre deux nuds */
-double Euclidean_distance(Noeud a, Noeud b) {
-    return sqrt((a.X - b.X) * (a.X - b.X) + (a.Y - b.Y) * (a.Y - b.Y));
+double Euclidean_distance(const Graphe* graph, int a, int b) {
+    double dx = graph->X[a] - graph->X[b], dy = graph->Y[a] - graph->Y[b];
+    return sqrt(dx * dx + dy * dy);
 }
 
 /* Algorithme A* pour trouver un chemin optimis  l'aide d'une heuristique (distance euclidienne) */
 void A_star(Graphe* graph, int source, int target){
+    Reseau* r = reseau_graphe(graph);
+    if (!r) return;
     int n = graph->nbnoeuds;
     double g[n], f[n];
     int prev[n], closed[n], open[n], i, k;
@@ -647,7 +1023,7 @@ void A_star(Graphe* graph, int source, int target){
     }
     // Initialisation des valeurs pour la source
     g[source] = 0;
-    f[source] = Euclidean_distance(graph->N[source], graph->N[target]);
+    f[source] = Euclidean_distance(graph, source, target);
     open[source] = 1;
     // Boucle principale de l'algorithme
     while(1){
@@ -677,24 +1053,86 @@ void A_star(Graphe* graph, int source, int target){
         open[current] = 0;
         closed[current] = 1;
         // Exploration des voisins
-        for(k = 0; k < graph->nbaretes; k++){
-            Arete* a = &graph->A[k];
-            if(a->Source == current){
-                int neighbor = a->Destination;
-                if(closed[neighbor]) continue;
-                double tentative_g = g[current] + a->Distance;
-                if(!open[neighbor]) open[neighbor] = 1;
-                else if(tentative_g >= g[neighbor]) continue;
-                prev[neighbor] = current;
-                g[neighbor] = tentative_g;
-                double h = Euclidean_distance(graph->N[neighbor], graph->N[target]);
-                f[neighbor] = g[neighbor] + h;
-            }
+        for(k = r->debut[current]; k < r->debut[current + 1]; k++){
+            int neighbor = r->cible[k];
+            if(closed[neighbor] || arete_fermee(&graph->fermetures, r->idArete[k])) continue;
+            double tentative_g = g[current] + fermetures_cout(&graph->fermetures, r->idArete[k], r->poids[k]);
+            if(!open[neighbor]) open[neighbor] = 1;
+            else if(tentative_g >= g[neighbor]) continue;
+            prev[neighbor] = current;
+            g[neighbor] = tentative_g;
+            double h = Euclidean_distance(graph, neighbor, target);
+            f[neighbor] = g[neighbor] + h;
         }
     }
     printf("A*: Aucun chemin trouve de %d vers %d.\n", source, target);
 }
 
+/* Itinraire le plus rapide  l'heure courante : temps de parcours, virages et attente aux feux selon leur cycle */
+void Itineraire_rapide(Graphe* graph, int source, int target) {
+    Reseau* r = reseau_graphe(graph);
+    EspaceVirages espace; // Un tat par arte : la recherche fait payer les virages
+    if (!r || !espace_virages_init(&espace, r->nbNoeuds, r->nbAretes)) {
+        printf("Erreur d'allocation memoire !\n");
+        return;
+    }
+    ParametresTemporels prm = { 0 };
+    prm.vitesse = vehicule_principal(graph)->vitesse;
+    prm.indexFeux = index_feux(graph);
+    prm.feux = graph->F;
+    prm.fermetures = &graph->fermetures;
+    // Dpart  l'heure courante de la simulation : les feux sont pris dans leur phase relle
+    Itineraire it = itineraire_virages(r, &prm, virages_graphe(graph), source, target, graph->horloge, &espace);
+    if (it.longueur == 0)
+        printf("Aucun chemin trouve de %d vers %d.\n", source, target);
+    else {
+        printf("Itineraire le plus rapide de %d vers %d (duree: %.2f s): ", source, target, it.cout - graph->horloge);
+        int i;
+        for (i = 0; i < it.longueur; i++)
+            printf("%d ", it.noeuds[i]);
+        printf("\n");
+    }
+    itineraire_liberer(&it);
+    espace_virages_liberer(&espace);
+}
+
+/* Itinraires de rechange : au plus 40 % plus longs que le plus rapide, et assez diffrents de lui */
+void Itineraires_alternatifs(Graphe* graph, int source, int target) {
+    Reseau* r = reseau_graphe(graph);
+    EspaceVirages espace;
+    EspaceAlternatives alternatives;
+    if (!r || !espace_virages_init(&espace, r->nbNoeuds, r->nbAretes)) {
+        printf("Erreur d'allocation memoire !\n");
+        return;
+    }
+    if (!espace_alternatives_init(&alternatives, r)) {
+        printf("Erreur d'allocation memoire !\n");
+        espace_virages_liberer(&espace);
+        return;
+    }
+    ParametresTemporels prm = { 0 };
+    prm.vitesse = vehicule_principal(graph)->vitesse;
+    prm.indexFeux = index_feux(graph);
+    prm.feux = graph->F;
+    prm.fermetures = &graph->fermetures;
+    ParametresAlternatives pa = alternatives_parametres(NB_ALTERNATIVES);
+    Itineraire it[NB_ALTERNATIVES];
+    int nb = alternatives_virages(r, &prm, virages_graphe(graph), &pa, source, target, graph->horloge, it,
+                                  &alternatives, &espace);
+    if (nb <= 1)
+        printf("Aucune alternative raisonnable de %d vers %d.\n", source, target);
+    int i, j;
+    for (i = 1; i < nb; i++) {
+        printf("Alternative %d (duree: %.2f s, +%.0f %%): ", i, it[i].cout, 100.0 * (it[i].cout / it[0].cout - 1.0));
+        for (j = 0; j < it[i].longueur; j++)
+            printf("%d ", it[i].noeuds[j]);
+        printf("\n");
+    }
+    for (i = 0; i < nb; i++) itineraire_liberer(&it[i]);
+    espace_alternatives_liberer(&alternatives);
+    espace_virages_liberer(&espace);
+}
+
 /* ========================================================================= */
 /*                   ALGORITHME DE FLOT MAXIMUM (Ford-Fulkerson)           */
 /* ========================================================================= */
@@ -739,8 +1177,8 @@ int Ford_Fulkerson(Graphe* graph, int source, int sink) {
     }
     /* Remplissage de la matrice rsiduelle avec les capacits des artes */
     for(i = 0; i < graph->nbaretes; i++){
-        Arete* a = &graph->A[i];
-        residual[a->Source][a->Destination] = a->capacite;
+        if(graph->source[i] < 0 || arete_fermee(&graph->fermetures, i)) continue; // Une route ferme ne transporte rien
+        residual[graph->source[i]][graph->destination[i]] = graph->attributs[i].capacite;
     }
     int max_flow = 0;
     int *parent = (int*)malloc(nb * sizeof(int));
@@ -784,9 +1222,10 @@ void recalculer_itineraire(Graphe* graph, int source, int target, int affectedEd
         printf("Indice d'arete invalide.\n");
         return;
     }
-    graph->A[affectedEdgeIndex].Distance *= congestionFactor;
+    graph->distance[affectedEdgeIndex] *= congestionFactor;
+    graph->reseauAJour = 0;
     printf("Perturbation simulee sur l'arete %d, nouveau poids: %.2f\n",
-           affectedEdgeIndex, graph->A[affectedEdgeIndex].Distance);
+           affectedEdgeIndex, graph->distance[affectedEdgeIndex]);
     Dijkstra(graph, source, target);
 }
 /* ===================== Affichage du graphe ===================== */
@@ -796,47 +1235,2153 @@ void afficher_graph(Graphe* graph) {
     printf("Stations (%d) :\n", graph->nbnoeuds);
     int i;
     for (i = 0; i < graph->nbnoeuds; i++) {
-        Noeud* n = &graph->N[i];
         printf(" - Station : ID = %d : '%s' (%s), Coordonnees : (%d, %d)\n",
-               n->ID, n->Nom, n->Type, n->X, n->Y);
+               i, noeud_nom(graph, i), noeud_type(graph, i), graph->X[i], graph->Y[i]);
     }
     printf("\nTrajets (%d) :\n", graph->nbaretes);
     for (i = 0; i < graph->nbaretes; i++) {
-        Arete* a = &graph->A[i];
        printf(" - Trajet %d : De l'arret %d a l'arret %d, Distance : %.2f, Prioritaire : %d\n",
-               i, a->Source, a->Destination, a->Distance, a->Prioritaire);
+               i, graph->source[i], graph->destination[i], graph->distance[i], graph->prioritaire[i]);
     }
 }
+/* ========================================================================= */
+/*                SIMULATION A GRANDE ECHELLE (MULTI-THREAD)             */
+/* ========================================================================= */
+
+/* Cre une ville synthtique en grille : cote x cote carrefours relis par des rues  double sens */
+Graphe* creer_ville_grille(int cote) {
+    int n = cote * cote, m = 4 * cote * (cote - 1), nbFeux = n / 5 + 1;
+    Graphe* graph = creergraphe(n, m, nbFeux);
+    if (!graph) return NULL;
+    int x, y, indice = 0, feu = 0;
+    char nom[50];
+    // Carrefours espacs de 100 units
+    for (y = 0; y < cote; y++) {
+        for (x = 0; x < cote; x++) {
+            snprintf(nom, sizeof(nom), "Carrefour %d-%d", x, y);
+            ajouternoeud(graph, y * cote + x, nom, "Carrefour", x * 100, y * 100);
+        }
+    }
+    // Rues horizontales et verticales dans les deux sens, longueurs lgrement variables
+    for (y = 0; y < cote; y++) {
+        for (x = 0; x < cote; x++) {
+            int u = y * cote + x;
+            double longueur = 100.0 + (u * 37) % 40;
+            if (x + 1 < cote) {
+                ajouterarete(graph, indice++, u, u + 1, longueur, (y % 4) == 0);
+                ajouterarete(graph, indice++, u + 1, u, longueur, (y % 4) == 0);
+            }
+            if (y + 1 < cote) {
+                ajouterarete(graph, indice++, u, u + cote, longueur, (x % 4) == 0);
+                ajouterarete(graph, indice++, u + cote, u, longueur, (x % 4) == 0);
+            }
+        }
+    }
+    // Un feu rouge tous les cinq carrefours
+    for (x = 0; x < n && feu < nbFeux; x += 5)
+        ajouterFeuRouge(graph, feu++, x, 1, 30, 30);
+    graph->nbFeux = feu;
+    return graph;
+}
+
+/* Attente aux feux d'un nud pour la simulation multi-thread (lecture seule, sans verrou) */
+double attente_feux_simulation(void* contexte, int noeud, double temps) {
+    Graphe* graph = (Graphe*)contexte;
+    return feux_attente_noeud(&graph->indexFeux, graph->F, noeud, temps);
+}
+
+/* Simule le mme scnario avec 1  maxThreads rgions et affiche le gain obtenu.
+   L'empreinte de l'tat final doit tre identique pour tous les dcoupages. */
+void rapport_scalabilite_simulation(Graphe* graph, int nbVehicules, double duree, int maxThreads) {
+    Reseau* r = construire_reseau(graph);
+    const IndexFeux* index = index_feux(graph); // Index construit avant le lancement des threads
+    VehiculeSim* vehicules = (VehiculeSim*)malloc(sizeof(VehiculeSim) * (nbVehicules > 0 ? nbVehicules : 1));
+    if (!r || !index || !vehicules) {
+        printf("Erreur d'allocation memoire pour la simulation !\n");
+        reseau_liberer(r);
+        free(vehicules);
+        return;
+    }
+    printf("\n=== Simulation multi-thread : %d noeuds, %d aretes, %d vehicules, %.0f s simulees ===\n",
+           r->nbNoeuds, r->nbAretes, nbVehicules, duree);
+    printf("Threads | Temps (s) | Evenements/s | Gain     | Transferts | Resultat\n");
+    unsigned long long reference = 0;
+    double tempsReference = 0.0;
+    int k, i;
+    for (k = 1; k <= maxThreads; k++) {
+        // Mme graine pour chaque dcoupage : seul le nombre de rgions change
+        vehicules_sim_init(vehicules, nbVehicules, r, 10.0, 42);
+        int* region = partition_multiniveau(r, k, PARTITION_TOLERANCE, k, NULL);
+        SimulationParallele* sim = region ? simulation_parallele_creer(r, region, k, vehicules, nbVehicules, duree) : NULL;
+        if (!sim) {
+            printf("Erreur d'allocation memoire pour la simulation !\n");
+            free(region);
+            break;
+        }
+        sim->attenteNoeud = attente_feux_simulation;
+        sim->contexteAttente = graph;
+        sim->fermetures = &graph->fermetures;
+        double debut = chrono_secondes();
+        if (!simulation_parallele_executer(sim)) {
+            printf("Erreur : simulation sur %d threads impossible (thread ou memoire) !\n", k);
+            simulation_parallele_liberer(sim);
+            free(region);
+            break;
+        }
+        double temps = chrono_secondes() - debut;
+        long evenements = 0, transferts = 0;
+        for (i = 0; i < k; i++) {
+            evenements += sim->regions[i].nbEvenements;
+            transferts += sim->regions[i].nbEnvoyes;
+        }
+        unsigned long long empreinte = simulation_empreinte(vehicules, nbVehicules);
+        if (k == 1) {
+            reference = empreinte;
+            tempsReference = temps;
+        }
+        printf("%7d | %9.3f | %12.0f | x%-7.2f | %10ld | %s\n", k, temps,
+               temps > 0 ? evenements / temps : 0.0, temps > 0 ? tempsReference / temps : 0.0,
+               transferts, empreinte == reference ? "identique" : "DIFFERENT");
+        simulation_parallele_liberer(sim);
+        free(region);
+    }
+    free(vehicules);
+    reseau_liberer(r);
+}
+
+/* Mesure les allocations des files de feux sur un trafic simul seconde par seconde (sans affichage
+   ni pause) : les vhicules qui arrivent  un feu rouge sont mis dans sa file, les files des feux
+   verts sont vides. L'ancienne file chane faisait un malloc par mise en file et un free par sortie :
+   ses appels sont estims  partir des mises en file et des sorties, pas mesurs. */
+void banc_files_feux(Graphe* graph, int nbVehicules, int duree) {
+    double* arrivee = (double*)malloc(sizeof(double) * (nbVehicules > 0 ? nbVehicules : 1)); // -1 : en file
+    if (!arrivee || graph->nbFeux <= 0) {
+        printf("Erreur d'allocation memoire pour le banc d'essai !\n");
+        free(arrivee);
+        return;
+    }
+    int premier = graph->nbVehicules, i, f, t;
+    unsigned int graine = 12345;
+    for (i = 0; i < nbVehicules; i++) {
+        Vehicule v = {i + 1, "Voiture", 4, 0, 0, 0, 10.0, NULL, 0};
+        if (enregistrer_vehicule(graph, v) < 0) {
+            nbVehicules = i;
+            break;
+        }
+        arrivee[i] = i % 30;
+    }
+    long allocationsAvant = allocationsFiles, misesEnFile = 0, sorties = 0;
+    double debut = chrono_secondes();
+    for (t = 0; t < duree; t++) {
+        // Arrives aux feux (feu choisi au hasard, graine fixe)
+        for (i = 0; i < nbVehicules; i++) {
+            if (arrivee[i] < 0 || arrivee[i] > t) continue;
+            graine = graine * 1103515245u + 12345u;
+            f = (graine >> 16) % graph->nbFeux;
+            if (feu_etat(&graph->F[f], t)) {
+                enfiler(&graph->filesFeux[f], premier + i);
+                graph->occupationNoeud[graph->F[f].PositionNoeud]++;
+                arrivee[i] = -1;
+                misesEnFile++;
+            } else {
+                arrivee[i] = t + 10 + (graine >> 8) % 30;
+            }
+        }
+        // Les feux verts librent leur file
+        for (f = 0; f < graph->nbFeux; f++) {
+            if (feu_etat(&graph->F[f], t)) continue;
+            File* file = &graph->filesFeux[f];
+            while (file->taille > 0) {
+                i = defiler(file) - premier;
+                sorties++;
+                graph->occupationNoeud[graph->F[f].PositionNoeud]--;
+                arrivee[i] = t + 10 + i % 30;
+            }
+        }
+    }
+    double temps = chrono_secondes() - debut;
+    long allocations = allocationsFiles - allocationsAvant;
+    printf("\n=== Files des feux : %d feux, %d vehicules, %d s simulees (%.3f s) ===\n",
+           graph->nbFeux, nbVehicules, duree, temps);
+    printf("Mises en file              : %ld\n", misesEnFile);
+    printf("File chainee (estimation)  : %ld appels, %.1f par seconde simulee (1 malloc par mise en file,"
+           " 1 free par sortie)\n", misesEnFile + sorties,
+           duree > 0 ? (double)(misesEnFile + sorties) / duree : 0.0);
+    printf("Tampons circulaires        : %ld appels, %.3f par seconde simulee\n",
+           allocations, duree > 0 ? (double)allocations / duree : 0.0);
+    free(arrivee);
+}
+
+/* Scnario passagers sans affichage : des bus tournent sur les arrts de la ville pendant que des
+   passagers apparaissent aux arrts, jusqu' ce que tous soient arrivs. Affiche les appels 
+   l'allocateur faits par le pool et les files des arrts, une estimation de ceux de l'ancien code
+   (un malloc et un free par passager embarqu, plus ceux des nuds de file : 4 par passager
+   arriv, calculs et non mesurs) et le pic de mmoire rsidente. */
+void banc_passagers(Graphe* graph, long nbPassagers, int nbBus, int capaciteBus) {
+    int n = graph->nbnoeuds, i, scenario;
+    int premier = graph->nbVehicules;
+    for (i = 0; i < nbBus; i++) {
+        Vehicule bus = {i + 1, "Bus", capaciteBus, 0, 0, 0, 10.0, NULL, 0};
+        if (enregistrer_vehicule(graph, bus) < 0) {
+            nbBus = i;
+            break;
+        }
+    }
+    journalPassagers = 0;
+    printf("\n=== Passagers : %ld passagers, %d arrets, %d bus de %d places ===\n", nbPassagers, n, nbBus, capaciteBus);
+    printf("Scenario | Temps (s) | Etapes | Appels alloc | Ancien code estime | Pic RSS (Ko)\n");
+    // Le second scnario rutilise les blocs conservs par la remise  zro des pools
+    for (scenario = 1; scenario <= 2; scenario++) {
+        long crees = 0, arrives = 0, etapes = 0;
+        long appelsAvant = graph->poolPassagers.nbAppelsAllocateur + allocationsFiles;
+        unsigned int graine = 2024;
+        for (i = 0; i < nbBus; i++)
+            graph->vehicules[premier + i].positionNoeud = (int)((long)i * n / nbBus);
+        double debut = chrono_secondes();
+        while (arrives < nbPassagers) {
+            // Arrive de nouveaux passagers
+            int k;
+            for (k = 0; k < 2 * nbBus && crees < nbPassagers; k++) {
+                graine = graine * 1103515245u + 12345u;
+                int origine = (graine >> 8) % n;
+                int destination = (origine + 1 + (graine >> 16) % (n - 1)) % n;
+                if (ajouterPassagerArret(graph, origine, (int)crees, destination)) crees++;
+            }
+            // Chaque bus dpose, prend des passagers puis passe  l'arrt suivant
+            for (i = premier; i < premier + nbBus; i++) {
+                Vehicule* bus = &graph->vehicules[i];
+                int avant = bus->Npassager;
+                debarquer_passagers(graph, bus);
+                arrives += avant - bus->Npassager;
+                embarquer_passagers(graph, bus);
+                bus->positionNoeud = (bus->positionNoeud + 1) % n;
+            }
+            etapes++;
+        }
+        double temps = chrono_secondes() - debut;
+        long appels = graph->poolPassagers.nbAppelsAllocateur + allocationsFiles - appelsAvant;
+        printf("%8d | %9.3f | %6ld | %12ld | %18ld | %ld\n", scenario, temps, etapes, appels, 4 * arrives, memoire_pic_ko());
+        reinitialiserPassagers(graph);
+    }
+    journalPassagers = 1;
+}
+
+/* Passagers produits par le gnrateur de demande, dposs dans la file de leur arrt d'origine */
+typedef struct {
+    Graphe* graph;
+    long prochainID;
+    long perdus;       // Passagers non ajouts (mmoire puise)
+} ContexteDemande;
+
+void arrivee_passager(void* contexte, double date, int origine, int destination) {
+    ContexteDemande* ctx = (ContexteDemande*)contexte;
+    (void)date;
+    if (ajouterPassagerArret(ctx->graph, origine, (int)(ctx->prochainID++ & 0x7fffffff), destination) == 0)
+        ctx->perdus++;
+}
+
+/* Journe simule par pas de 'pas' secondes : la demande (matrice gravitaire entre les arrts, profil
+   horaire  deux pointes) alimente les files des arrts au fil du temps, des vhicules font le tour
+   des arrts. Sans affichage ni pause. */
+void simulation_demande(Graphe* graph, double passagersParJour, int nbVehicules, int capacite, double pas) {
+    static const double profil[24] = {
+        0.10, 0.05, 0.05, 0.05, 0.10, 0.30, 0.80, 1.60, 2.00, 1.20, 0.80, 0.80,
+        1.00, 0.90, 0.80, 0.90, 1.20, 1.80, 2.00, 1.30, 0.80, 0.50, 0.30, 0.20 };
+    int n = graph->nbnoeuds, o, d, i, h;
+    double* od = (double*)malloc(sizeof(double) * n * n);
+    if (!od) {
+        printf("Erreur d'allocation memoire pour la demande !\n");
+        return;
+    }
+    // Modle gravitaire : la demande dcrot avec la distance entre les arrts
+    double somme = 0.0, sommeProfil = 0.0;
+    for (o = 0; o < n; o++)
+        for (d = 0; d < n; d++) {
+            double dx = graph->X[o] - graph->X[d], dy = graph->Y[o] - graph->Y[d];
+            od[o * n + d] = (o == d) ? 0.0 : 1.0 / (1.0 + sqrt(dx * dx + dy * dy) / 300.0);
+            somme += od[o * n + d];
+        }
+    // Mise  l'chelle : la moyenne du profil interpol est celle de ses 24 valeurs
+    for (h = 0; h < 24; h++) sommeProfil += profil[h];
+    for (o = 0; o < n * n; o++) od[o] *= passagersParJour / (sommeProfil * somme);
+    GenerateurDemande demande;
+    int ok = demande_init(&demande, od, n, profil, 0.0, 20240601ULL);
+    free(od);
+    if (!ok) {
+        printf("Erreur d'initialisation de la demande !\n");
+        return;
+    }
+    int premier = graph->nbVehicules;
+    for (i = 0; i < nbVehicules; i++) {
+        Vehicule v = {i + 1, "Bus", capacite, 0, (int)((long)i * n / nbVehicules), 0, 10.0, NULL, 0};
+        if (enregistrer_vehicule(graph, v) < 0) {
+            nbVehicules = i;
+            break;
+        }
+    }
+    journalPassagers = 0;
+    ContexteDemande ctx = { graph, 0, 0 };
+    long arrives = 0, attenteMax = 0;
+    double t, debut = chrono_secondes();
+    printf("\n=== Demande voyageurs : %.0f passagers/jour, %d arrets, %d vehicules de %d places ===\n",
+           passagersParJour, n, nbVehicules, capacite);
+    printf("Heure | Generes cumules | En attente | Arrives cumules\n");
+    for (t = 0.0; t < 86400.0; t += pas) {
+        demande_avancer(&demande, t + pas, arrivee_passager, &ctx);
+        for (i = premier; i < premier + nbVehicules; i++) {
+            Vehicule* v = &graph->vehicules[i];
+            int avant = v->Npassager;
+            debarquer_passagers(graph, v);
+            arrives += avant - v->Npassager;
+            embarquer_passagers(graph, v);
+            v->positionNoeud = (v->positionNoeud + 1) % n;
+        }
+        long attente = 0;
+        for (o = 0; o < n; o++) attente += graph->filesAttente[o].taille;
+        if (attente > attenteMax) attenteMax = attente;
+        if (fmod(t + pas, 3 * 3600.0) < pas)
+            printf("%4.0fh | %15ld | %10ld | %15ld\n", (t + pas) / 3600.0, demande.nbGeneres, attente, arrives);
+    }
+    double temps = chrono_secondes() - debut;
+    printf("Passagers generes : %ld en %.2f s (%.1f millions/s), attente maximale : %ld, perdus : %ld\n",
+           demande.nbGeneres, temps, temps > 0 ? demande.nbGeneres / temps / 1e6 : 0.0, attenteMax, ctx.perdus);
+    printf("Pic de memoire residente : %ld Ko\n", memoire_pic_ko());
+    journalPassagers = 1;
+    demande_liberer(&demande);
+}
+
+/* Compte les dplacements rendus par une requte sur les trajectoires */
+void compter_deplacement(void* contexte, int vehicule, double date, int noeud, int arete) {
+    (void)vehicule; (void)date; (void)noeud; (void)arete;
+    (*(long*)contexte)++;
+}
+
+/* Enregistre chaque dplacement de nbVehicules vhicules qui circulent au hasard dans la ville pendant
+   'duree' secondes (simulation  vnements), avec un budget mmoire fixe, puis interroge la trajectoire
+   d'un vhicule en mmoire et, si un fichier de dbordement est donn, sur disque. */
+void banc_trajectoires(Graphe* graph, int nbVehicules, double duree, size_t budget, const char* fichier) {
+    Reseau* r = construire_reseau(graph);
+    int* position = (int*)malloc(sizeof(int) * (nbVehicules > 0 ? nbVehicules : 1));
+    Trajectoires traj;
+    Tas evenements;
+    if (!r || !position || !tas_init(&evenements, nbVehicules > 0 ? nbVehicules : 1) ||
+        !trajectoires_init(&traj, budget, 0.0, fichier)) {
+        printf("Erreur d'initialisation des trajectoires !\n");
+        reseau_liberer(r);
+        free(position);
+        return;
+    }
+    int i;
+    unsigned int graine = 7;
+    // Dparts tals sur la premire minute
+    for (i = 0; i < nbVehicules; i++) {
+        graine = graine * 1103515245u + 12345u;
+        position[i] = (graine >> 8) % r->nbNoeuds;
+        tas_inserer(&evenements, (i % 600) / 10.0, i);
+    }
+    double debut = chrono_secondes();
+    // Chaque vnement : le vhicule a atteint position[i] et repart par une arte tire au hasard
+    while (evenements.taille > 0) {
+        ElementTas e = tas_extraire(&evenements);
+        if (e.cle > duree) break;
+        i = e.valeur;
+        int u = position[i];
+        int degre = r->debut[u + 1] - r->debut[u];
+        if (degre == 0) continue;
+        graine = graine * 1103515245u + 12345u;
+        int k = r->debut[u] + (graine >> 8) % degre;
+        double arrivee = e.cle + r->poids[k] / 2.0; // 2 units de distance par seconde
+        position[i] = r->cible[k];
+        trajectoires_enregistrer(&traj, i, arrivee, r->cible[k], r->idArete[k]);
+        tas_inserer(&evenements, arrivee, i);
+    }
+    double temps = chrono_secondes() - debut;
+    printf("\n=== Trajectoires : %d vehicules, %.0f s simulees, budget %.1f Mo ===\n",
+           nbVehicules, duree, budget / 1048576.0);
+    printf("Deplacements enregistres : %ld en %.2f s (%.1f millions/s)\n",
+           traj.nbEnregistres, temps, temps > 0 ? traj.nbEnregistres / temps / 1e6 : 0.0);
+    printf("En memoire : %ld (%d blocs, %.1f Mo), ecrits sur disque : %ld, oublies : %ld\n",
+           traj.nbEnregistres - traj.nbEcrits - traj.nbOublies, traj.nbBlocs,
+           traj.nbBlocs * (sizeof(BlocTrajectoires) + TRAJ_TAILLE_BLOC * TRAJ_OCTETS_PAR_DEPLACEMENT) / 1048576.0,
+           traj.nbEcrits, traj.nbOublies);
+    long trouves = 0;
+    debut = chrono_secondes();
+    trajectoires_parcourir(&traj, nbVehicules / 2, 0.0, duree, compter_deplacement, &trouves);
+    printf("Vehicule %d en memoire : %ld deplacements (%.3f s)\n", nbVehicules / 2, trouves, chrono_secondes() - debut);
+    printf("Pic de memoire residente : %ld Ko\n", memoire_pic_ko());
+    trajectoires_liberer(&traj); // Vide aussi les blocs restants dans le fichier
+    if (fichier)
+        printf("Fichier de debordement : %ld deplacements ecrits, %ld oublies%s\n", traj.nbEcrits, traj.nbOublies,
+               traj.erreurDisque ? " (ERREUR D'ECRITURE, fichier tronque)" : "");
+    if (fichier) {
+        trouves = 0;
+        debut = chrono_secondes();
+        trajectoires_parcourir_fichier(fichier, nbVehicules / 2, 0.0, duree, compter_deplacement, &trouves);
+        printf("Vehicule %d sur disque : %ld deplacements sur la journee (%.3f s)\n",
+               nbVehicules / 2, trouves, chrono_secondes() - debut);
+    }
+    tas_liberer(&evenements);
+    free(position);
+    reseau_liberer(r);
+}
+
+/* crit une ville en grille de cote x cote carrefours aux formats texte et binaire, puis mesure
+   le temps de chargement de chacun */
+void banc_carte(int cote, const char* prefixe) {
+    Carte carte;
+    char fichierTexte[512], fichierBinaire[512], erreur[256], nom[32];
+    int x, y;
+    snprintf(fichierTexte, sizeof(fichierTexte), "%s.txt", prefixe);
+    snprintf(fichierBinaire, sizeof(fichierBinaire), "%s.bin", prefixe);
+    carte_init(&carte);
+    carte_reserver_tailles(&carte, cote * cote, 4 * cote * (cote - 1), cote * cote / 5 + 1);
+    for (y = 0; y < cote; y++)
+        for (x = 0; x < cote; x++) {
+            int longueur = snprintf(nom, sizeof(nom), "C%d-%d", x, y);
+            carte_ajouter_noeud(&carte, y * cote + x, x * 100, y * 100, nom, longueur, "Carrefour", 9);
+        }
+    for (y = 0; y < cote; y++)
+        for (x = 0; x < cote; x++) {
+            int u = y * cote + x;
+            double longueur = 100.0 + (u * 37) % 40 + 0.25;
+            if (x + 1 < cote) {
+                carte_ajouter_arete(&carte, u, u + 1, longueur, (y % 4) == 0, 20, 0);
+                carte_ajouter_arete(&carte, u + 1, u, longueur, (y % 4) == 0, 20, 0);
+            }
+            if (y + 1 < cote) {
+                carte_ajouter_arete(&carte, u, u + cote, longueur, (x % 4) == 0, 20, 0);
+                carte_ajouter_arete(&carte, u + cote, u, longueur, (x % 4) == 0, 20, 0);
+            }
+        }
+    for (x = 0; x < cote * cote; x += 5)
+        carte_ajouter_feu(&carte, x / 5, x, 1, 30, 30);
+    if (!carte_ecrire_texte(&carte, fichierTexte) || !carte_ecrire_binaire(&carte, fichierBinaire)) {
+        printf("Erreur d'ecriture des cartes !\n");
+        carte_liberer(&carte);
+        return;
+    }
+    printf("\n=== Chargement de carte : %d noeuds, %d aretes, %d feux ===\n", carte.nbNoeuds, carte.nbAretes, carte.nbFeux);
+    int nbAretes = carte.nbAretes;
+    carte_liberer(&carte);
+    const char* fichiers[2] = { fichierTexte, fichierBinaire };
+    int k;
+    for (k = 0; k < 2; k++) {
+        double debut = chrono_secondes();
+        int ok = carte_charger(&carte, fichiers[k], erreur, sizeof(erreur));
+        double temps = chrono_secondes() - debut;
+        if (!ok) {
+            printf("%s : %s\n", fichiers[k], erreur);
+            continue;
+        }
+        printf("%-30s : %.3f s (%.1f millions d'aretes/s)%s\n", fichiers[k], temps,
+               temps > 0 ? carte.nbAretes / temps / 1e6 : 0.0, carte.nbAretes == nbAretes ? "" : " ERREUR");
+        carte_liberer(&carte);
+    }
+}
+
+/* Empreinte d'une carte calcule dans deux processus. Le second remplit d'abord son tas d'octets
+   non nuls : un octet non initialis (bourrage) pris dans l'empreinte la ferait changer, et un
+   instantan crit par un excutable serait refus par un autre. Retourne 1 si elles sont gales. */
+int verifier_empreinte_carte(const char* fichier) {
+    Carte carte;
+    char erreur[256];
+    int tube[2], k;
+    if (!carte_charger(&carte, fichier, erreur, sizeof(erreur))) {
+        printf("Erreur lors du chargement de la carte : %s\n", erreur);
+        return 0;
+    }
+    uint64_t empreinte = carte_empreinte(&carte), autre = 0;
+    carte_liberer(&carte);
+    if (pipe(tube) != 0) {
+        printf("Erreur : creation du tube impossible\n");
+        return 0;
+    }
+    pid_t fils = fork();
+    if (fils == 0) {
+        void* blocs[64];
+        close(tube[0]);
+        for (k = 0; k < 64; k++) {
+            blocs[k] = malloc((size_t)1024 << (k % 10));
+            if (blocs[k]) memset(blocs[k], 0xA5, (size_t)1024 << (k % 10));
+        }
+        for (k = 0; k < 64; k++) free(blocs[k]);
+        if (carte_charger(&carte, fichier, NULL, 0)) {
+            autre = carte_empreinte(&carte);
+            carte_liberer(&carte);
+        }
+        ssize_t ecrits = write(tube[1], &autre, sizeof(autre));
+        _exit(ecrits == (ssize_t)sizeof(autre) ? 0 : 1);
+    }
+    close(tube[1]);
+    int lu = fils > 0 && read(tube[0], &autre, sizeof(autre)) == (ssize_t)sizeof(autre);
+    close(tube[0]);
+    if (fils > 0) waitpid(fils, NULL, 0);
+    printf("%s : empreinte %016llx, autre processus %016llx : %s\n", fichier, (unsigned long long)empreinte,
+           (unsigned long long)autre, lu && autre == empreinte ? "identique" : "DIFFERENTE");
+    return lu && autre == empreinte;
+}
+
+/* Temps jusqu' la premire requte : carte charge puis graphe construit, contre instantan
+   projet en mmoire. Les itinraires des deux graphes sont ensuite compars. */
+void banc_instantane(const char* fichierCarte, const char* fichierInstantane, int nbRequetes) {
+    Carte carte;
+    Instantane inst;
+    Reseau* r = NULL;
+    FeuRouge* feux = NULL;
+    IndexFeux index;
+    EspaceRecherche espaceCarte, espaceInstantane;
+    char erreur[256];
+    ParametresTemporels prm = { 0 };
+    prm.vitesse = 10.0;
+    // 1. Carte : analyse du fichier, construction du rseau et des feux, premire requte
+    double debut = chrono_secondes();
+    if (!carte_charger(&carte, fichierCarte, erreur, sizeof(erreur))) {
+        printf("Erreur lors du chargement de la carte : %s\n", erreur);
+        return;
+    }
+    if (!carte_construire_reseau(&carte, &r, &feux, &index) || !espace_init(&espaceCarte, carte.nbNoeuds)) {
+        printf("Erreur d'allocation memoire !\n");
+        carte_liberer(&carte);
+        return;
+    }
+    int n = carte.nbNoeuds;
+    double pretCarte = chrono_secondes() - debut;
+    prm.indexFeux = &index;
+    prm.feux = feux;
+    Itineraire it = itineraire_temporel(r, &prm, 0, n - 1, 0.0, &espaceCarte);
+    double tempsCarte = chrono_secondes() - debut;
+    itineraire_liberer(&it);
+    carte_liberer(&carte);
+    // 2. Instantan : projection, contrle qu'il est  jour, vues sur les sections, premire requte
+    debut = chrono_secondes();
+    int ouvert = instantane_ouvrir(&inst, fichierInstantane, erreur, sizeof(erreur));
+    if (!ouvert || !espace_init(&espaceInstantane, n)) {
+        if (ouvert) {
+            printf("Erreur d'allocation memoire !\n");
+            instantane_fermer(&inst);
+        } else {
+            printf("Erreur : %s\n", erreur);
+        }
+        espace_liberer(&espaceCarte);
+        free(feux);
+        index_feux_liberer(&index);
+        reseau_liberer(r);
+        return;
+    }
+    int aJour = instantane_a_jour(&inst, fichierCarte);
+    double pretInstantane = chrono_secondes() - debut;
+    ParametresTemporels prmInst = prm;
+    prmInst.indexFeux = &inst.indexFeux;
+    prmInst.feux = inst.feux;
+    it = itineraire_temporel(&inst.reseau, &prmInst, 0, n - 1, 0.0, &espaceInstantane);
+    double tempsInstantane = chrono_secondes() - debut;
+    itineraire_liberer(&it);
+    printf("\n=== Premiere requete : %d noeuds, %d aretes ===\n", n, inst.reseau.nbAretes);
+    printf("Carte %-24s : pret en %.3f s, premiere requete a %.3f s\n", fichierCarte, pretCarte, tempsCarte);
+    printf("Instantane %-19s : pret en %.3f s, premiere requete a %.3f s (%.1f Mo projetes)%s\n",
+           fichierInstantane, pretInstantane, tempsInstantane, inst.taille / 1048576.0,
+           aJour ? "" : " PERIME");
+    // 3. Mmes itinraires sur les deux graphes
+    int i, differences = 0;
+    unsigned int graine = 11;
+    for (i = 0; i < nbRequetes && n > 0 && inst.reseau.nbNoeuds == n; i++) {
+        graine = graine * 1103515245u + 12345u;
+        int s = (graine >> 8) % n;
+        graine = graine * 1103515245u + 12345u;
+        int c = (graine >> 8) % n;
+        Itineraire a = itineraire_temporel(r, &prm, s, c, i, &espaceCarte);
+        Itineraire b = itineraire_temporel(&inst.reseau, &prmInst, s, c, i, &espaceInstantane);
+        if (a.longueur != b.longueur || a.cout != b.cout ||
+            (a.longueur > 0 && memcmp(a.noeuds, b.noeuds, sizeof(int) * a.longueur) != 0))
+            differences++;
+        itineraire_liberer(&a);
+        itineraire_liberer(&b);
+    }
+    printf("%d requetes comparees, %d differences\n", i, differences);
+    instantane_fermer(&inst);
+    espace_liberer(&espaceInstantane);
+    espace_liberer(&espaceCarte);
+    free(feux);
+    index_feux_liberer(&index);
+    reseau_liberer(r);
+}
+
+/* Requtes (numros externes) sur un rseau renumrot : dure totale et somme des cots */
+static double banc_ordre(const char* nom, const Reseau* r, const Numerotation* num, const int* paires,
+                         int nbRequetes, int heuristique, double* coutTotal) {
+    EspaceRecherche espace;
+    ParametresTemporels prm = { 0 };
+    int i, proches = 0, k, u;
+    prm.vitesse = 1.0;
+    prm.heuristique = heuristique;
+    if (!espace_init(&espace, r->nbNoeuds)) return -1.0;
+    // Artes dont les extrmits tiennent dans une mme ligne de cache de dist[] (8 doubles)
+    for (u = 0; u < r->nbNoeuds; u++)
+        for (k = r->debut[u]; k < r->debut[u + 1]; k++)
+            if (abs(r->cible[k] - u) < 8) proches++;
+    *coutTotal = 0.0;
+    double debut = chrono_secondes();
+    for (i = 0; i < nbRequetes; i++) {
+        Itineraire it = itineraire_temporel(r, &prm, num->versInterne[paires[2 * i]],
+                                            num->versInterne[paires[2 * i + 1]], 0.0, &espace);
+        itineraire_vers_externe(&it, num);
+        *coutTotal += it.cout;
+        itineraire_liberer(&it);
+    }
+    double duree = chrono_secondes() - debut;
+    printf("%-10s %-9s : ecart moyen %9.1f, %5.1f %% d'aretes proches, %7.3f s (%.2f ms/requete)\n", nom,
+           heuristique ? "A*" : "Dijkstra", reseau_ecart_moyen(r), r->nbAretes ? 100.0 * proches / r->nbAretes : 0.0,
+           duree, nbRequetes ? 1000.0 * duree / nbRequetes : 0.0);
+    espace_liberer(&espace);
+    return duree;
+}
+
+/**
+ * Banc d'essai de la renumrotation : grille cote x cote numrote au hasard (comme les
+ * identifiants d'un import), puis par lignes, selon Hilbert et selon RCM. Les mmes requtes,
+ * en numros externes, sont calcules sur chaque ordre ; les cots doivent tre identiques.
+ */
+void banc_renumerotation(int cote, int nbRequetes) {
+    const char* noms[4] = { "Hasard", "Lignes", "Hilbert", "RCM" };
+    Numerotation ordres[4];
+    Reseau* reseaux[4] = { NULL };
+    double temps[4] = { 0 };
+    int i, o, h;
+    Graphe* ville = creer_ville_grille(cote);
+    Reseau* grille = ville ? reseau_graphe(ville) : NULL;
+    int n = grille ? grille->nbNoeuds : 0;
+    int* paires = (int*)malloc(sizeof(int) * 2 * (nbRequetes > 0 ? nbRequetes : 1));
+    memset(ordres, 0, sizeof(ordres));
+    int ok = grille && paires && numerotation_allouer(&ordres[0], n) && numerotation_allouer(&ordres[1], n);
+    // Numrotation alatoire (graine fixe) : point de dpart sans localit, ses numros sont les numros externes
+    unsigned int graine = 2024;
+    for (i = 0; ok && i < n; i++) ordres[0].versExterne[i] = i;
+    for (i = n - 1; ok && i > 0; i--) {
+        graine = graine * 1103515245u + 12345u;
+        int j = (graine >> 8) % (i + 1), t = ordres[0].versExterne[i];
+        ordres[0].versExterne[i] = ordres[0].versExterne[j];
+        ordres[0].versExterne[j] = t;
+    }
+    if (ok) {
+        numerotation_inverser(&ordres[0]);
+        reseaux[0] = reseau_renumeroter(grille, &ordres[0]);
+        ok = reseaux[0] != NULL;
+    }
+    // Ordre par lignes : numro d'origine de la grille
+    if (ok) {
+        memcpy(ordres[1].versInterne, ordres[0].versExterne, sizeof(int) * n);
+        memcpy(ordres[1].versExterne, ordres[0].versInterne, sizeof(int) * n);
+    }
+    // Le hasard sert ensuite de rfrence : numrotation identit sur son propre rseau
+    for (i = 0; ok && i < n; i++) ordres[0].versInterne[i] = ordres[0].versExterne[i] = i;
+    double debut = chrono_secondes();
+    ok = ok && numerotation_hilbert(&ordres[2], reseaux[0]->X, reseaux[0]->Y, n);
+    temps[2] = chrono_secondes() - debut;
+    debut = chrono_secondes();
+    ok = ok && numerotation_rcm(&ordres[3], reseaux[0]);
+    temps[3] = chrono_secondes() - debut;
+    for (o = 1; ok && o < 4; o++) {
+        reseaux[o] = reseau_renumeroter(reseaux[0], &ordres[o]);
+        ok = reseaux[o] != NULL;
+    }
+    if (!ok) {
+        printf("Erreur d'allocation memoire !\n");
+    } else {
+        for (i = 0; i < nbRequetes; i++) {
+            graine = graine * 1103515245u + 12345u;
+            paires[2 * i] = (graine >> 8) % n;
+            graine = graine * 1103515245u + 12345u;
+            paires[2 * i + 1] = (graine >> 8) % n;
+        }
+        printf("\n=== Renumerotation : grille %dx%d (%d noeuds, %d aretes), %d requetes ===\n", cote, cote, n,
+               reseaux[0]->nbAretes, nbRequetes);
+        printf("Hilbert calcule en %.3f s, RCM en %.3f s\n", temps[2], temps[3]);
+        for (h = 0; h <= 1; h++) {
+            double reference = 0.0, cout = 0.0, dureeHasard = 0.0;
+            for (o = 0; o < 4; o++) {
+                double duree = banc_ordre(noms[o], reseaux[o], &ordres[o], paires, nbRequetes, h, &cout);
+                if (o == 0) {
+                    reference = cout;
+                    dureeHasard = duree;
+                    continue;
+                }
+                if (fabs(cout - reference) > 1e-6 * (1.0 + reference))
+                    printf("  ATTENTION : couts differents (%.3f au lieu de %.3f)\n", cout, reference);
+                else if (duree > 0)
+                    printf("  memes couts, x%.2f par rapport au hasard\n", dureeHasard / duree);
+            }
+        }
+    }
+    for (o = 0; o < 4; o++) {
+        numerotation_liberer(&ordres[o]);
+        reseau_liberer(reseaux[o]);
+    }
+    free(paires);
+    if (ville) libererGraphe(ville);
+}
+
+/**
+ * Banc d'essai du rseau compress : mmoire du Graphe, du Reseau et des rseaux compresss
+ * (poids sur 16 et 32 bits), dure des mmes requtes et cart de cot d  la quantification.
+ * Le graphe est une grille de cote x cote, ou la carte donne.
+ */
+void banc_compact(const char* grilleOuCarte, int nbRequetes) {
+    int cote = atoi(grilleOuCarte), i, b, h;
+    Graphe* ville = cote > 0 ? creer_ville_grille(cote) : charger_graphe(grilleOuCarte);
+    if (!ville) return;
+    Reseau* r = reseau_graphe(ville);
+    int n = ville->nbnoeuds, m = ville->nbaretes;
+    unsigned char* drapeaux = (unsigned char*)calloc(m > 0 ? m : 1, 1);
+    ReseauCompact* rc[2] = { NULL, NULL };
+    EspaceRecherche espace;
+    if (!r || !drapeaux || !espace_init(&espace, n)) {
+        printf("Erreur d'allocation memoire !\n");
+        free(drapeaux);
+        libererGraphe(ville);
+        return;
+    }
+    for (i = 0; i < m; i++)
+        drapeaux[i] = (ville->prioritaire[i] ? COMPACT_PRIORITAIRE : 0) | (arete_fermee(&ville->fermetures, i) ? COMPACT_BLOQUEE : 0);
+    double debut = chrono_secondes();
+    rc[0] = reseau_compact_creer(r, drapeaux, 16);
+    double tempsCompression = chrono_secondes() - debut;
+    rc[1] = reseau_compact_creer(r, drapeaux, 32);
+    free(drapeaux);
+    // Mmoire du graphe : colonnes des nuds et des artes (sans noms, feux ni vhicules)
+    double octetsGraphe = (double)n * 4 * sizeof(int) +
+                          (double)m * (2 * sizeof(int) + sizeof(double) + 1 + sizeof(AttributsArete));
+    double octetsReseau = sizeof(int) * (n + 1.0) + (double)r->nbAretes * (2 * sizeof(int) + sizeof(double)) +
+                          2.0 * sizeof(int) * n;
+    printf("\n=== Reseau compresse : %d noeuds, %d aretes ===\n", n, r->nbAretes);
+    printf("Graphe (colonnes)   : %8.2f Mo, %5.1f octets/arete\n", octetsGraphe / 1048576.0, octetsGraphe / (m ? m : 1));
+    printf("Reseau (CSR)        : %8.2f Mo, %5.1f octets/arete\n", octetsReseau / 1048576.0,
+           octetsReseau / (r->nbAretes ? r->nbAretes : 1));
+    for (b = 0; b < 2; b++) {
+        if (!rc[b]) {
+            printf("Compression impossible (%d bits)\n", b ? 32 : 16);
+            continue;
+        }
+        double o = (double)reseau_compact_octets(rc[b]);
+        printf("Compresse, %d bits : %8.2f Mo, %5.1f octets/arete, x%.1f plus petit que le Graphe, x%.1f que le Reseau"
+               " (pas %.3g)\n", rc[b]->bitsPoids, o / 1048576.0,
+               (double)rc[b]->tailleOctets / (r->nbAretes ? r->nbAretes : 1), octetsGraphe / o, octetsReseau / o,
+               rc[b]->pas);
+    }
+    printf("Compression 16 bits en %.3f s\n", tempsCompression);
+    // Mmes requtes sur le Reseau et sur les rseaux compresss (distance pure)
+    for (h = 0; h <= 1 && n > 0; h++) {
+        double duree[3] = { 0 }, ecartMax[3] = { 0 };
+        unsigned int graine = 7;
+        for (i = 0; i < nbRequetes; i++) {
+            graine = graine * 1103515245u + 12345u;
+            int s = (graine >> 8) % n;
+            graine = graine * 1103515245u + 12345u;
+            int c = (graine >> 8) % n;
+            ParametresTemporels prm = { 0 };
+            prm.vitesse = 1.0;
+            prm.heuristique = h;
+            debut = chrono_secondes();
+            Itineraire ref = itineraire_temporel(r, &prm, s, c, 0.0, &espace);
+            duree[0] += chrono_secondes() - debut;
+            for (b = 0; b < 2; b++) {
+                if (!rc[b]) continue;
+                debut = chrono_secondes();
+                Itineraire it = itineraire_compact(rc[b], s, c, 1.0, h, &espace);
+                duree[b + 1] += chrono_secondes() - debut;
+                if (it.longueur > 0 && ref.longueur > 0 && ref.cout > 0) {
+                    double ecart = (it.cout - ref.cout) / ref.cout;
+                    if (ecart > ecartMax[b + 1]) ecartMax[b + 1] = ecart;
+                } else if ((it.longueur > 0) != (ref.longueur > 0)) {
+                    ecartMax[b + 1] = INFINITY; // Accessibilit diffrente : artes bloques
+                }
+                itineraire_liberer(&it);
+            }
+            itineraire_liberer(&ref);
+        }
+        printf("%s, %d requetes : Reseau %.3f s", h ? "A*" : "Dijkstra", nbRequetes, duree[0]);
+        for (b = 0; b < 2; b++)
+            if (rc[b])
+                printf(", %d bits %.3f s (x%.2f, ecart de cout max %.4f %%)", rc[b]->bitsPoids, duree[b + 1],
+                       duree[0] > 0 ? duree[b + 1] / duree[0] : 0.0, 100.0 * ecartMax[b + 1]);
+        printf("\n");
+    }
+    espace_liberer(&espace);
+    reseau_compact_liberer(rc[0]);
+    reseau_compact_liberer(rc[1]);
+    libererGraphe(ville);
+}
+
+/* Lecteur du banc dynamique : une vue par requte, jusqu' l'arrt */
+typedef struct {
+    ReseauDynamique* d;
+    atomic_int* arret;
+    unsigned int graine;
+    long nbRequetes;
+} LecteurDyn;
+
+static void* lecteur_dynamique(void* arg) {
+    LecteurDyn* l = (LecteurDyn*)arg;
+    EspaceRecherche espace;
+    if (!espace_init(&espace, 1)) return NULL; // Agrandi selon chaque vue
+    while (!atomic_load(l->arret)) {
+        VueReseau vue;
+        vue_ouvrir(&vue, l->d);
+        if (espace_agrandir(&espace, vue.nbNoeuds)) {
+            l->graine = l->graine * 1103515245u + 12345u;
+            int s = (l->graine >> 8) % vue.nbNoeuds;
+            l->graine = l->graine * 1103515245u + 12345u;
+            int c = (l->graine >> 8) % vue.nbNoeuds;
+            Itineraire it = itineraire_vue(&vue, s, c, 0.0, 10.0, 1, &espace);
+            itineraire_liberer(&it);
+            l->nbRequetes++;
+        }
+        vue_fermer(&vue);
+    }
+    espace_liberer(&espace);
+    return NULL;
+}
+
+/* Lance nbLecteurs lecteurs pendant 'duree' secondes, pendant lesquelles nbModifications sont appliques */
+static double banc_dynamique_phase(ReseauDynamique* d, int nbLecteurs, double duree, int nbModifications,
+                                   long* requetes, double* dureeModifications) {
+    pthread_t threads[16];
+    LecteurDyn lecteurs[16];
+    atomic_int arret;
+    int i, lances = 0;
+    atomic_init(&arret, 0);
+    for (i = 0; i < nbLecteurs && i < 16; i++) {
+        lecteurs[i] = (LecteurDyn){ d, &arret, 101u + i, 0 };
+        if (pthread_create(&threads[i], NULL, lecteur_dynamique, &lecteurs[i]) == 0) lances++;
+        else break;
+    }
+    double debut = chrono_secondes();
+    unsigned int graine = 77;
+    for (i = 0; i < nbModifications; i++) {
+        // Modifications tales sur toute la phase
+        if (i % 1000 == 0)
+            while (chrono_secondes() - debut < duree * i / nbModifications) usleep(1000);
+        graine = graine * 1103515245u + 12345u;
+        int choix = (graine >> 8) % 10;
+        graine = graine * 1103515245u + 12345u;
+        int hasard = (int)(graine >> 4);
+        if (choix < 4) {
+            // Nouveau carrefour reli dans les deux sens  un carrefour existant
+            int voisin = hasard % d->nbNoeuds;
+            int x = *(int*)colonne_element(&d->X, voisin) + 50, y = *(int*)colonne_element(&d->Y, voisin) + 50;
+            int u = dyn_ajouter_noeud(d, x, y);
+            if (u >= 0) {
+                dyn_ajouter_arete(d, voisin, u, 71.0);
+                dyn_ajouter_arete(d, u, voisin, 71.0);
+            }
+        } else if (choix < 7) {
+            dyn_supprimer_arete(d, hasard % d->nbAretes);
+        } else if (choix < 8) {
+            dyn_supprimer_noeud(d, hasard % d->nbNoeuds);
+        } else if (choix < 9) {
+            dyn_ajouter_feu(d, hasard % d->nbNoeuds, 1, 20 + hasard % 30, 30);
+        } else if (d->nbFeux > 0) {
+            dyn_supprimer_feu(d, hasard % d->nbFeux);
+        }
+    }
+    *dureeModifications = chrono_secondes() - debut;
+    while (chrono_secondes() - debut < duree) usleep(1000);
+    atomic_store(&arret, 1);
+    *requetes = 0;
+    for (i = 0; i < lances; i++) {
+        pthread_join(threads[i], NULL);
+        *requetes += lecteurs[i].nbRequetes;
+    }
+    return chrono_secondes() - debut;
+}
+
+/**
+ * Banc d'essai du rseau dynamique : des lecteurs calculent des itinraires pendant que le
+ * thread principal ajoute et supprime nuds, artes et feux ; la surcouche est fusionne en
+ * arrire-plan. Vrifie ensuite qu'une vue donne les mmes cots avant et aprs la fusion.
+ */
+void banc_dynamique(int cote, int nbModifications, int nbLecteurs) {
+    Graphe* ville = creer_ville_grille(cote);
+    Reseau* r = ville ? reseau_graphe(ville) : NULL;
+    ReseauDynamique* d = r ? reseau_dynamique_creer(1) : NULL;
+    long requetes;
+    double dureeModifications;
+    int i, differences = 0;
+    if (!d || !dyn_charger_reseau(d, r)) {
+        printf("Erreur d'allocation memoire !\n");
+        reseau_dynamique_liberer(d);
+        if (ville) libererGraphe(ville);
+        return;
+    }
+    libererGraphe(ville);
+    printf("\n=== Reseau dynamique : grille %dx%d, %d lecteurs ===\n", cote, cote, nbLecteurs);
+    // 1. Lecteurs seuls
+    double duree = banc_dynamique_phase(d, nbLecteurs, 2.0, 0, &requetes, &dureeModifications);
+    printf("Sans modification  : %.0f requetes/s\n", requetes / duree);
+    // 2. Lecteurs pendant les modifications
+    duree = banc_dynamique_phase(d, nbLecteurs, 2.0, nbModifications, &requetes, &dureeModifications);
+    printf("Avec %d modifications etalees sur %.1f s : %.0f requetes/s, %d fusions\n", nbModifications,
+           dureeModifications, requetes / duree, d->nbFusions);
+    printf("Etat final : %d noeuds, %d aretes, %d feux, %d suppressions\n", d->nbNoeuds, d->nbAretes, d->nbFeux,
+           d->nbSuppressions);
+    // 3. Mme version lue avec la surcouche puis aprs fusion complte
+    EspaceRecherche espace;
+    VueReseau avant, apres;
+    if (espace_init(&espace, d->nbNoeuds)) {
+        vue_ouvrir(&avant, d);
+        dyn_fusionner(d);
+        vue_ouvrir(&apres, d);
+        unsigned int graine = 5;
+        for (i = 0; i < 100; i++) {
+            graine = graine * 1103515245u + 12345u;
+            int s = (graine >> 8) % avant.nbNoeuds;
+            graine = graine * 1103515245u + 12345u;
+            int c = (graine >> 8) % avant.nbNoeuds;
+            Itineraire a = itineraire_vue(&avant, s, c, 0.0, 10.0, 1, &espace);
+            Itineraire b = itineraire_vue(&apres, s, c, 0.0, 10.0, 1, &espace);
+            if (a.longueur != 0 && b.longueur != 0 ? fabs(a.cout - b.cout) > 1e-9 : a.longueur != b.longueur)
+                differences++;
+            itineraire_liberer(&a);
+            itineraire_liberer(&b);
+        }
+        printf("Surcouche / base fusionnee : %d requetes comparees, %d differences\n", i, differences);
+        vue_fermer(&avant);
+        vue_fermer(&apres);
+        espace_liberer(&espace);
+    }
+    reseau_dynamique_liberer(d);
+}
+
+/**
+ * Banc d'essai des fermetures : cot d'une bascule, puis mmes requtes avec 5 % des artes
+ * fermes et 5 % en panne, lues dans les fermetures ou dans un rseau reconstruit sans elles.
+ */
+void banc_fermetures(int cote, int nbRequetes) {
+    Graphe* ville = creer_ville_grille(cote);
+    if (!ville) return;
+    Reseau* r = reseau_graphe(ville);
+    int n = ville->nbnoeuds, m = ville->nbaretes, i, differences = 0;
+    EspaceRecherche espace;
+    if (!r || !espace_init(&espace, n)) {
+        printf("Erreur d'allocation memoire !\n");
+        libererGraphe(ville);
+        return;
+    }
+    // 1. Bascules : un million de fermetures / rouvertures
+    unsigned int graine = 31;
+    int nbBascules = 1000000;
+    double debut = chrono_secondes();
+    for (i = 0; i < nbBascules; i++) {
+        graine = graine * 1103515245u + 12345u;
+        definir_etat_arete(ville, (graine >> 8) % m, i & 1);
+    }
+    double dureeBascules = chrono_secondes() - debut;
+    for (i = 0; i < m; i++) definir_etat_arete(ville, i, 0);
+    // 2. 5 % d'accidents et 5 % de pannes
+    for (i = 0; i < m; i++) {
+        graine = graine * 1103515245u + 12345u;
+        int tirage = (graine >> 8) % 100;
+        if (tirage < 10) definir_etat_arete(ville, i, tirage < 5 ? 1 : 2);
+    }
+    // Rfrence : rseau reconstruit sans les artes fermes, pannes intgres aux distances
+    debut = chrono_secondes();
+    int* source = (int*)malloc(sizeof(int) * m);
+    double* distance = (double*)malloc(sizeof(double) * m);
+    Reseau* reconstruit = NULL;
+    if (source && distance) {
+        for (i = 0; i < m; i++) {
+            source[i] = arete_fermee(&ville->fermetures, i) ? -1 : ville->source[i];
+            distance[i] = fermetures_cout(&ville->fermetures, i, ville->distance[i]);
+        }
+        reconstruit = reseau_creer(n, m, source, ville->destination, distance, ville->X, ville->Y);
+    }
+    double dureeReconstruction = chrono_secondes() - debut;
+    free(source);
+    free(distance);
+    if (!reconstruit) {
+        printf("Erreur d'allocation memoire !\n");
+        espace_liberer(&espace);
+        libererGraphe(ville);
+        return;
+    }
+    ParametresTemporels avec = { 0 }, sans = { 0 };
+    avec.vitesse = sans.vitesse = 1.0;
+    avec.heuristique = sans.heuristique = 1;
+    avec.fermetures = &ville->fermetures;
+    double dureeFermetures = 0.0, dureeReconstruit = 0.0;
+    for (i = 0; i < nbRequetes; i++) {
+        graine = graine * 1103515245u + 12345u;
+        int s = (graine >> 8) % n;
+        graine = graine * 1103515245u + 12345u;
+        int c = (graine >> 8) % n;
+        debut = chrono_secondes();
+        Itineraire a = itineraire_temporel(r, &avec, s, c, 0.0, &espace);
+        dureeFermetures += chrono_secondes() - debut;
+        debut = chrono_secondes();
+        Itineraire b = itineraire_temporel(reconstruit, &sans, s, c, 0.0, &espace);
+        dureeReconstruit += chrono_secondes() - debut;
+        if (a.longueur != b.longueur || fabs(a.cout - b.cout) > 1e-9 * (1.0 + b.cout))
+            differences++;
+        itineraire_liberer(&a);
+        itineraire_liberer(&b);
+    }
+    printf("\n=== Fermetures : grille %dx%d, %d aretes ===\n", cote, cote, m);
+    printf("%d bascules en %.3f s (%.1f ns par bascule)\n", nbBascules, dureeBascules, 1e9 * dureeBascules / nbBascules);
+    printf("%d fermees, %d en panne ; reconstruction du reseau equivalente : %.3f s\n",
+           atomic_load(&ville->fermetures.nbFermees), atomic_load(&ville->fermetures.nbPenalisees), dureeReconstruction);
+    printf("%d requetes A* : fermetures %.3f s, reseau reconstruit %.3f s, %d differences\n", nbRequetes,
+           dureeFermetures, dureeReconstruit, differences);
+    reseau_liberer(reconstruit);
+    espace_liberer(&espace);
+    libererGraphe(ville);
+}
+
+/* ========================================================================= */
+/*                   ROUTAGE MULTINIVEAU (mtrique personnalisable)          */
+/* ========================================================================= */
+
+/* Cot courant d'une arte : distance, embouteillage, rduction prioritaire, fermeture ou panne */
+double metrique_arete(const Graphe* graph, int e, double facteurPrioritaire) {
+    double cout = graph->distance[e];
+    if (graph->attributs[e].embouteillage) cout *= FACTEUR_EMBOUTEILLAGE;
+    if (graph->prioritaire[e]) cout *= facteurPrioritaire;
+    return fermetures_cout(&graph->fermetures, e, cout);
+}
+
+void graphe_metrique(const Graphe* graph, double* metrique, double facteurPrioritaire) {
+    int e;
+    for (e = 0; e < graph->nbaretes; e++)
+        metrique[e] = metrique_arete(graph, e, facteurPrioritaire);
+}
+
+/* Nombre de bits des feuilles : cellules de niveau 0 d'environ CRP_TAILLE_CELLULE nuds */
+int crp_bits_feuilles(int nbNoeuds) {
+    int bits = 0;
+    while ((nbNoeuds >> bits) > CRP_TAILLE_CELLULE) bits++;
+    return bits;
+}
+
+/* Cellules embotes par partition multiniveau : feuilles d'environ CRP_TAILLE_CELLULE nuds.
+   Le niveau le plus haut garde au moins 8 cellules : au-dessus, les cliques cotent plus 
+   personnaliser qu'elles ne font gagner aux requtes. */
+RoutageCRP* crp_graphe(Graphe* graph, int nbThreads) {
+    Reseau* r = reseau_graphe(graph);
+    if (!r) return NULL;
+    int bits = crp_bits_feuilles(r->nbNoeuds);
+    int* feuille = partition_emboitee(r, bits, CRP_BITS_NIVEAU, PARTITION_TOLERANCE, nbThreads);
+    if (!feuille) return NULL;
+    int nbNiveaux = bits > 3 ? (bits - 3) / CRP_BITS_NIVEAU + 1 : 1;
+    RoutageCRP* crp = crp_creer(r, feuille, CRP_BITS_NIVEAU, nbNiveaux);
+    free(feuille);
+    return crp;
+}
+
+/**
+ * Banc d'essai du routage multiniveau : prparation, personnalisation complte, requtes compares
+ *  Dijkstra, puis minutes simules o l'embouteillage change dans un quartier (1 % des artes) et
+ * un accident ferme une rue, avant une personnalisation partielle.
+ */
+void banc_crp(int cote, int nbRequetes, int nbThreads) {
+    Graphe* ville = creer_ville_grille(cote);
+    if (!ville) return;
+    Reseau* r = reseau_graphe(ville);
+    int n = ville->nbnoeuds, m = ville->nbaretes, i, minute;
+    double* metrique = (double*)malloc(sizeof(double) * (m > 0 ? m : 1));
+    int* modifiees = (int*)malloc(sizeof(int) * (m > 0 ? m : 1));
+    EspaceRecherche espace;
+    if (!r || !metrique || !modifiees || !espace_init(&espace, n)) {
+        printf("Erreur d'allocation memoire !\n");
+        free(metrique);
+        free(modifiees);
+        libererGraphe(ville);
+        return;
+    }
+    double debut = chrono_secondes();
+    RoutageCRP* crp = crp_graphe(ville, nbThreads);
+    double dureePreparation = chrono_secondes() - debut;
+    if (!crp) {
+        printf("Erreur d'allocation memoire !\n");
+        free(metrique);
+        free(modifiees);
+        espace_liberer(&espace);
+        libererGraphe(ville);
+        return;
+    }
+    printf("\n=== Routage multiniveau : grille %dx%d, %d aretes, %d niveaux, %d cellules de niveau 0 ===\n", cote, cote,
+           m, crp->nbNiveaux, crp->niveaux[0].nbCellules);
+    printf("Preparation : %.3f s, cliques %.1f Mo\n", dureePreparation, crp_octets_cliques(crp) / 1048576.0);
+    graphe_metrique(ville, metrique, 0.5);
+    debut = chrono_secondes();
+    int nbCellules = crp_personnaliser(crp, metrique, nbThreads);
+    printf("Personnalisation complete (%d threads) : %d cellules en %.3f s\n", nbThreads, nbCellules,
+           chrono_secondes() - debut);
+    unsigned int graine = 11;
+    double dureePartielle = 0.0, dureeCRP = 0.0, dureeDijkstra = 0.0;
+    long cellulesPartielles = 0;
+    int differences = 0, nbMinutes = 10;
+    ParametresTemporels prm = { 0 };
+    prm.vitesse = 1.0;
+    for (minute = 0; minute <= nbMinutes; minute++) {
+        if (minute > 0) {
+            // La congestion change dans un quartier d'un dixime de ct, et une rue est ferme
+            graine = graine * 1103515245u + 12345u;
+            int centre = (graine >> 8) % n, demiCote = cote * 5, nb = 0;
+            for (i = 0; i < m; i++) {
+                int u = ville->source[i];
+                if (abs(ville->X[u] - ville->X[centre]) > demiCote || abs(ville->Y[u] - ville->Y[centre]) > demiCote)
+                    continue;
+                ville->attributs[i].embouteillage = !ville->attributs[i].embouteillage;
+                modifiees[nb++] = i;
+            }
+            graine = graine * 1103515245u + 12345u;
+            modifiees[nb] = (graine >> 8) % m;
+            definir_etat_arete(ville, modifiees[nb++], 1);
+            for (i = 0; i < nb; i++)
+                metrique[modifiees[i]] = metrique_arete(ville, modifiees[i], 0.5);
+            debut = chrono_secondes();
+            cellulesPartielles += crp_personnaliser_aretes(crp, metrique, modifiees, nb, nbThreads);
+            dureePartielle += chrono_secondes() - debut;
+        }
+        // Rfrence : Dijkstra sur un rseau pondr par la mtrique courante
+        Reseau* reference = reseau_creer(n, m, ville->source, ville->destination, metrique, ville->X, ville->Y);
+        if (!reference) break;
+        for (i = 0; i < nbRequetes; i++) {
+            graine = graine * 1103515245u + 12345u;
+            int s = (graine >> 8) % n;
+            graine = graine * 1103515245u + 12345u;
+            int c = (graine >> 8) % n;
+            debut = chrono_secondes();
+            Itineraire a = crp_itineraire(crp, s, c, &espace);
+            dureeCRP += chrono_secondes() - debut;
+            debut = chrono_secondes();
+            Itineraire b = itineraire_temporel(reference, &prm, s, c, 0.0, &espace);
+            dureeDijkstra += chrono_secondes() - debut;
+            // Mme cot, et le chemin dpli doit coter ce qui est annonc
+            double cout = 0.0;
+            int j, k;
+            for (j = 1; j < a.longueur; j++) {
+                double meilleur = INFINITY;
+                for (k = r->debut[a.noeuds[j - 1]]; k < r->debut[a.noeuds[j - 1] + 1]; k++)
+                    if (r->cible[k] == a.noeuds[j] && metrique[r->idArete[k]] < meilleur) meilleur = metrique[r->idArete[k]];
+                cout += meilleur;
+            }
+            if ((a.longueur > 0) != (b.longueur > 0) || fabs(a.cout - b.cout) > 1e-9 * (1.0 + b.cout) ||
+                fabs(cout - a.cout) > 1e-9 * (1.0 + a.cout))
+                differences++;
+            itineraire_liberer(&a);
+            itineraire_liberer(&b);
+        }
+        reseau_liberer(reference);
+    }
+    int total = nbRequetes * (nbMinutes + 1);
+    printf("Personnalisation partielle (quartier et accident) : %.1f cellules, %.4f s par minute simulee\n",
+           (double)cellulesPartielles / nbMinutes, dureePartielle / nbMinutes);
+    printf("%d requetes : multiniveau %.3f ms, Dijkstra %.3f ms par requete (x%.1f), %d differences\n", total,
+           1000.0 * dureeCRP / total, 1000.0 * dureeDijkstra / total, dureeCRP > 0 ? dureeDijkstra / dureeCRP : 0.0,
+           differences);
+    crp_liberer(crp);
+    free(metrique);
+    free(modifiees);
+    espace_liberer(&espace);
+    libererGraphe(ville);
+}
+
+/**
+ * Banc d'essai de la partition : coupe, dsquilibre et dure de la partition multiniveau selon le
+ * nombre de threads, compares  la bissection des coordonnes, en k parties puis en cellules
+ * embotes pour le routage multiniveau. La partition ne doit pas dpendre du nombre de threads.
+ */
+void banc_partition(const char* grilleOuCarte, int nbParties, int nbThreads) {
+    int cote = atoi(grilleOuCarte), t, u;
+    Graphe* ville = cote > 0 ? creer_ville_grille(cote) : charger_graphe(grilleOuCarte);
+    if (!ville) return;
+    Reseau* r = reseau_graphe(ville);
+    if (!r || nbParties < 1) {
+        printf("Erreur d'allocation memoire !\n");
+        libererGraphe(ville);
+        return;
+    }
+    StatsPartition stats;
+    printf("\n=== Partition : %d noeuds, %d arcs, %d parties (tolerance %.0f %%) ===\n", r->nbNoeuds, r->nbAretes,
+           nbParties, 100.0 * PARTITION_TOLERANCE);
+    printf("Methode                   | Temps (s) | Arcs coupes | Desequilibre | Resultat\n");
+    double debut = chrono_secondes();
+    int* coordonnees = partition_coordonnees(r, nbParties);
+    double duree = chrono_secondes() - debut;
+    if (coordonnees) {
+        partition_evaluer(r, coordonnees, nbParties, &stats);
+        printf("Bissection coordonnees    | %9.3f | %11ld | %10.1f %% |\n", duree, stats.coupe, 100.0 * stats.desequilibre);
+    }
+    free(coordonnees);
+    int* reference = NULL;
+    for (t = 1; t <= nbThreads; t = (t < nbThreads && 2 * t > nbThreads) ? nbThreads : 2 * t) {
+        debut = chrono_secondes();
+        int* partie = partition_multiniveau(r, nbParties, PARTITION_TOLERANCE, t, &stats);
+        duree = chrono_secondes() - debut;
+        if (!partie) {
+            printf("Erreur d'allocation memoire !\n");
+            break;
+        }
+        int identique = 1;
+        for (u = 0; reference && u < r->nbNoeuds; u++)
+            if (partie[u] != reference[u]) identique = 0;
+        printf("Multiniveau, %2d thread%s  | %9.3f | %11ld | %10.1f %% | %s (%d niveaux)\n", t, t > 1 ? "s" : " ",
+               duree, stats.coupe, 100.0 * stats.desequilibre, identique ? "identique" : "DIFFERENT", stats.nbNiveaux);
+        if (reference) free(partie);
+        else reference = partie;
+    }
+    free(reference);
+    // Cellules embotes du routage multiniveau
+    int bits = crp_bits_feuilles(r->nbNoeuds);
+    printf("Cellules emboitees, %d feuilles :\n", 1 << bits);
+    debut = chrono_secondes();
+    int* feuilles = partition_coordonnees(r, 1 << bits);
+    duree = chrono_secondes() - debut;
+    if (feuilles) {
+        partition_evaluer(r, feuilles, 1 << bits, &stats);
+        printf("Bissection coordonnees    | %9.3f | %11ld | %10.1f %% |\n", duree, stats.coupe, 100.0 * stats.desequilibre);
+    }
+    free(feuilles);
+    debut = chrono_secondes();
+    feuilles = partition_emboitee(r, bits, CRP_BITS_NIVEAU, PARTITION_TOLERANCE, nbThreads);
+    duree = chrono_secondes() - debut;
+    if (feuilles) {
+        partition_evaluer(r, feuilles, 1 << bits, &stats);
+        printf("Multiniveau, %2d thread%s  | %9.3f | %11ld | %10.1f %% |\n", nbThreads, nbThreads > 1 ? "s" : " ", duree,
+               stats.coupe, 100.0 * stats.desequilibre);
+    }
+    free(feuilles);
+    libererGraphe(ville);
+}
+
+/**
+ * Banc d'essai des virages : la recherche sur les artes, virages gratuits, doit retrouver les cots
+ * de la recherche sur les nuds ; puis, virages payants et un virage  gauche sur dix interdit, on
+ * compare sa dure  celle de la recherche sur les nuds et le temps rel des deux itinraires.
+ */
+void banc_virages(int cote, int nbRequetes) {
+    Graphe* ville = creer_ville_grille(cote);
+    if (!ville) return;
+    Reseau* r = reseau_graphe(ville);
+    int n = ville->nbnoeuds, i, k, j;
+    EspaceRecherche espaceNoeuds;
+    EspaceVirages espaceAretes;
+    if (!r || !espace_init(&espaceNoeuds, n)) {
+        printf("Erreur d'allocation memoire !\n");
+        libererGraphe(ville);
+        return;
+    }
+    if (!espace_virages_init(&espaceAretes, n, r->nbAretes)) {
+        printf("Erreur d'allocation memoire !\n");
+        espace_liberer(&espaceNoeuds);
+        libererGraphe(ville);
+        return;
+    }
+    ParametresTemporels prm = { 0 };
+    prm.vitesse = 10.0;
+    prm.indexFeux = index_feux(ville);
+    prm.feux = ville->F;
+    // Un carrefour sur dix interdit ses virages  gauche
+    unsigned int graine = 99;
+    int interdits = 0;
+    for (i = 0; i < ville->nbaretes; i++) {
+        int a = ville->source[i], v = ville->destination[i];
+        if ((((unsigned int)v * 2654435761u) >> 16) % 10 != 0) continue;
+        for (k = r->debut[v]; k < r->debut[v + 1]; k++)
+            if (virage_classe(&ville->virages, r, a, v, r->cible[k]) == VIRAGE_GAUCHE)
+                interdits += virages_interdire(&ville->virages, v, i, r->idArete[k]);
+    }
+    const Virages* virages = virages_graphe(ville);
+    printf("\n=== Virages : grille %dx%d, %d aretes, %d feux, %d virages a gauche interdits ===\n", cote, cote,
+           ville->nbaretes, ville->nbFeux, interdits);
+    printf("Couts : droite %.0f s, gauche %.0f s (+%.0f s aux feux), demi-tour %.0f s\n", COUT_VIRAGE_DROITE,
+           COUT_VIRAGE_GAUCHE, SUPPLEMENT_GAUCHE_FEU, COUT_DEMI_TOUR);
+    // Mmes recherches guides vers la cible (A*), compares entre elles : les longueurs de la grille
+    // bornent la distance euclidienne
+    ParametresTemporels prmGuide = prm;
+    prmGuide.heuristique = 1;
+    double dureeNoeuds = 0.0, dureeGratuits = 0.0, dureeVirages = 0.0, dureeNoeudsGuidee = 0.0, dureeGuidee = 0.0,
+           tempsNoeuds = 0.0, tempsVirages = 0.0;
+    int differences = 0, invalides = 0, ecarts = 0, impossibles = 0, trouves = 0;
+    for (i = 0; i < nbRequetes; i++) {
+        graine = graine * 1103515245u + 12345u;
+        int s = (graine >> 8) % n;
+        graine = graine * 1103515245u + 12345u;
+        int c = (graine >> 8) % n;
+        double debut = chrono_secondes();
+        Itineraire a = itineraire_temporel(r, &prm, s, c, 0.0, &espaceNoeuds);
+        dureeNoeuds += chrono_secondes() - debut;
+        debut = chrono_secondes();
+        Itineraire b = itineraire_virages(r, &prm, NULL, s, c, 0.0, &espaceAretes);
+        dureeGratuits += chrono_secondes() - debut;
+        debut = chrono_secondes();
+        Itineraire t = itineraire_virages(r, &prm, virages, s, c, 0.0, &espaceAretes);
+        dureeVirages += chrono_secondes() - debut;
+        debut = chrono_secondes();
+        Itineraire h = itineraire_temporel(r, &prmGuide, s, c, 0.0, &espaceNoeuds);
+        dureeNoeudsGuidee += chrono_secondes() - debut;
+        debut = chrono_secondes();
+        Itineraire g = itineraire_virages(r, &prmGuide, virages, s, c, 0.0, &espaceAretes);
+        dureeGuidee += chrono_secondes() - debut;
+        if ((h.longueur > 0) != (a.longueur > 0) || fabs(h.cout - a.cout) > 1e-9 * (1.0 + a.cout)) ecarts++;
+        if ((g.longueur > 0) != (t.longueur > 0) || fabs(g.cout - t.cout) > 1e-9 * (1.0 + t.cout)) ecarts++;
+        itineraire_liberer(&h);
+        itineraire_liberer(&g);
+        // Virages gratuits : mmes cots ; virages payants : le chemin rendu doit coter ce qui est annonc
+        if ((a.longueur > 0) != (b.longueur > 0) || fabs(a.cout - b.cout) > 1e-9 * (1.0 + a.cout)) differences++;
+        if (t.longueur > 0 && fabs(itineraire_duree_virages(r, &prm, virages, &t, 0.0) - t.cout) > 1e-9 * (1.0 + t.cout))
+            invalides++;
+        // Temps rel de l'itinraire calcul sans les virages
+        double reel = a.longueur > 0 ? itineraire_duree_virages(r, &prm, virages, &a, 0.0) : INFINITY;
+        if (reel == INFINITY && a.longueur > 0) impossibles++;
+        else if (t.longueur > 0) {
+            tempsNoeuds += reel;
+            tempsVirages += t.cout;
+            trouves++;
+        }
+        for (j = 0; j < 3; j++) itineraire_liberer(j == 0 ? &a : j == 1 ? &b : &t);
+    }
+    printf("Recherche sur les noeuds                 : %.3f ms par requete\n", 1000.0 * dureeNoeuds / nbRequetes);
+    printf("Recherche sur les aretes, virages gratuits : %.3f ms (x%.2f), %d differences\n",
+           1000.0 * dureeGratuits / nbRequetes, dureeNoeuds > 0 ? dureeGratuits / dureeNoeuds : 0.0, differences);
+    printf("Recherche sur les aretes, virages payants  : %.3f ms (x%.2f), %d chemins mal chiffres\n",
+           1000.0 * dureeVirages / nbRequetes, dureeNoeuds > 0 ? dureeVirages / dureeNoeuds : 0.0, invalides);
+    printf("Guidees vers la cible (A*) : noeuds %.3f ms, aretes avec virages payants %.3f ms (x%.2f),"
+           " %d ecarts de cout\n", 1000.0 * dureeNoeudsGuidee / nbRequetes, 1000.0 * dureeGuidee / nbRequetes,
+           dureeNoeudsGuidee > 0 ? dureeGuidee / dureeNoeudsGuidee : 0.0, ecarts);
+    printf("Itineraires sans les virages : %d passent par un virage interdit ; les autres durent en moyenne"
+           " %.1f s, contre %.1f s en comptant les virages\n", impossibles,
+           trouves ? tempsNoeuds / trouves : 0.0, trouves ? tempsVirages / trouves : 0.0);
+    espace_liberer(&espaceNoeuds);
+    espace_virages_liberer(&espaceAretes);
+    libererGraphe(ville);
+}
+
+/* Oracle des alternatives par routage multiniveau : les pnalits changent quelques artes, dont
+   seules les cellules sont personnalises  nouveau */
+typedef struct {
+    RoutageCRP* crp;
+    const double* base;      // Mtrique sans pnalit
+    double* metrique;        // Mtrique pnalise, personnalise dans crp
+    EspaceRecherche* espace;
+    int nbThreads;
+    double dureePersonnalisation;
+} OracleCRP;
+
+static Itineraire oracle_crp(void* contexte, const double* penalite, const int* modifiees, int nbModifiees,
+                             int source, int cible) {
+    OracleCRP* o = (OracleCRP*)contexte;
+    int i;
+    if (nbModifiees > 0) {
+        for (i = 0; i < nbModifiees; i++) o->metrique[modifiees[i]] = o->base[modifiees[i]] * penalite[modifiees[i]];
+        double debut = chrono_secondes();
+        crp_personnaliser_aretes(o->crp, o->metrique, modifiees, nbModifiees, o->nbThreads);
+        o->dureePersonnalisation += chrono_secondes() - debut;
+    }
+    return crp_itineraire(o->crp, source, cible, o->espace);
+}
+
+/* Cot d'un itinraire pour la mtrique sans pnalit (entre deux nuds, l'arte la moins chre) */
+static double cout_crp(void* contexte, const Itineraire* it) {
+    OracleCRP* o = (OracleCRP*)contexte;
+    const Reseau* r = o->crp->reseau;
+    double cout = 0.0;
+    int j, k;
+    for (j = 1; j < it->longueur; j++) {
+        double meilleur = INFINITY;
+        for (k = r->debut[it->noeuds[j - 1]]; k < r->debut[it->noeuds[j - 1] + 1]; k++)
+            if (r->cible[k] == it->noeuds[j] && o->base[r->idArete[k]] < meilleur) meilleur = o->base[r->idArete[k]];
+        cout += meilleur;
+    }
+    return cout;
+}
+
+/**
+ * Banc d'essai des itinraires multiples : k plus courts chemins (Yen) compars  Dijkstra, puis
+ * NB_ALTERNATIVES alternatives sur la mtrique du rseau (A* sur l'arbre inverse, ou routage
+ * multiniveau comme oracle) et avec virages et feux, telles que les calcule l'interface.
+ */
+void banc_alternatives(const char* grilleOuCarte, int nbRequetes, int nbThreads) {
+    int cote = atoi(grilleOuCarte), i, j;
+    Graphe* ville = cote > 0 ? creer_ville_grille(cote) : charger_graphe(grilleOuCarte);
+    if (!ville) return;
+    Reseau* r = reseau_graphe(ville);
+    int n = ville->nbnoeuds, m = ville->nbaretes;
+    double* metrique = (double*)malloc(sizeof(double) * (m > 0 ? m : 1));
+    double* penalisee = (double*)malloc(sizeof(double) * (m > 0 ? m : 1));
+    Itineraire* it = (Itineraire*)malloc(sizeof(Itineraire) * 10);
+    EspaceRecherche espace;
+    EspaceVirages espaceVirages;
+    EspaceAlternatives alt;
+    if (!r || !metrique || !penalisee || !it || nbRequetes < 1 || !espace_init(&espace, n)) {
+        printf("Erreur d'allocation memoire !\n");
+        free(metrique);
+        free(penalisee);
+        free(it);
+        libererGraphe(ville);
+        return;
+    }
+    if (!espace_virages_init(&espaceVirages, n, r->nbAretes) || !espace_alternatives_init(&alt, r)) {
+        printf("Erreur d'allocation memoire !\n");
+        espace_virages_liberer(&espaceVirages);
+        espace_liberer(&espace);
+        free(metrique);
+        free(penalisee);
+        free(it);
+        libererGraphe(ville);
+        return;
+    }
+    graphe_metrique(ville, metrique, 1.0);
+    memcpy(penalisee, metrique, sizeof(double) * m);
+    Reseau* reference = reseau_creer(n, m, ville->source, ville->destination, metrique, ville->X, ville->Y);
+    RoutageCRP* crp = crp_graphe(ville, nbThreads);
+    if (!reference || !crp || !crp_personnaliser(crp, metrique, nbThreads)) {
+        printf("Erreur d'allocation memoire !\n");
+        reseau_liberer(reference);
+        crp_liberer(crp);
+        espace_alternatives_liberer(&alt);
+        espace_virages_liberer(&espaceVirages);
+        espace_liberer(&espace);
+        free(metrique);
+        free(penalisee);
+        free(it);
+        libererGraphe(ville);
+        return;
+    }
+    printf("\n=== Itineraires multiples : %s, %d noeuds, %d aretes, %d requetes ===\n",
+           cote > 0 ? "grille" : grilleOuCarte, n, m, nbRequetes);
+    ParametresTemporels prm = { 0 };
+    prm.vitesse = 1.0;
+    ParametresTemporels prmVirages = { 0 };
+    prmVirages.vitesse = 10.0;
+    prmVirages.indexFeux = index_feux(ville);
+    prmVirages.feux = ville->F;
+    const Virages* virages = virages_graphe(ville);
+    ParametresAlternatives pa = alternatives_parametres(NB_ALTERNATIVES);
+    OracleCRP oracle = { crp, metrique, penalisee, &espace, nbThreads, 0.0 };
+    double dureeDijkstra = 0.0, dureeYen3 = 0.0, dureeYen10 = 0.0, dureeAlt = 0.0, dureeCRP = 0.0, dureeVirages = 0.0;
+    double etirement = 0.0;
+    long nbAlt = 0, nbEtires = 0, nbCRP = 0, nbVirages = 0;
+    int differences = 0, desordres = 0;
+    unsigned int graine = 5;
+    for (i = 0; i < nbRequetes; i++) {
+        graine = graine * 1103515245u + 12345u;
+        int s = (graine >> 8) % n;
+        graine = graine * 1103515245u + 12345u;
+        int c = (graine >> 8) % n;
+        double debut = chrono_secondes();
+        Itineraire d = itineraire_temporel(reference, &prm, s, c, 0.0, &espace);
+        dureeDijkstra += chrono_secondes() - debut;
+        debut = chrono_secondes();
+        int k = yen_k_plus_courts(r, metrique, NULL, s, c, 3, it, &alt);
+        dureeYen3 += chrono_secondes() - debut;
+        for (j = 0; j < k; j++) itineraire_liberer(&it[j]);
+        debut = chrono_secondes();
+        k = yen_k_plus_courts(r, metrique, NULL, s, c, 10, it, &alt);
+        dureeYen10 += chrono_secondes() - debut;
+        // Le premier est le plus court, les suivants par cot croissant
+        if ((k > 0) != (d.longueur > 0) || (k > 0 && fabs(it[0].cout - d.cout) > 1e-9 * (1.0 + d.cout))) differences++;
+        for (j = 1; j < k; j++)
+            if (it[j].cout < it[j - 1].cout - 1e-9 * (1.0 + it[j].cout)) desordres++;
+        for (j = 0; j < k; j++) itineraire_liberer(&it[j]);
+        itineraire_liberer(&d);
+        debut = chrono_secondes();
+        k = alternatives_metrique(r, metrique, NULL, &pa, s, c, it, &alt);
+        dureeAlt += chrono_secondes() - debut;
+        nbAlt += k;
+        for (j = 1; j < k; j++, nbEtires++) etirement += it[j].cout / it[0].cout;
+        for (j = 0; j < k; j++) itineraire_liberer(&it[j]);
+        debut = chrono_secondes();
+        k = alternatives_itineraires(r, &pa, oracle_crp, cout_crp, &oracle, s, c, it, &alt);
+        dureeCRP += chrono_secondes() - debut;
+        nbCRP += k;
+        for (j = 0; j < k; j++) itineraire_liberer(&it[j]);
+        debut = chrono_secondes();
+        k = alternatives_virages(r, &prmVirages, virages, &pa, s, c, 0.0, it, &alt, &espaceVirages);
+        dureeVirages += chrono_secondes() - debut;
+        nbVirages += k;
+        for (j = 0; j < k; j++) itineraire_liberer(&it[j]);
+    }
+    printf("Dijkstra                         : %.3f ms par requete\n", 1000.0 * dureeDijkstra / nbRequetes);
+    printf("Yen, 3 chemins                   : %.3f ms\n", 1000.0 * dureeYen3 / nbRequetes);
+    printf("Yen, 10 chemins                  : %.3f ms, %d differences avec Dijkstra, %d hors d'ordre\n",
+           1000.0 * dureeYen10 / nbRequetes, differences, desordres);
+    printf("%d alternatives (A* sur l'arbre)  : %.3f ms, %.2f itineraires, etirement moyen %.3f\n", NB_ALTERNATIVES,
+           1000.0 * dureeAlt / nbRequetes, (double)nbAlt / nbRequetes,
+           nbEtires ? etirement / nbEtires : 0.0);
+    printf("%d alternatives (multiniveau)     : %.3f ms dont %.3f ms de personnalisation, %.2f itineraires\n",
+           NB_ALTERNATIVES, 1000.0 * dureeCRP / nbRequetes, 1000.0 * oracle.dureePersonnalisation / nbRequetes,
+           (double)nbCRP / nbRequetes);
+    printf("%d alternatives (virages et feux) : %.3f ms, %.2f itineraires\n", NB_ALTERNATIVES,
+           1000.0 * dureeVirages / nbRequetes, (double)nbVirages / nbRequetes);
+    reseau_liberer(reference);
+    crp_liberer(crp);
+    espace_alternatives_liberer(&alt);
+    espace_virages_liberer(&espaceVirages);
+    espace_liberer(&espace);
+    free(metrique);
+    free(penalisee);
+    free(it);
+    libererGraphe(ville);
+}
+
+/**
+ * Banc d'essai des isochrones : zones accessibles en 'duree' secondes depuis nbSources sources
+ * tires au hasard, calcules en lot avec 1  maxThreads threads. Les rsultats ne doivent pas
+ * dpendre du nombre de threads, et la zone de la premire source est vrifie par des
+ * itinraires vers des nuds tirs au hasard.
+ */
+void banc_isochrones(const char* grilleOuCarte, int nbSources, double duree, int maxThreads) {
+    int cote = atoi(grilleOuCarte), i, j, k;
+    Graphe* ville = cote > 0 ? creer_ville_grille(cote) : charger_graphe(grilleOuCarte);
+    if (!ville) return;
+    Reseau* r = reseau_graphe(ville);
+    int n = ville->nbnoeuds;
+    int* sources = (int*)malloc(sizeof(int) * (nbSources > 0 ? nbSources : 1));
+    Isochrone* reference = (Isochrone*)calloc(nbSources > 0 ? nbSources : 1, sizeof(Isochrone));
+    Isochrone* lot = (Isochrone*)calloc(nbSources > 0 ? nbSources : 1, sizeof(Isochrone));
+    double* temps = (double*)malloc(sizeof(double) * (n > 0 ? n : 1));
+    EspaceRecherche espace;
+    if (!r || !sources || !reference || !lot || !temps || nbSources < 1 || !espace_init(&espace, n)) {
+        printf("Erreur d'allocation memoire !\n");
+        free(sources);
+        free(reference);
+        free(lot);
+        free(temps);
+        libererGraphe(ville);
+        return;
+    }
+    ParametresTemporels prm = { 0 };
+    prm.vitesse = 10.0;
+    prm.indexFeux = index_feux(ville); // Index construit avant le lancement des threads
+    prm.feux = ville->F;
+    prm.fermetures = &ville->fermetures;
+    unsigned int graine = 17;
+    for (i = 0; i < nbSources; i++) {
+        graine = graine * 1103515245u + 12345u;
+        sources[i] = (graine >> 8) % n;
+    }
+    printf("\n=== Isochrones : %s, %d noeuds, %d sources, %.0f s ===\n", cote > 0 ? "grille" : grilleOuCarte, n,
+           nbSources, duree);
+    printf("Threads | Temps (s) | Isochrones/s | Gain     | Resultat\n");
+    double tempsReference = 0.0;
+    long atteints = 0;
+    for (k = 1; k <= maxThreads; k++) {
+        Isochrone* resultats = k == 1 ? reference : lot;
+        double debut = chrono_secondes();
+        int ok = isochrones_lot(r, &prm, sources, nbSources, 0.0, duree, k, resultats);
+        double t = chrono_secondes() - debut;
+        if (!ok) {
+            printf("Erreur d'allocation memoire !\n");
+            break;
+        }
+        int identique = 1;
+        for (i = 0; i < nbSources && k > 1; i++)
+            if (lot[i].nb != reference[i].nb || memcmp(lot[i].noeuds, reference[i].noeuds, sizeof(int) * lot[i].nb) ||
+                memcmp(lot[i].temps, reference[i].temps, sizeof(double) * lot[i].nb))
+                identique = 0;
+        if (k == 1) {
+            tempsReference = t;
+            for (i = 0; i < nbSources; i++) atteints += reference[i].nb;
+        }
+        printf("%7d | %9.3f | %12.0f | x%-7.2f | %s\n", k, t, t > 0 ? nbSources / t : 0.0,
+               t > 0 ? tempsReference / t : 0.0, identique ? "identique" : "DIFFERENT");
+    }
+    // Zone de la premire source : un nud y est si et seulement si l'itinraire y arrive  temps
+    for (i = 0; i < n; i++) temps[i] = INFINITY;
+    for (i = 0; i < reference[0].nb; i++) temps[reference[0].noeuds[i]] = reference[0].temps[i];
+    int erreurs = 0;
+    for (j = 0; j < 100; j++) {
+        graine = graine * 1103515245u + 12345u;
+        // Un nud sur deux pris dans la zone, pour vrifier aussi les dures
+        int v = (j % 2) ? reference[0].noeuds[(graine >> 8) % reference[0].nb] : (int)((graine >> 8) % n);
+        Itineraire it = itineraire_temporel(r, &prm, sources[0], v, 0.0, &espace);
+        double attendu = it.longueur > 0 && it.cout <= duree ? it.cout : INFINITY;
+        if ((attendu == INFINITY) != (temps[v] == INFINITY) ||
+            (attendu < INFINITY && fabs(attendu - temps[v]) > 1e-9 * (1.0 + attendu)))
+            erreurs++;
+        itineraire_liberer(&it);
+    }
+    printf("%.1f noeuds atteints par source ; %d erreurs sur 100 noeuds verifies\n", (double)atteints / nbSources,
+           erreurs);
+    for (i = 0; i < nbSources; i++) {
+        isochrone_liberer(&reference[i]);
+        isochrone_liberer(&lot[i]);
+    }
+    free(sources);
+    free(reference);
+    free(lot);
+    free(temps);
+    espace_liberer(&espace);
+    libererGraphe(ville);
+}
+
+/**
+ * Banc d'essai des requtes en lot : nbRequetes itinraires pour trois profils (voiture sans
+ * virages, bus et camion avec virages), d'abord un par un sur le thread appelant, puis par le
+ * pool de 1  maxThreads threads. Les rsultats doivent tre ceux du calcul un par un.
+ */
+void banc_lots(const char* grilleOuCarte, int nbRequetes, int maxThreads) {
+    int cote = atoi(grilleOuCarte), i, k;
+    Graphe* ville = cote > 0 ? creer_ville_grille(cote) : charger_graphe(grilleOuCarte);
+    if (!ville) return;
+    Reseau* r = reseau_graphe(ville);
+    int n = ville->nbnoeuds;
+    Requete* requetes = (Requete*)malloc(sizeof(Requete) * (nbRequetes > 0 ? nbRequetes : 1));
+    Itineraire* reference = (Itineraire*)calloc(nbRequetes > 0 ? nbRequetes : 1, sizeof(Itineraire));
+    Itineraire* resultats = (Itineraire*)calloc(nbRequetes > 0 ? nbRequetes : 1, sizeof(Itineraire));
+    EspaceRecherche espace;
+    EspaceVirages espaceVirages;
+    if (!r || !requetes || !reference || !resultats || nbRequetes < 1 || !espace_init(&espace, n)) {
+        printf("Erreur d'allocation memoire !\n");
+        free(requetes);
+        free(reference);
+        free(resultats);
+        libererGraphe(ville);
+        return;
+    }
+    if (!espace_virages_init(&espaceVirages, n, r->nbAretes)) {
+        printf("Erreur d'allocation memoire !\n");
+        espace_liberer(&espace);
+        free(requetes);
+        free(reference);
+        free(resultats);
+        libererGraphe(ville);
+        return;
+    }
+    // Index des feux et tables de virages prts avant le lancement des threads
+    ProfilRequete profils[3];
+    static const double vitesses[3] = { 15.0, 10.0, 8.0 };
+    for (k = 0; k < 3; k++) {
+        memset(&profils[k], 0, sizeof(ProfilRequete));
+        profils[k].prm.vitesse = vitesses[k];
+        profils[k].prm.indexFeux = index_feux(ville);
+        profils[k].prm.feux = ville->F;
+        profils[k].prm.fermetures = &ville->fermetures;
+        profils[k].virages = k > 0 ? virages_graphe(ville) : NULL;
+    }
+    unsigned int graine = 23;
+    for (i = 0; i < nbRequetes; i++) {
+        graine = graine * 1103515245u + 12345u;
+        requetes[i].source = (graine >> 8) % n;
+        graine = graine * 1103515245u + 12345u;
+        requetes[i].cible = (graine >> 8) % n;
+        requetes[i].profil = i % 3;
+        requetes[i].depart = (double)(i % 120);
+    }
+    printf("\n=== Requetes en lot : %s, %d noeuds, %d aretes, %d requetes ===\n", cote > 0 ? "grille" : grilleOuCarte,
+           n, r->nbAretes, nbRequetes);
+    // Rfrence : une requte aprs l'autre sur le thread appelant
+    double debut = chrono_secondes();
+    for (i = 0; i < nbRequetes; i++) {
+        const Requete* q = &requetes[i];
+        const ProfilRequete* profil = &profils[q->profil];
+        reference[i] = profil->virages ? itineraire_virages(r, &profil->prm, profil->virages, q->source, q->cible,
+                                                            q->depart, &espaceVirages)
+                                       : itineraire_temporel(r, &profil->prm, q->source, q->cible, q->depart, &espace);
+    }
+    double tempsReference = chrono_secondes() - debut;
+    printf("Un par un : %.3f s, %.0f requetes/s\n", tempsReference, nbRequetes / tempsReference);
+    printf("Threads | Temps (s) | Requetes/s | Gain     | Vols | Resultat\n");
+    for (k = 1; k <= maxThreads; k++) {
+        PoolRequetes* pool = pool_requetes_creer(r, k);
+        if (!pool) {
+            printf("Erreur d'allocation memoire !\n");
+            break;
+        }
+        debut = chrono_secondes();
+        pool_requetes_executer(pool, requetes, nbRequetes, profils, resultats);
+        double t = chrono_secondes() - debut;
+        long vols = 0;
+        for (i = 0; i < k; i++) vols += pool->travailleurs[i].nbVols;
+        int identique = 1;
+        for (i = 0; i < nbRequetes; i++) {
+            if (resultats[i].longueur != reference[i].longueur || resultats[i].cout != reference[i].cout ||
+                memcmp(resultats[i].noeuds, reference[i].noeuds, sizeof(int) * resultats[i].longueur))
+                identique = 0;
+            itineraire_liberer(&resultats[i]);
+        }
+        printf("%7d | %9.3f | %10.0f | x%-7.2f | %4ld | %s\n", k, t, t > 0 ? nbRequetes / t : 0.0,
+               t > 0 ? tempsReference / t : 0.0, vols, identique ? "identique" : "DIFFERENT");
+        pool_requetes_liberer(pool);
+    }
+    for (i = 0; i < nbRequetes; i++) itineraire_liberer(&reference[i]);
+    espace_virages_liberer(&espaceVirages);
+    espace_liberer(&espace);
+    free(requetes);
+    free(reference);
+    free(resultats);
+    libererGraphe(ville);
+}
+
+/* ========================================================================= */
+/*                   SCNARIOS SANS INTERACTION (--scenario)                 */
+/* ========================================================================= */
+
+/* tat du jeu d'un scnario : graphe courant, pool de requtes et tampons du lot en cours */
+typedef struct {
+    const Scenario* sc;
+    FILE* sortie;
+    int nbThreads;
+    int nbErreurs;
+    Graphe* graph;
+    Reseau* r;
+    PoolRequetes* pool;
+    ProfilRequete* profils;    // Un par vhicule du scnario
+    Requete* requetes;
+    const CommandeScenario** commandes; // Commande R de chaque requte du lot
+    Itineraire* resultats;
+    int capacite;
+} JeuScenario;
+
+static void scenario_erreur(JeuScenario* j, int ligne, const char* message) {
+    fprintf(j->sortie, "E,%d,%s\n", ligne, message);
+    j->nbErreurs++;
+}
+
+/* Commande G : remplace le graphe courant (et son pool) */
+static void scenario_graphe(JeuScenario* j, const CommandeScenario* cmd) {
+    const char* nom = scenario_texte(j->sc, cmd->a);
+    char erreur[256];
+    int cote = 0;
+    pool_requetes_liberer(j->pool);
+    if (j->graph) libererGraphe(j->graph);
+    j->pool = NULL;
+    j->graph = NULL;
+    j->r = NULL;
+    double debut = chrono_secondes();
+    if (carte_entier(nom, (int)strlen(nom), &cote) && cote > 0) {
+        j->graph = creer_ville_grille(cote);
+    } else {
+        Carte carte;
+        if (!carte_charger(&carte, nom, erreur, sizeof(erreur))) {
+            scenario_erreur(j, cmd->ligne, erreur);
+            return;
+        }
+        j->graph = graphe_depuis_carte(&carte);
+        carte_liberer(&carte);
+    }
+    j->r = j->graph ? reseau_graphe(j->graph) : NULL;
+    // Index des feux et tables de virages prts avant le lancement des threads
+    if (j->r && index_feux(j->graph)) {
+        virages_graphe(j->graph);
+        j->pool = pool_requetes_creer(j->r, j->nbThreads);
+    }
+    if (!j->pool) {
+        scenario_erreur(j, cmd->ligne, "erreur d'allocation memoire");
+        if (j->graph) libererGraphe(j->graph);
+        j->graph = NULL;
+        j->r = NULL;
+        return;
+    }
+    fprintf(j->sortie, "G,%d,%d,%d,%.6f\n", cmd->ligne, j->r->nbNoeuds, j->r->nbAretes, chrono_secondes() - debut);
+}
+
+/* Requtes conscutives commandes[debut .. fin) : un lot calcul par le pool */
+static void scenario_lot(JeuScenario* j, int debut, int fin) {
+    const Scenario* sc = j->sc;
+    int i, nb = 0;
+    if (fin - debut > j->capacite) {
+        int capacite = fin - debut;
+        Requete* requetes = (Requete*)realloc(j->requetes, sizeof(Requete) * capacite);
+        if (requetes) j->requetes = requetes;
+        const CommandeScenario** commandes =
+            (const CommandeScenario**)realloc(j->commandes, sizeof(CommandeScenario*) * capacite);
+        if (commandes) j->commandes = commandes;
+        Itineraire* resultats = (Itineraire*)realloc(j->resultats, sizeof(Itineraire) * capacite);
+        if (resultats) j->resultats = resultats;
+        if (!requetes || !commandes || !resultats) {
+            for (i = debut; i < fin; i++) scenario_erreur(j, sc->commandes[i].ligne, "erreur d'allocation memoire");
+            return;
+        }
+        j->capacite = capacite;
+    }
+    if (!j->pool) {
+        for (i = debut; i < fin; i++) scenario_erreur(j, sc->commandes[i].ligne, "pas de graphe");
+        return;
+    }
+    for (i = debut; i < fin; i++) {
+        const CommandeScenario* cmd = &sc->commandes[i];
+        if (cmd->a >= 0 && cmd->a < j->r->nbNoeuds && cmd->b >= 0 && cmd->b < j->r->nbNoeuds) {
+            Requete q = { cmd->a, cmd->b, cmd->c, cmd->x };
+            j->commandes[nb] = cmd;
+            j->requetes[nb++] = q;
+        }
+    }
+    // Profils refaits  chaque lot : le graphe a pu changer depuis le prcdent
+    for (i = 0; i < sc->nbVehicules; i++) {
+        ProfilRequete* profil = &j->profils[i];
+        memset(profil, 0, sizeof(ProfilRequete));
+        profil->prm.vitesse = sc->vehicules[i].vitesse;
+        profil->prm.indexFeux = index_feux(j->graph);
+        profil->prm.feux = j->graph->F;
+        profil->prm.fermetures = &j->graph->fermetures;
+        profil->virages = sc->vehicules[i].virages ? virages_graphe(j->graph) : NULL;
+    }
+    double chrono = chrono_secondes();
+    pool_requetes_executer(j->pool, j->requetes, nb, j->profils, j->resultats);
+    double temps = chrono_secondes() - chrono;
+    // Rsultats et erreurs dans l'ordre du scnario
+    int k = 0;
+    for (i = debut; i < fin; i++) {
+        const CommandeScenario* cmd = &sc->commandes[i];
+        if (k == nb || j->commandes[k] != cmd) {
+            scenario_erreur(j, cmd->ligne, "noeud inexistant");
+            continue;
+        }
+        Itineraire* it = &j->resultats[k++];
+        fprintf(j->sortie, "R,%d,%d,%d,%s,%.3f,", cmd->ligne, cmd->a, cmd->b,
+                scenario_texte(sc, sc->vehicules[cmd->c].nom), cmd->x);
+        if (it->longueur > 0)
+            fprintf(j->sortie, "%.6f,%.6f,%d\n", it->cout, it->cout - cmd->x, it->longueur);
+        else
+            fprintf(j->sortie, "-,-,0\n");
+        itineraire_liberer(it);
+    }
+    if (nb > 0)
+        fprintf(j->sortie, "L,%d,%d,%.6f,%.0f\n", j->commandes[0]->ligne, nb, temps,
+                temps > 0 ? nb / temps : 0.0);
+}
+
+/* Commande S : simulation multi-thread, une rgion par thread */
+static void scenario_simulation(JeuScenario* j, const CommandeScenario* cmd) {
+    int nb = cmd->a, k = j->nbThreads, i;
+    if (!j->pool) {
+        scenario_erreur(j, cmd->ligne, "pas de graphe");
+        return;
+    }
+    VehiculeSim* vehicules = (VehiculeSim*)malloc(sizeof(VehiculeSim) * (nb > 0 ? nb : 1));
+    int* region = vehicules ? partition_multiniveau(j->r, k, PARTITION_TOLERANCE, k, NULL) : NULL;
+    SimulationParallele* sim = NULL;
+    if (region) {
+        vehicules_sim_init(vehicules, nb, j->r, cmd->b >= 0 ? j->sc->vehicules[cmd->b].vitesse : VITESSE_SIMULATION, 42);
+        sim = simulation_parallele_creer(j->r, region, k, vehicules, nb, cmd->x);
+    }
+    if (!sim) {
+        scenario_erreur(j, cmd->ligne, "erreur d'allocation memoire");
+        free(region);
+        free(vehicules);
+        return;
+    }
+    sim->attenteNoeud = attente_feux_simulation;
+    sim->contexteAttente = j->graph;
+    sim->fermetures = &j->graph->fermetures;
+    double debut = chrono_secondes();
+    if (!simulation_parallele_executer(sim)) {
+        scenario_erreur(j, cmd->ligne, "simulation impossible (thread ou memoire)");
+        simulation_parallele_liberer(sim);
+        free(region);
+        free(vehicules);
+        return;
+    }
+    double temps = chrono_secondes() - debut;
+    long evenements = 0;
+    for (i = 0; i < k; i++) evenements += sim->regions[i].nbEvenements;
+    fprintf(j->sortie, "S,%d,%d,%.3f,%ld,%016llx,%d,%.6f\n", cmd->ligne, nb, cmd->x, evenements,
+            simulation_empreinte(vehicules, nb), k, temps);
+    simulation_parallele_liberer(sim);
+    free(region);
+    free(vehicules);
+}
+
+/**
+ * Joue le scnario sans saisie ni pause et crit les rsultats dans 'sortie', une ligne par
+ * rsultat (champs spars par des virgules, le type en premier). Les lignes R, P et E, et les
+ * lignes S jusqu' l'empreinte, ne dpendent pas du nombre de threads : les temps sont dans les
+ * lignes G, L et T et  la fin des lignes S. Retourne le nombre d'erreurs (lignes E).
+ */
+int jouer_scenario(const Scenario* sc, FILE* sortie, int nbThreads) {
+    JeuScenario j;
+    int i;
+    memset(&j, 0, sizeof(JeuScenario));
+    j.sc = sc;
+    j.sortie = sortie;
+    j.nbThreads = nbThreads;
+    j.profils = (ProfilRequete*)malloc(sizeof(ProfilRequete) * (sc->nbVehicules > 0 ? sc->nbVehicules : 1));
+    if (!j.profils) {
+        fprintf(sortie, "E,0,erreur d'allocation memoire\n");
+        return 1;
+    }
+    fprintf(sortie, "# G,ligne,noeuds,aretes,temps (s)\n");
+    fprintf(sortie, "# R,ligne,source,cible,vehicule,depart,arrivee,duree,noeuds\n");
+    fprintf(sortie, "# L,premiere ligne,requetes,temps (s),requetes/s\n");
+    fprintf(sortie, "# P,ligne,arete,etat\n");
+    fprintf(sortie, "# S,ligne,vehicules,duree,evenements,empreinte,threads,temps (s)\n");
+    fprintf(sortie, "# E,ligne,message\n");
+    fprintf(sortie, "# T,commandes,erreurs,temps (s)\n");
+    double debut = chrono_secondes();
+    for (i = 0; i < sc->nbCommandes;) {
+        const CommandeScenario* cmd = &sc->commandes[i];
+        if (cmd->type == 'R') {
+            // Les requtes conscutives forment un lot
+            int fin = i;
+            while (fin < sc->nbCommandes && sc->commandes[fin].type == 'R') fin++;
+            scenario_lot(&j, i, fin);
+            i = fin;
+            continue;
+        }
+        switch (cmd->type) {
+        case 'G':
+            scenario_graphe(&j, cmd);
+            break;
+        case 'P':
+            if (!j.graph)
+                scenario_erreur(&j, cmd->ligne, "pas de graphe");
+            else if (cmd->a < 0 || cmd->a >= j.graph->nbaretes)
+                scenario_erreur(&j, cmd->ligne, "arete inexistante");
+            else {
+                definir_etat_arete(j.graph, cmd->a, cmd->b);
+                fprintf(sortie, "P,%d,%d,%d\n", cmd->ligne, cmd->a, cmd->b);
+            }
+            break;
+        case 'S':
+            scenario_simulation(&j, cmd);
+            break;
+        }
+        i++;
+    }
+    fprintf(sortie, "T,%d,%d,%.6f\n", sc->nbCommandes, j.nbErreurs, chrono_secondes() - debut);
+    pool_requetes_liberer(j.pool);
+    if (j.graph) libererGraphe(j.graph);
+    free(j.profils);
+    free(j.requetes);
+    free(j.commandes);
+    free(j.resultats);
+    return j.nbErreurs;
+}
+
 /* ========================================================================= */
 /*                                MAIN                                       */
 /* ========================================================================= */
-int main() {
+int main(int argc, char** argv) {
     srand(time(NULL));
 
+    /* Mode banc d'essai : --simulation-parallele [cote] [vehicules] [duree] [threads] */
+    if (argc > 1 && strcmp(argv[1], "--simulation-parallele") == 0) {
+        int cote = (argc > 2) ? atoi(argv[2]) : 100;
+        int nbVehicules = (argc > 3) ? atoi(argv[3]) : 50000;
+        double duree = (argc > 4) ? atof(argv[4]) : 3600.0;
+        int maxThreads = (argc > 5) ? atoi(argv[5]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+        if (maxThreads < 1) maxThreads = 1;
+        Graphe* ville = creer_ville_grille(cote);
+        if (!ville) return 1;
+        rapport_scalabilite_simulation(ville, nbVehicules, duree, maxThreads);
+        libererGraphe(ville);
+        return 0;
+    }
+
+    /* Mode banc d'essai : --banc-files [cote] [vehicules] [duree] */
+    if (argc > 1 && strcmp(argv[1], "--banc-files") == 0) {
+        int cote = (argc > 2) ? atoi(argv[2]) : 30;
+        int nbVehicules = (argc > 3) ? atoi(argv[3]) : 10000;
+        int duree = (argc > 4) ? atoi(argv[4]) : 3600;
+        Graphe* ville = creer_ville_grille(cote);
+        if (!ville) return 1;
+        banc_files_feux(ville, nbVehicules, duree);
+        libererGraphe(ville);
+        return 0;
+    }
+
+    /* Mode banc d'essai : --banc-passagers [passagers] [bus] [capacite] */
+    if (argc > 1 && strcmp(argv[1], "--banc-passagers") == 0) {
+        long nbPassagers = (argc > 2) ? atol(argv[2]) : 1000000;
+        int nbBus = (argc > 3) ? atoi(argv[3]) : 50;
+        int capacite = (argc > 4) ? atoi(argv[4]) : 100;
+        Graphe* ville = creer_ville_grille(10);
+        if (!ville || nbBus < 1) return 1;
+        banc_passagers(ville, nbPassagers, nbBus, capacite);
+        libererGraphe(ville);
+        return 0;
+    }
+
+    /* Mode banc d'essai : --demande [passagers_par_jour] [vehicules] [capacite] */
+    if (argc > 1 && strcmp(argv[1], "--demande") == 0) {
+        double parJour = (argc > 2) ? atof(argv[2]) : 20e6;
+        int nbVehicules = (argc > 3) ? atoi(argv[3]) : 2000;
+        int capacite = (argc > 4) ? atoi(argv[4]) : 400;
+        Graphe* ville = creer_ville_grille(10);
+        if (!ville || nbVehicules < 1) return 1;
+        simulation_demande(ville, parJour, nbVehicules, capacite, 30.0);
+        libererGraphe(ville);
+        return 0;
+    }
+
+    /* Mode banc d'essai : --trajectoires [vehicules] [duree] [budget_Mo] [fichier] */
+    if (argc > 1 && strcmp(argv[1], "--trajectoires") == 0) {
+        int nbVehicules = (argc > 2) ? atoi(argv[2]) : 100000;
+        double duree = (argc > 3) ? atof(argv[3]) : 86400.0;
+        double budget = (argc > 4) ? atof(argv[4]) : 64.0;
+        Graphe* ville = creer_ville_grille(100);
+        if (!ville) return 1;
+        banc_trajectoires(ville, nbVehicules, duree, (size_t)(budget * 1048576.0), (argc > 5) ? argv[5] : NULL);
+        libererGraphe(ville);
+        return 0;
+    }
+
+    /* Conversion de carte : --convertir entree sortie (binaire si la sortie se termine par .bin) */
+    if (argc > 3 && strcmp(argv[1], "--convertir") == 0) {
+        Carte carte;
+        char erreur[256];
+        size_t longueur = strlen(argv[3]);
+        if (!carte_charger(&carte, argv[2], erreur, sizeof(erreur))) {
+            printf("Erreur lors du chargement de la carte : %s\n", erreur);
+            return 1;
+        }
+        int ok = (longueur > 4 && strcmp(argv[3] + longueur - 4, ".bin") == 0)
+                 ? carte_ecrire_binaire(&carte, argv[3]) : carte_ecrire_texte(&carte, argv[3]);
+        printf("%s : %d noeuds, %d aretes, %d feux%s\n", argv[3], carte.nbNoeuds, carte.nbAretes, carte.nbFeux,
+               ok ? "" : " (erreur d'ecriture)");
+        carte_liberer(&carte);
+        return ok ? 0 : 1;
+    }
+
+    /* Mode banc d'essai : --banc-carte [cote] [prefixe] */
+    if (argc > 1 && strcmp(argv[1], "--banc-carte") == 0) {
+        int cote = (argc > 2) ? atoi(argv[2]) : 1000;
+        banc_carte(cote, (argc > 3) ? argv[3] : "banc_carte");
+        return 0;
+    }
+
+    /* Import OSM : --importer-osm extrait.osm sortie [threads] (binaire si la sortie se termine par .bin) */
+    if (argc > 3 && strcmp(argv[1], "--importer-osm") == 0) {
+        Carte carte;
+        StatsImportOSM stats;
+        char erreur[256];
+        int nbThreads = (argc > 4) ? atoi(argv[4]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+        size_t longueur = strlen(argv[3]);
+        if (!osm_importer(&carte, argv[2], nbThreads, &stats, erreur, sizeof(erreur))) {
+            printf("Erreur lors de l'import : %s\n", erreur);
+            return 1;
+        }
+        printf("\n=== Import OSM : %s (%d threads) ===\n", argv[2], nbThreads > 0 ? nbThreads : 1);
+        printf("Lus : %.1f Mo en %.2f s (%.1f Mo/s, deux passes)\n", stats.octets / 1048576.0, stats.secondes,
+               stats.secondes > 0 ? stats.octets / 1048576.0 / stats.secondes : 0.0);
+        printf("Voies carrossables : %d, noeuds : %d (%d absents de l'extrait), aretes : %d\n",
+               stats.nbVoies, stats.nbNoeuds, stats.nbNoeudsAbsents, stats.nbAretes);
+        printf("Debit : %.0f noeuds/s, %.0f aretes/s\n", stats.secondes > 0 ? stats.nbNoeuds / stats.secondes : 0.0,
+               stats.secondes > 0 ? stats.nbAretes / stats.secondes : 0.0);
+        printf("Pic de memoire residente : %ld Ko\n", memoire_pic_ko());
+        int ok = (longueur > 4 && strcmp(argv[3] + longueur - 4, ".bin") == 0)
+                 ? carte_ecrire_binaire(&carte, argv[3]) : carte_ecrire_texte(&carte, argv[3]);
+        if (!ok) printf("%s : erreur d'ecriture\n", argv[3]);
+        carte_liberer(&carte);
+        return ok ? 0 : 1;
+    }
+
+    /* Vrification de l'empreinte d'une carte dans deux processus : --empreinte-carte carte */
+    if (argc > 2 && strcmp(argv[1], "--empreinte-carte") == 0)
+        return verifier_empreinte_carte(argv[2]) ? 0 : 1;
+
+    /* Cration d'un instantan : --creer-instantane carte sortie */
+    if (argc > 3 && strcmp(argv[1], "--creer-instantane") == 0) {
+        Carte carte;
+        char erreur[256];
+        if (!carte_charger(&carte, argv[2], erreur, sizeof(erreur))) {
+            printf("Erreur lors du chargement de la carte : %s\n", erreur);
+            return 1;
+        }
+        int ok = instantane_ecrire(argv[3], &carte, argv[2]);
+        printf("%s : %d noeuds, %d aretes, %d feux%s\n", argv[3], carte.nbNoeuds, carte.nbAretes, carte.nbFeux,
+               ok ? "" : " (erreur d'ecriture)");
+        carte_liberer(&carte);
+        return ok ? 0 : 1;
+    }
+
+    /* Mode banc d'essai : --banc-crp [cote] [requetes] [threads] */
+    if (argc > 1 && strcmp(argv[1], "--banc-crp") == 0) {
+        int nbThreads = (argc > 4) ? atoi(argv[4]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+        banc_crp((argc > 2) ? atoi(argv[2]) : 300, (argc > 3) ? atoi(argv[3]) : 100, nbThreads < 1 ? 1 : nbThreads);
+        return 0;
+    }
+
+    /* Mode banc d'essai : --banc-partition [cote|carte] [parties] [threads] */
+    if (argc > 1 && strcmp(argv[1], "--banc-partition") == 0) {
+        int nbThreads = (argc > 4) ? atoi(argv[4]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+        banc_partition((argc > 2) ? argv[2] : "300", (argc > 3) ? atoi(argv[3]) : 64, nbThreads < 1 ? 1 : nbThreads);
+        return 0;
+    }
+
+    /* Mode banc d'essai : --banc-virages [cote] [requetes] */
+    if (argc > 1 && strcmp(argv[1], "--banc-virages") == 0) {
+        banc_virages((argc > 2) ? atoi(argv[2]) : 300, (argc > 3) ? atoi(argv[3]) : 200);
+        return 0;
+    }
+
+    /* Mode banc d'essai : --banc-alternatives [cote|carte] [requetes] [threads] */
+    if (argc > 1 && strcmp(argv[1], "--banc-alternatives") == 0) {
+        banc_alternatives((argc > 2) ? argv[2] : "100", (argc > 3) ? atoi(argv[3]) : 200, (argc > 4) ? atoi(argv[4]) : 4);
+        return 0;
+    }
+    /* Mode banc d'essai : --banc-isochrones [cote|carte] [sources] [duree] [threads] */
+    if (argc > 1 && strcmp(argv[1], "--banc-isochrones") == 0) {
+        int maxThreads = (argc > 5) ? atoi(argv[5]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+        banc_isochrones((argc > 2) ? argv[2] : "300", (argc > 3) ? atoi(argv[3]) : 200, (argc > 4) ? atof(argv[4]) : 600.0,
+                        maxThreads < 1 ? 1 : maxThreads);
+        return 0;
+    }
+    /* Mode sans interaction : --scenario fichier|- [sortie|-] [threads] */
+    if (argc > 2 && strcmp(argv[1], "--scenario") == 0) {
+        Scenario sc;
+        char erreur[256];
+        int nbThreads = (argc > 4) ? atoi(argv[4]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+        if (!scenario_charger(&sc, argv[2], erreur, sizeof(erreur))) {
+            fprintf(stderr, "Erreur lors du chargement du scenario : %s\n", erreur);
+            return 1;
+        }
+        FILE* sortie = (argc > 3 && strcmp(argv[3], "-") != 0) ? fopen(argv[3], "w") : stdout;
+        if (!sortie) {
+            fprintf(stderr, "Impossible d'ecrire %s\n", argv[3]);
+            scenario_liberer(&sc);
+            return 1;
+        }
+        int erreurs = jouer_scenario(&sc, sortie, nbThreads < 1 ? 1 : nbThreads);
+        if (sortie != stdout) fclose(sortie);
+        scenario_liberer(&sc);
+        return erreurs > 0;
+    }
+    /* Mode banc d'essai : --banc-lots [cote|carte] [requetes] [threads] */
+    if (argc > 1 && strcmp(argv[1], "--banc-lots") == 0) {
+        int maxThreads = (argc > 4) ? atoi(argv[4]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+        banc_lots((argc > 2) ? argv[2] : "300", (argc > 3) ? atoi(argv[3]) : 300, maxThreads < 1 ? 1 : maxThreads);
+        return 0;
+    }
+    /* Mode banc d'essai : --banc-fermetures [cote] [requetes] */
+    if (argc > 1 && strcmp(argv[1], "--banc-fermetures") == 0) {
+        banc_fermetures((argc > 2) ? atoi(argv[2]) : 300, (argc > 3) ? atoi(argv[3]) : 200);
+        return 0;
+    }
+
+    /* Mode banc d'essai : --banc-dynamique [cote] [modifications] [lecteurs] */
+    if (argc > 1 && strcmp(argv[1], "--banc-dynamique") == 0) {
+        banc_dynamique((argc > 2) ? atoi(argv[2]) : 200, (argc > 3) ? atoi(argv[3]) : 100000,
+                       (argc > 4) ? atoi(argv[4]) : 2);
+        return 0;
+    }
+
+    /* Mode banc d'essai : --banc-compact [cote|carte] [requetes] */
+    if (argc > 1 && strcmp(argv[1], "--banc-compact") == 0) {
+        banc_compact((argc > 2) ? argv[2] : "300", (argc > 3) ? atoi(argv[3]) : 200);
+        return 0;
+    }
+
+    /* Mode banc d'essai : --banc-renumerotation [cote] [requetes] */
+    if (argc > 1 && strcmp(argv[1], "--banc-renumerotation") == 0) {
+        banc_renumerotation((argc > 2) ? atoi(argv[2]) : 300, (argc > 3) ? atoi(argv[3]) : 200);
+        return 0;
+    }
+
+    /* Mode banc d'essai : --banc-instantane carte instantane [requetes] */
+    if (argc > 3 && strcmp(argv[1], "--banc-instantane") == 0) {
+        banc_instantane(argv[2], argv[3], (argc > 4) ? atoi(argv[4]) : 100);
+        return 0;
+    }
+
     /*------------------ Partie Simulation ------------------*/
-    /* Cration du graphe de transport (simulation) :
-       6 noeuds, 8 aretes */
-    Graphe* graph = creergraphe(6, 8, 2);
+    /* Chargement du rseau de transport (simulation) : par dfaut le rseau de dmonstration,
+       6 noeuds, 8 aretes et 2 feux, ou la carte donne par --carte fichier */
+    const char* fichierCarte = (argc > 2 && strcmp(argv[1], "--carte") == 0) ? argv[2] : "cartes/demo.txt";
+    Graphe* graph = charger_graphe(fichierCarte);
     if (!graph) return 1;
 
-    /* Ajout des arrts */
-    ajouternoeud(graph, 0, "Gare Centrale", "Multi", 10, 20);
-    ajouternoeud(graph, 1, "Place Ville", "Bus", 15, 30);
-    ajouternoeud(graph, 2, "Station Metro", "Metro", 20, 40);
-    ajouternoeud(graph, 3, "Parc Principal", "Bus", 25, 35);
-    ajouternoeud(graph, 4, "Centre Commercial", "Multi", 30, 25);
-    ajouternoeud(graph, 5, "Zone Industrielle", "Bus", 35, 45);
-
-    /* Ajout des trajets */
-    ajouterarete(graph, 0, 0, 1, 5.0, 1);
-    ajouterarete(graph, 1, 1, 2, 3.5, 0);
-    ajouterarete(graph, 2, 2, 3, 4.0, 1);
-    ajouterarete(graph, 3, 3, 4, 3.0, 1);
-    ajouterarete(graph, 4, 4, 5, 4.5, 0);
-    ajouterarete(graph, 5, 0, 2, 8.0, 1);
-    ajouterarete(graph, 6, 1, 3, 6.0, 0);
-    ajouterarete(graph, 7, 2, 4, 5.5, 1);
-
     /* Affichage du graphe */
     afficher_graph(graph);
 
@@ -848,7 +3393,7 @@ int main() {
     printf("\n=== ESPACE UTILISATEUR : ===\n");
     printf("Source (ID de la station) : ");
     scanf("%d", &source);
-    Vehicule* v = &graph->principal;
+    Vehicule* v = vehicule_principal(graph);
     v->positionNoeud = source;
     printf("Destination (ID de la station) : ");
     scanf("%d", &destination);
@@ -871,7 +3416,13 @@ int main() {
     // 3. A* pour un chemin optimis avec heuristique
     printf("\n=== Calcul du chemin optimise (A*) ===\n");
     A_star(graph, source, destination);
-    // 4. Simulation du dplacement
+    // 4. Itinraire le plus rapide compte tenu des feux
+    printf("\n=== Calcul de l'itineraire le plus rapide (feux compris) ===\n");
+    Itineraire_rapide(graph, source, destination);
+    // 5. Itinraires de rechange
+    printf("\n=== Calcul des itineraires alternatifs ===\n");
+    Itineraires_alternatifs(graph, source, destination);
+    // 6. Simulation du dplacement
     printf("\n=== Simulation du deplacement du vehicule ===\n");
     while (v->positionNoeud != v->destinationNoeud) {
     deplacerVehiculePrincipal(graph);
@@ -884,10 +3435,7 @@ int main() {
     }while (continuer == 'o' || continuer == 'O');
 
     /* Libration de la mmoire */
-    free(graph->N);
-    free(graph->A);
-    free(graph->F);
-    free(graph);
+    libererGraphe(graph);
      printf("\nProgramme termine. Au revoir !\n");
 
     return 0;
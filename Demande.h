@@ -0,0 +1,214 @@
+#ifndef DEMANDE_H
+#define DEMANDE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+/* ===================== Générateur de demande voyageurs ===================== */
+/*
+ * Les arrivées de passagers aux arrêts suivent un processus de Poisson dont le débit est donné
+ * par une matrice origine-destination (passagers par heure) modulée par un profil horaire.
+ * Les passagers sont produits au fil du temps simulé et transmis un par un à la simulation :
+ * la mémoire utilisée ne dépend que du nombre d'arrêts, pas du nombre de passagers générés.
+ *
+ * Tirage en O(1) par passager : une table d'alias choisit l'origine, une table d'alias par
+ * origine choisit la destination, et l'amincissement (thinning) applique le profil horaire.
+ */
+
+/* Table d'alias (méthode de Vose) pour tirer un indice selon des poids */
+typedef struct {
+    int n;
+    double* seuil;
+    int* alias;
+} TableAlias;
+
+/* Générateur de demande */
+typedef struct {
+    int nbArrets;
+    TableAlias origines;        // Choix de l'arrêt d'origine
+    TableAlias* destinations;   // Choix de la destination, une table par origine
+    double debitBase;           // Passagers par heure (somme de la matrice) pour un facteur horaire de 1
+    double profil[24];          // Facteur horaire, interpolé linéairement entre les heures
+    double profilMax;
+    double date;                // Date (s) de la prochaine arrivée candidate
+    unsigned long long graine;
+    long nbGeneres;
+} GenerateurDemande;
+
+/* Générateur pseudo-aléatoire xorshift64* : reproductible et indépendant de rand() */
+static inline double demande_aleatoire(unsigned long long* graine) {
+    unsigned long long x = *graine;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *graine = x;
+    return ((x * 2685821657736338717ULL) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+void alias_liberer(TableAlias* t) {
+    free(t->seuil);
+    free(t->alias);
+    t->seuil = NULL;
+    t->alias = NULL;
+    t->n = 0;
+}
+
+/**
+ * Construit la table d'alias de n poids positifs. Retourne 0 si la somme des poids est nulle
+ * ou en cas d'erreur d'allocation.
+ */
+int alias_construire(TableAlias* t, const double* poids, int n) {
+    int i, nbPetits = 0, nbGrands = 0;
+    double somme = 0.0;
+    t->n = n;
+    t->seuil = (double*)malloc(sizeof(double) * (n > 0 ? n : 1));
+    t->alias = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    int* pile = (int*)malloc(sizeof(int) * (n > 0 ? n : 1)); // Petits au début, grands à la fin
+    if (!t->seuil || !t->alias || !pile) {
+        free(pile);
+        alias_liberer(t);
+        return 0;
+    }
+    for (i = 0; i < n; i++)
+        somme += poids[i] > 0 ? poids[i] : 0.0;
+    if (somme <= 0) {
+        free(pile);
+        alias_liberer(t);
+        return 0;
+    }
+    for (i = 0; i < n; i++) {
+        t->seuil[i] = (poids[i] > 0 ? poids[i] : 0.0) * n / somme;
+        t->alias[i] = i;
+        if (t->seuil[i] < 1.0) pile[nbPetits++] = i;
+        else pile[n - 1 - nbGrands++] = i;
+    }
+    // Chaque petit est complété par un grand, qui perd la part cédée
+    while (nbPetits > 0 && nbGrands > 0) {
+        int petit = pile[--nbPetits];
+        int grand = pile[n - nbGrands];
+        t->alias[petit] = grand;
+        t->seuil[grand] -= 1.0 - t->seuil[petit];
+        if (t->seuil[grand] < 1.0) {
+            nbGrands--;
+            pile[nbPetits++] = grand;
+        }
+    }
+    // Restes dus aux arrondis : probabilité 1
+    while (nbGrands > 0) t->seuil[pile[n - nbGrands--]] = 1.0;
+    while (nbPetits > 0) t->seuil[pile[--nbPetits]] = 1.0;
+    free(pile);
+    return 1;
+}
+
+static inline int alias_tirer(const TableAlias* t, unsigned long long* graine) {
+    double u = demande_aleatoire(graine) * t->n;
+    int i = (int)u;
+    if (i >= t->n) i = t->n - 1;
+    return (u - i < t->seuil[i]) ? i : t->alias[i];
+}
+
+void demande_liberer(GenerateurDemande* g) {
+    int i;
+    alias_liberer(&g->origines);
+    if (g->destinations) {
+        for (i = 0; i < g->nbArrets; i++)
+            alias_liberer(&g->destinations[i]);
+        free(g->destinations);
+        g->destinations = NULL;
+    }
+    g->nbArrets = 0;
+}
+
+/**
+ * Initialise le générateur à partir d'une matrice origine-destination n x n (passagers par heure,
+ * od[o * n + d]) et d'un profil horaire de 24 facteurs (NULL = débit constant).
+ * Les passagers sont générés à partir de la date 'debut' (s depuis minuit).
+ */
+int demande_init(GenerateurDemande* g, const double* od, int n, const double* profil, double debut, unsigned long long graine) {
+    int o, d, h;
+    g->nbArrets = n;
+    g->destinations = (TableAlias*)calloc(n > 0 ? n : 1, sizeof(TableAlias));
+    g->origines.seuil = NULL;
+    g->origines.alias = NULL;
+    g->origines.n = 0;
+    double* debitOrigine = (double*)malloc(sizeof(double) * (n > 0 ? n : 1));
+    if (!g->destinations || !debitOrigine) {
+        free(debitOrigine);
+        demande_liberer(g);
+        return 0;
+    }
+    g->debitBase = 0.0;
+    for (o = 0; o < n; o++) {
+        debitOrigine[o] = 0.0;
+        for (d = 0; d < n; d++)
+            if (d != o && od[(long)o * n + d] > 0)
+                debitOrigine[o] += od[(long)o * n + d];
+        g->debitBase += debitOrigine[o];
+        // Une origine sans demande garde une table vide : elle ne sera jamais tirée
+        if (debitOrigine[o] > 0) {
+            double* ligne = (double*)malloc(sizeof(double) * n);
+            if (!ligne) break;
+            for (d = 0; d < n; d++)
+                ligne[d] = (d != o) ? od[(long)o * n + d] : 0.0;
+            int ok = alias_construire(&g->destinations[o], ligne, n);
+            free(ligne);
+            if (!ok) break;
+        }
+    }
+    int ok = (o == n) && g->debitBase > 0 && alias_construire(&g->origines, debitOrigine, n);
+    free(debitOrigine);
+    if (!ok) {
+        demande_liberer(g);
+        return 0;
+    }
+    g->profilMax = 0.0;
+    for (h = 0; h < 24; h++) {
+        g->profil[h] = profil ? (profil[h] > 0 ? profil[h] : 0.0) : 1.0;
+        if (g->profil[h] > g->profilMax) g->profilMax = g->profil[h];
+    }
+    if (g->profilMax <= 0) {
+        demande_liberer(g);
+        return 0;
+    }
+    g->graine = graine ? graine : 88172645463325252ULL;
+    g->nbGeneres = 0;
+    // Première arrivée candidate
+    g->date = debut - log(1.0 - demande_aleatoire(&g->graine)) * 3600.0 / (g->debitBase * g->profilMax);
+    return 1;
+}
+
+/* Facteur horaire à la date t (s depuis minuit), interpolé entre les heures pleines */
+double demande_facteur(const GenerateurDemande* g, double t) {
+    double h = fmod(t, 86400.0) / 3600.0;
+    if (h < 0) h += 24.0;
+    int a = (int)h;
+    if (a > 23) a = 23;
+    double x = h - a;
+    return g->profil[a] + x * (g->profil[(a + 1) % 24] - g->profil[a]);
+}
+
+/**
+ * Produit toutes les arrivées de passagers jusqu'à la date 'jusqua' (exclue), dans l'ordre
+ * chronologique, en appelant 'arrivee' pour chacune. Retourne le nombre de passagers produits.
+ */
+long demande_avancer(GenerateurDemande* g, double jusqua,
+                     void (*arrivee)(void* contexte, double date, int origine, int destination), void* contexte) {
+    long produits = 0;
+    double debitMax = g->debitBase * g->profilMax / 3600.0; // Passagers par seconde, au plus fort
+    while (g->date < jusqua) {
+        double t = g->date;
+        g->date -= log(1.0 - demande_aleatoire(&g->graine)) / debitMax;
+        // Amincissement : le candidat est retenu avec la probabilité facteur(t) / facteurMax
+        if (demande_aleatoire(&g->graine) * g->profilMax >= demande_facteur(g, t))
+            continue;
+        int origine = alias_tirer(&g->origines, &g->graine);
+        int destination = alias_tirer(&g->destinations[origine], &g->graine);
+        arrivee(contexte, t, origine, destination);
+        produits++;
+    }
+    g->nbGeneres += produits;
+    return produits;
+}
+
+#endif
@@ -0,0 +1,113 @@
+#ifndef FERMETURES_H
+#define FERMETURES_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdatomic.h>
+
+/* ===================== Fermetures et pénalités d'arêtes ===================== */
+/*
+ * Deux bits par arête d'origine (indice dans le graphe, idArete dans un Reseau) :
+ *  - fermée : l'arête n'est jamais empruntée (accident, travaux) ;
+ *  - pénalisée : son coût est multiplié par facteurPenalite >= 1 (panne, voie réduite), ce
+ *    qui garde l'heuristique A* admissible.
+ * Basculer une arête coûte une opération atomique : rien n'est reconstruit ni copié, et les
+ * recherches en cours dans d'autres threads lisent les bits sans verrou. Chaque recherche
+ * accepte un pointeur NULL (aucune fermeture).
+ */
+
+typedef struct {
+    int nbAretes;
+    atomic_uint* fermees;       // 1 bit par arête
+    atomic_uint* penalisees;
+    double facteurPenalite;
+    atomic_int nbFermees;
+    atomic_int nbPenalisees;
+} Fermetures;
+
+void fermetures_liberer(Fermetures* f) {
+    free(f->fermees);
+    free(f->penalisees);
+    f->fermees = f->penalisees = NULL;
+    f->nbAretes = 0;
+}
+
+int fermetures_init(Fermetures* f, int nbAretes, double facteurPenalite) {
+    int mots = (nbAretes + 31) / 32;
+    f->nbAretes = nbAretes;
+    f->facteurPenalite = facteurPenalite > 1.0 ? facteurPenalite : 1.0;
+    f->fermees = (atomic_uint*)calloc(mots > 0 ? mots : 1, sizeof(atomic_uint));
+    f->penalisees = (atomic_uint*)calloc(mots > 0 ? mots : 1, sizeof(atomic_uint));
+    atomic_init(&f->nbFermees, 0);
+    atomic_init(&f->nbPenalisees, 0);
+    if (!f->fermees || !f->penalisees) {
+        fermetures_liberer(f);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Étend les bits à nbAretes arêtes (les nouvelles sont ouvertes). Déplace les tableaux :
+ * aucune recherche ne doit être en cours.
+ */
+int fermetures_agrandir(Fermetures* f, int nbAretes) {
+    int anciens = (f->nbAretes + 31) / 32, mots = (nbAretes + 31) / 32;
+    if (nbAretes <= f->nbAretes) return 1;
+    if (mots > anciens) {
+        atomic_uint* a = (atomic_uint*)realloc(f->fermees, sizeof(atomic_uint) * mots);
+        if (a) f->fermees = a;
+        atomic_uint* b = (atomic_uint*)realloc(f->penalisees, sizeof(atomic_uint) * mots);
+        if (b) f->penalisees = b;
+        if (!a || !b) return 0;
+        memset(f->fermees + anciens, 0, sizeof(atomic_uint) * (mots - anciens));
+        memset(f->penalisees + anciens, 0, sizeof(atomic_uint) * (mots - anciens));
+    }
+    f->nbAretes = nbAretes;
+    return 1;
+}
+
+/* Met le bit de l'arête e à 'valeur' ; retourne 1 si le bit a changé */
+static inline int fermetures_basculer(atomic_uint* bits, atomic_int* compteur, int e, int valeur) {
+    unsigned int masque = 1u << (e & 31), avant;
+    if (valeur)
+        avant = atomic_fetch_or_explicit(&bits[e >> 5], masque, memory_order_release);
+    else
+        avant = atomic_fetch_and_explicit(&bits[e >> 5], ~masque, memory_order_release);
+    if (((avant & masque) != 0) == (valeur != 0)) return 0;
+    atomic_fetch_add_explicit(compteur, valeur ? 1 : -1, memory_order_relaxed);
+    return 1;
+}
+
+/* Ferme (fermee = 1) ou rouvre l'arête e */
+static inline int fermer_arete(Fermetures* f, int e, int fermee) {
+    if (!f || e < 0 || e >= f->nbAretes) return 0;
+    return fermetures_basculer(f->fermees, &f->nbFermees, e, fermee);
+}
+
+/* Pénalise (penalisee = 1) ou rétablit l'arête e */
+static inline int penaliser_arete(Fermetures* f, int e, int penalisee) {
+    if (!f || e < 0 || e >= f->nbAretes) return 0;
+    return fermetures_basculer(f->penalisees, &f->nbPenalisees, e, penalisee);
+}
+
+static inline int arete_fermee(const Fermetures* f, int e) {
+    if (!f || e < 0 || e >= f->nbAretes) return 0;
+    return (atomic_load_explicit(&f->fermees[e >> 5], memory_order_relaxed) >> (e & 31)) & 1u;
+}
+
+static inline int arete_penalisee(const Fermetures* f, int e) {
+    if (!f || e < 0 || e >= f->nbAretes) return 0;
+    return (atomic_load_explicit(&f->penalisees[e >> 5], memory_order_relaxed) >> (e & 31)) & 1u;
+}
+
+/* Coût effectif de l'arête e : INFINITY si elle est fermée, coût x facteur si elle est pénalisée */
+static inline double fermetures_cout(const Fermetures* f, int e, double cout) {
+    if (!f) return cout;
+    if (arete_fermee(f, e)) return INFINITY;
+    return arete_penalisee(f, e) ? cout * f->facteurPenalite : cout;
+}
+
+#endif
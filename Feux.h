@@ -0,0 +1,339 @@
+#ifndef FEUX_H
+#define FEUX_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+/* ===================== Feux de signalisation ===================== */
+
+/* Structure pour représenter un feu rouge.
+   Le cycle commence par la phase rouge à la date 'Decalage' puis alterne
+   rouge (DureeRouge) / vert (DureeVert) : l'état à une date t se calcule directement. */
+typedef struct {
+    int ID;
+    int PositionNoeud;
+    int Etat;      // 0 = Vert, 1 = Rouge (mis à jour par feu_actualiser)
+    int DureeRouge;
+    int DureeVert;
+    int TempsRestant;
+    int Decalage;  // Date (s) de début d'une phase rouge
+} FeuRouge;
+
+/**
+ * Position dans le cycle du feu à la date t, dans [0, DureeRouge + DureeVert).
+ * Retourne -1 pour un feu sans cycle (toujours vert).
+ */
+double feu_phase(const FeuRouge* feu, double t) {
+    int cycle = feu->DureeRouge + feu->DureeVert;
+    if (feu->DureeRouge <= 0 || cycle <= 0)
+        return -1.0;
+    double phase = fmod(t - feu->Decalage, (double)cycle);
+    if (phase < 0) phase += cycle;
+    return phase;
+}
+
+/**
+ * État du feu à la date t : 1 = Rouge, 0 = Vert. Calcul en O(1).
+ */
+int feu_etat(const FeuRouge* feu, double t) {
+    double phase = feu_phase(feu, t);
+    return phase >= 0 && phase < feu->DureeRouge;
+}
+
+/**
+ * Temps restant avant le prochain changement de phase à la date t.
+ */
+double feu_temps_restant(const FeuRouge* feu, double t) {
+    double phase = feu_phase(feu, t);
+    if (phase < 0)
+        return INFINITY;
+    if (phase < feu->DureeRouge)
+        return feu->DureeRouge - phase;
+    return feu->DureeRouge + feu->DureeVert - phase;
+}
+
+/**
+ * Attente imposée à un véhicule arrivant au feu à la date t (0 si le feu est vert).
+ */
+double feu_attente(const FeuRouge* feu, double t) {
+    return feu_etat(feu, t) ? feu_temps_restant(feu, t) : 0.0;
+}
+
+/**
+ * Met à jour les champs Etat et TempsRestant à partir de la date t.
+ */
+void feu_actualiser(FeuRouge* feu, double t) {
+    feu->Etat = feu_etat(feu, t);
+    double restant = feu_temps_restant(feu, t);
+    feu->TempsRestant = isinf(restant) ? 0 : (int)ceil(restant);
+}
+
+/* ===================== Index nœud -> feux ===================== */
+
+/* Feux placés sur chaque nœud : ceux du nœud u sont feux[debut[u] .. debut[u+1]-1] */
+typedef struct {
+    int nbNoeuds;
+    int* debut;
+    int* feux;
+} IndexFeux;
+
+void index_feux_liberer(IndexFeux* index) {
+    free(index->debut);
+    free(index->feux);
+    index->debut = index->feux = NULL;
+    index->nbNoeuds = 0;
+}
+
+/**
+ * Construit l'index des feux par nœud (tri par comptage). Les feux sans cycle sont ignorés.
+ */
+int index_feux_construire(IndexFeux* index, const FeuRouge* feux, int nbFeux, int nbNoeuds) {
+    int i;
+    index->nbNoeuds = nbNoeuds;
+    index->debut = (int*)calloc(nbNoeuds + 1, sizeof(int));
+    index->feux = (int*)malloc(sizeof(int) * (nbFeux > 0 ? nbFeux : 1));
+    if (!index->debut || !index->feux) {
+        index_feux_liberer(index);
+        return 0;
+    }
+    for (i = 0; i < nbFeux; i++)
+        if (feux[i].DureeRouge > 0 && feux[i].PositionNoeud >= 0 && feux[i].PositionNoeud < nbNoeuds)
+            index->debut[feux[i].PositionNoeud + 1]++;
+    for (i = 0; i < nbNoeuds; i++)
+        index->debut[i + 1] += index->debut[i];
+    for (i = 0; i < nbFeux; i++)
+        if (feux[i].DureeRouge > 0 && feux[i].PositionNoeud >= 0 && feux[i].PositionNoeud < nbNoeuds)
+            index->feux[index->debut[feux[i].PositionNoeud]++] = i;
+    for (i = nbNoeuds; i > 0; i--)
+        index->debut[i] = index->debut[i - 1];
+    index->debut[0] = 0;
+    return 1;
+}
+
+/**
+ * Premier feu rouge à la date t sur le nœud, ou -1 si tous les feux du nœud sont verts.
+ */
+int feux_rouge_au_noeud(const IndexFeux* index, const FeuRouge* feux, int noeud, double t) {
+    int k;
+    for (k = index->debut[noeud]; k < index->debut[noeud + 1]; k++)
+        if (feu_etat(&feux[index->feux[k]], t))
+            return index->feux[k];
+    return -1;
+}
+
+/**
+ * Attente imposée par les feux d'un nœud à la date t (la plus longue si le nœud en a plusieurs).
+ */
+double feux_attente_noeud(const IndexFeux* index, const FeuRouge* feux, int noeud, double t) {
+    double attente = 0.0;
+    int k;
+    for (k = index->debut[noeud]; k < index->debut[noeud + 1]; k++) {
+        double a = feu_attente(&feux[index->feux[k]], t);
+        if (a > attente) attente = a;
+    }
+    return attente;
+}
+
+/* ===================== Roue temporelle hiérarchique ===================== */
+/*
+ * Planification des changements de phase de milliers de feux : 4 niveaux de 64 cases.
+ * Le niveau 0 couvre les 64 prochains pas, le niveau 1 les 64² suivants, etc.
+ * Insertion et déclenchement en O(1) amorti ; les événements lointains descendent
+ * d'un niveau lorsque la roue inférieure fait un tour complet.
+ */
+
+#define ROUE_NIVEAUX 4
+#define ROUE_BITS 6
+#define ROUE_CASES (1 << ROUE_BITS)
+
+typedef struct {
+    long long echeance; // En pas de la roue
+    double date;        // Date exacte demandée (s)
+    int feu;
+    int suivant;        // Chaînage dans la case (ou dans la liste libre)
+} EvenementRoue;
+
+typedef struct {
+    double pas;          // Durée d'un pas (s)
+    long long maintenant; // Dernier pas traité
+    int cases[ROUE_NIVEAUX][ROUE_CASES];
+    EvenementRoue* evenements;
+    int capacite;
+    int libre;           // Tête de la liste des événements libres
+    int nbPlanifies;
+} RoueTemporelle;
+
+/**
+ * Initialise une roue vide à la date 0.
+ */
+int roue_init(RoueTemporelle* roue, double pas, int capacite) {
+    int n, c;
+    if (capacite < 16) capacite = 16;
+    roue->pas = pas > 0 ? pas : 1.0;
+    roue->maintenant = 0;
+    roue->nbPlanifies = 0;
+    for (n = 0; n < ROUE_NIVEAUX; n++)
+        for (c = 0; c < ROUE_CASES; c++)
+            roue->cases[n][c] = -1;
+    roue->evenements = (EvenementRoue*)malloc(sizeof(EvenementRoue) * capacite);
+    if (!roue->evenements) {
+        roue->capacite = 0;
+        roue->libre = -1;
+        return 0;
+    }
+    roue->capacite = capacite;
+    for (c = 0; c < capacite; c++)
+        roue->evenements[c].suivant = (c + 1 < capacite) ? c + 1 : -1;
+    roue->libre = 0;
+    return 1;
+}
+
+/**
+ * Vide la roue et la place au pas correspondant à la date t.
+ */
+void roue_vider(RoueTemporelle* roue, double t) {
+    int n, c;
+    for (n = 0; n < ROUE_NIVEAUX; n++)
+        for (c = 0; c < ROUE_CASES; c++)
+            roue->cases[n][c] = -1;
+    for (c = 0; c < roue->capacite; c++)
+        roue->evenements[c].suivant = (c + 1 < roue->capacite) ? c + 1 : -1;
+    roue->libre = roue->capacite > 0 ? 0 : -1;
+    roue->nbPlanifies = 0;
+    roue->maintenant = (long long)floor(t / roue->pas + 1e-9);
+}
+
+void roue_liberer(RoueTemporelle* roue) {
+    free(roue->evenements);
+    roue->evenements = NULL;
+    roue->capacite = 0;
+    roue->libre = -1;
+}
+
+/* Range un événement dans la case correspondant à son écart avec la date courante */
+static void roue_ranger(RoueTemporelle* roue, int e) {
+    long long echeance = roue->evenements[e].echeance;
+    long long ecart = echeance - roue->maintenant;
+    int niveau = 0;
+    while (niveau < ROUE_NIVEAUX - 1 && ecart >= (1LL << (ROUE_BITS * (niveau + 1))))
+        niveau++;
+    // Au-delà du dernier niveau, l'événement attend dans la case la plus lointaine et sera re-rangé
+    if (ecart >= (1LL << (ROUE_BITS * ROUE_NIVEAUX)))
+        echeance = roue->maintenant + (1LL << (ROUE_BITS * ROUE_NIVEAUX)) - 1;
+    int c = (int)((echeance >> (ROUE_BITS * niveau)) & (ROUE_CASES - 1));
+    roue->evenements[e].suivant = roue->cases[niveau][c];
+    roue->cases[niveau][c] = e;
+}
+
+/**
+ * Planifie un événement pour le feu donné à la date (en secondes).
+ */
+int roue_planifier(RoueTemporelle* roue, double date, int feu) {
+    if (roue->libre < 0) {
+        int capacite = roue->capacite ? roue->capacite * 2 : 16, c;
+        EvenementRoue* e = (EvenementRoue*)realloc(roue->evenements, sizeof(EvenementRoue) * capacite);
+        if (!e) return 0;
+        for (c = roue->capacite; c < capacite; c++)
+            e[c].suivant = (c + 1 < capacite) ? c + 1 : -1;
+        roue->libre = roue->capacite;
+        roue->evenements = e;
+        roue->capacite = capacite;
+    }
+    int e = roue->libre;
+    roue->libre = roue->evenements[e].suivant;
+    roue->evenements[e].echeance = (long long)ceil(date / roue->pas - 1e-9);
+    if (roue->evenements[e].echeance <= roue->maintenant)
+        roue->evenements[e].echeance = roue->maintenant + 1;
+    roue->evenements[e].date = date;
+    roue->evenements[e].feu = feu;
+    roue->nbPlanifies++;
+    roue_ranger(roue, e);
+    return 1;
+}
+
+/**
+ * Avance la roue jusqu'à la date (en secondes) et appelle 'declencher' pour chaque
+ * événement échu, dans l'ordre des pas, avec sa date exacte. Le rappel peut planifier
+ * de nouveaux événements.
+ */
+void roue_avancer(RoueTemporelle* roue, double date, void (*declencher)(void* contexte, int feu, double date), void* contexte) {
+    long long cible = (long long)floor(date / roue->pas + 1e-9);
+    while (roue->maintenant < cible) {
+        int niveau;
+        roue->maintenant++;
+        // Descente des niveaux supérieurs quand la roue inférieure boucle
+        for (niveau = 1; niveau < ROUE_NIVEAUX; niveau++) {
+            if (roue->maintenant & ((1LL << (ROUE_BITS * niveau)) - 1))
+                break;
+            int c = (int)((roue->maintenant >> (ROUE_BITS * niveau)) & (ROUE_CASES - 1));
+            int e = roue->cases[niveau][c];
+            roue->cases[niveau][c] = -1;
+            while (e >= 0) {
+                int suivant = roue->evenements[e].suivant;
+                roue_ranger(roue, e);
+                e = suivant;
+            }
+        }
+        // Déclenchement des événements de la case courante
+        int c = (int)(roue->maintenant & (ROUE_CASES - 1));
+        int e = roue->cases[0][c];
+        roue->cases[0][c] = -1;
+        while (e >= 0) {
+            int suivant = roue->evenements[e].suivant;
+            if (roue->evenements[e].echeance > roue->maintenant) {
+                roue_ranger(roue, e);  // Événement au-delà de l'horizon de la roue
+            } else {
+                int feu = roue->evenements[e].feu;
+                double dateEvenement = roue->evenements[e].date;
+                roue->evenements[e].suivant = roue->libre;
+                roue->libre = e;
+                roue->nbPlanifies--;
+                if (declencher)
+                    declencher(contexte, feu, dateEvenement);
+            }
+            e = suivant;
+        }
+    }
+}
+
+/* ===================== Pilotage des feux par la roue ===================== */
+
+typedef struct {
+    RoueTemporelle* roue;
+    FeuRouge* feux;
+} ContexteFeux;
+
+/* Changement de phase : mise à jour du feu et planification du changement suivant */
+static void feux_changement_phase(void* contexte, int id, double date) {
+    ContexteFeux* c = (ContexteFeux*)contexte;
+    FeuRouge* feu = &c->feux[id];
+    feu_actualiser(feu, date);
+    double restant = feu_temps_restant(feu, date);
+    if (!isinf(restant))
+        roue_planifier(c->roue, date + restant, id);
+}
+
+/**
+ * Vide la roue, initialise l'état de tous les feux à la date t et planifie leur prochain changement de phase.
+ */
+void feux_planifier(RoueTemporelle* roue, FeuRouge* feux, int nbFeux, double t) {
+    int i;
+    roue_vider(roue, t);
+    for (i = 0; i < nbFeux; i++) {
+        feu_actualiser(&feux[i], t);
+        double restant = feu_temps_restant(&feux[i], t);
+        if (!isinf(restant))
+            roue_planifier(roue, t + restant, i);
+    }
+}
+
+/**
+ * Fait avancer les feux jusqu'à la date t : seuls les feux qui changent de phase sont touchés.
+ */
+void feux_avancer(RoueTemporelle* roue, FeuRouge* feux, double t) {
+    ContexteFeux c = { roue, feux };
+    roue_avancer(roue, t, feux_changement_phase, &c);
+}
+
+#endif
@@ -0,0 +1,501 @@
+#ifndef FORMAT_CARTE_H
+#define FORMAT_CARTE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <limits.h>
+#include <stdint.h>
+
+/* ===================== Fichiers de carte ===================== */
+/*
+ * Format texte : une ligne par élément, champs séparés par des virgules, '#' pour les commentaires.
+ *
+ *   C,nbNoeuds,nbAretes,nbFeux                        (facultatif : nombre minimal de nœuds et tailles à réserver)
+ *   N,id,x,y,nom,type                                 nœud
+ *   A,source,destination[,distance[,prioritaire[,capacite[,drapeaux]]]]   arête
+ *   F,id,position,etat,dureeRouge,dureeVert           feu rouge (etat : 1 = rouge au départ)
+ *
+ * Une distance vide ou '-' vaut la distance euclidienne entre les deux nœuds. Les drapeaux
+ * d'une arête sont CARTE_FEU, CARTE_EMBOUTEILLAGE et CARTE_PASSAGERS (somme).
+ *
+ * Format binaire : en-tête "CART", version, nombres d'éléments, puis les tableaux tels qu'ils
+ * sont en mémoire ; le chargement se résume à quelques fread.
+ *
+ * Les deux frontaux convertissent ensuite la carte dans leur propre structure de graphe.
+ */
+
+#define CARTE_FEU           1
+#define CARTE_EMBOUTEILLAGE 2
+#define CARTE_PASSAGERS     4
+#define CARTE_VERSION       1
+#define CARTE_MAX_ELEMENTS  (1 << 26)  // Borne des identifiants de nœud et de feu, et des tailles de la ligne C
+
+typedef struct {
+    int x, y;
+    int nom;       // Position du nom dans les textes de la carte, -1 si le nœud n'est pas défini
+    int type;
+} NoeudCarte;
+
+typedef struct {
+    int source, destination;
+    double distance;  // < 0 jusqu'à la fin du chargement si elle est déduite des coordonnées
+    int prioritaire;
+    int capacite;
+    int drapeaux;
+    int reserve;      // Toujours 0 : bourrage explicite, écrit tel quel par le format binaire et les instantanés
+} AreteCarte;
+
+typedef struct {
+    int id, position, etat, dureeRouge, dureeVert;
+} FeuCarte;
+
+typedef struct {
+    int nbNoeuds, nbAretes, nbFeux, tailleTextes;
+    int capaciteNoeuds, capaciteAretes, capaciteFeux, capaciteTextes;
+    NoeudCarte* noeuds;
+    AreteCarte* aretes;
+    FeuCarte* feux;
+    char* textes;     // Noms et types, terminés par '\0'
+} Carte;
+
+void carte_init(Carte* c) {
+    memset(c, 0, sizeof(Carte));
+}
+
+void carte_liberer(Carte* c) {
+    free(c->noeuds);
+    free(c->aretes);
+    free(c->feux);
+    free(c->textes);
+    carte_init(c);
+}
+
+/* Nom ou type d'un nœud ("" s'il n'est pas défini) */
+const char* carte_texte(const Carte* c, int position) {
+    return position >= 0 ? c->textes + position : "";
+}
+
+/* Agrandit un tableau pour contenir au moins 'besoin' éléments (capacité doublée, sans dépasser INT_MAX) */
+static int carte_reserver(void** tableau, int* capacite, int besoin, size_t taille) {
+    if (besoin <= *capacite) return 1;
+    if (besoin < 0) return 0;
+    size_t nouvelle = *capacite ? (size_t)*capacite : 64;
+    while (nouvelle < (size_t)besoin) nouvelle *= 2;
+    if (nouvelle > INT_MAX) nouvelle = INT_MAX;
+    if (nouvelle > SIZE_MAX / taille) return 0;
+    void* t = realloc(*tableau, taille * nouvelle);
+    if (!t) return 0;
+    *tableau = t;
+    *capacite = (int)nouvelle;
+    return 1;
+}
+
+/* Réserve de la place pour n nœuds, m arêtes et f feux (ligne C du format texte) */
+int carte_reserver_tailles(Carte* c, int n, int m, int f) {
+    return carte_reserver((void**)&c->noeuds, &c->capaciteNoeuds, n, sizeof(NoeudCarte)) &&
+           carte_reserver((void**)&c->aretes, &c->capaciteAretes, m, sizeof(AreteCarte)) &&
+           carte_reserver((void**)&c->feux, &c->capaciteFeux, f, sizeof(FeuCarte));
+}
+
+static int carte_ajouter_texte(Carte* c, const char* s, int longueur) {
+    if (!carte_reserver((void**)&c->textes, &c->capaciteTextes, c->tailleTextes + longueur + 1, 1))
+        return -1;
+    int position = c->tailleTextes;
+    memcpy(c->textes + position, s, longueur);
+    c->textes[position + longueur] = '\0';
+    c->tailleTextes += longueur + 1;
+    return position;
+}
+
+/* Porte le nombre de nœuds à au moins n ; les nouveaux nœuds sont vides (non définis) */
+int carte_etendre_noeuds(Carte* c, int n) {
+    if (n <= c->nbNoeuds) return 1;
+    if (!carte_reserver((void**)&c->noeuds, &c->capaciteNoeuds, n, sizeof(NoeudCarte)))
+        return 0;
+    while (c->nbNoeuds < n) {
+        NoeudCarte* vide = &c->noeuds[c->nbNoeuds++];
+        vide->x = vide->y = 0;
+        vide->nom = vide->type = -1;
+    }
+    return 1;
+}
+
+/**
+ * Définit le nœud 'id' ; les nœuds d'indice inférieur non encore définis sont créés vides.
+ * 'nom' et 'type' peuvent ne pas être terminés par '\0' (longueurs données).
+ */
+int carte_ajouter_noeud(Carte* c, int id, int x, int y, const char* nom, int longueurNom, const char* type, int longueurType) {
+    if (id < 0 || id >= CARTE_MAX_ELEMENTS || !carte_etendre_noeuds(c, id + 1)) return 0;
+    NoeudCarte* noeud = &c->noeuds[id];
+    noeud->x = x;
+    noeud->y = y;
+    noeud->nom = carte_ajouter_texte(c, nom, longueurNom);
+    noeud->type = carte_ajouter_texte(c, type, longueurType);
+    return noeud->nom >= 0 && noeud->type >= 0;
+}
+
+/* Ajoute une arête (distance < 0 : distance euclidienne calculée en fin de chargement) */
+int carte_ajouter_arete(Carte* c, int source, int destination, double distance, int prioritaire, int capacite, int drapeaux) {
+    if (!carte_reserver((void**)&c->aretes, &c->capaciteAretes, c->nbAretes + 1, sizeof(AreteCarte)))
+        return 0;
+    AreteCarte* a = &c->aretes[c->nbAretes++];
+    memset(a, 0, sizeof(AreteCarte));
+    a->source = source;
+    a->destination = destination;
+    a->distance = distance;
+    a->prioritaire = prioritaire;
+    a->capacite = capacite;
+    a->drapeaux = drapeaux;
+    return 1;
+}
+
+int carte_ajouter_feu(Carte* c, int id, int position, int etat, int dureeRouge, int dureeVert) {
+    if (id < 0 || id >= CARTE_MAX_ELEMENTS ||
+        !carte_reserver((void**)&c->feux, &c->capaciteFeux, c->nbFeux + 1, sizeof(FeuCarte)))
+        return 0;
+    FeuCarte* f = &c->feux[c->nbFeux++];
+    f->id = id;
+    f->position = position;
+    f->etat = etat;
+    f->dureeRouge = dureeRouge;
+    f->dureeVert = dureeVert;
+    return 1;
+}
+
+/* Nombre de feux à prévoir dans un graphe : les identifiants des feux peuvent laisser des trous */
+int carte_nb_feux(const Carte* c) {
+    int i, n = 0;
+    for (i = 0; i < c->nbFeux; i++)
+        if (c->feux[i].id + 1 > n) n = c->feux[i].id + 1;
+    return n;
+}
+
+/* Vérifie que les arêtes et les feux désignent des nœuds existants, et les noms et types des
+   textes existants ; retourne 0 sinon */
+static int carte_verifier(const Carte* c, char* erreur, size_t tailleErreur) {
+    int i;
+    for (i = 0; i < c->nbAretes; i++) {
+        const AreteCarte* a = &c->aretes[i];
+        if (a->source < 0 || a->source >= c->nbNoeuds || a->destination < 0 || a->destination >= c->nbNoeuds) {
+            if (erreur) snprintf(erreur, tailleErreur, "arete %d : noeud inexistant (%d -> %d)", i, a->source, a->destination);
+            return 0;
+        }
+    }
+    for (i = 0; i < c->nbFeux; i++) {
+        if (c->feux[i].id < 0 || c->feux[i].id >= CARTE_MAX_ELEMENTS || c->feux[i].position < 0 ||
+            c->feux[i].position >= c->nbNoeuds) {
+            if (erreur) snprintf(erreur, tailleErreur, "feu %d : noeud inexistant (%d)", c->feux[i].id, c->feux[i].position);
+            return 0;
+        }
+    }
+    // Noms et types : dans la table des textes, qui se termine par '\0' (fichier binaire tronqué ou corrompu)
+    for (i = 0; i < c->nbNoeuds; i++) {
+        const NoeudCarte* noeud = &c->noeuds[i];
+        if (noeud->nom < -1 || noeud->nom >= c->tailleTextes || noeud->type < -1 || noeud->type >= c->tailleTextes) {
+            if (erreur) snprintf(erreur, tailleErreur, "noeud %d : nom ou type hors des textes", i);
+            return 0;
+        }
+    }
+    if (c->tailleTextes > 0 && c->textes[c->tailleTextes - 1] != '\0') {
+        if (erreur) snprintf(erreur, tailleErreur, "textes non termines");
+        return 0;
+    }
+    return 1;
+}
+
+/* Distances déduites des coordonnées, une fois tous les nœuds connus (arêtes déjà vérifiées) */
+static void carte_completer_distances(Carte* c) {
+    int i;
+    for (i = 0; i < c->nbAretes; i++) {
+        AreteCarte* a = &c->aretes[i];
+        if (a->distance >= 0) continue;
+        const NoeudCarte* s = &c->noeuds[a->source];
+        const NoeudCarte* d = &c->noeuds[a->destination];
+        a->distance = sqrt((double)(s->x - d->x) * (s->x - d->x) + (double)(s->y - d->y) * (s->y - d->y));
+    }
+}
+
+/* ----- Lecture du format texte ----- */
+
+/* Découpe une ligne en champs (pointeurs et longueurs) sans copie ; retourne le nombre de champs */
+static int carte_champs(char* ligne, char* fin, char** champs, int* longueurs, int max) {
+    int n = 0;
+    char* p = ligne;
+    while (n < max) {
+        char* debut = p;
+        while (p < fin && *p != ',') p++;
+        champs[n] = debut;
+        longueurs[n] = (int)(p - debut);
+        // Espaces de bord ignorés
+        while (longueurs[n] > 0 && (champs[n][0] == ' ' || champs[n][0] == '\t')) { champs[n]++; longueurs[n]--; }
+        while (longueurs[n] > 0 && (champs[n][longueurs[n] - 1] == ' ' || champs[n][longueurs[n] - 1] == '\t' ||
+                                     champs[n][longueurs[n] - 1] == '\r')) longueurs[n]--;
+        n++;
+        if (p >= fin) break;
+        p++;
+    }
+    return n;
+}
+
+/* Entier décimal ; retourne 0 si le champ n'est pas un entier */
+static int carte_entier(const char* s, int longueur, int* valeur) {
+    int i = 0, signe = 1;
+    long v = 0;
+    if (longueur > 0 && (s[0] == '-' || s[0] == '+')) { signe = (s[0] == '-') ? -1 : 1; i = 1; }
+    if (i >= longueur) return 0;
+    for (; i < longueur; i++) {
+        if (s[i] < '0' || s[i] > '9') return 0;
+        v = v * 10 + (s[i] - '0');
+        if (v > 2147483647L) return 0;
+    }
+    *valeur = (int)(signe * v);
+    return 1;
+}
+
+/* Réel : chemin rapide pour la forme [-]chiffres[.chiffres], strtod pour le reste */
+static int carte_reel(char* s, int longueur, double* valeur) {
+    int i = 0, chiffres = 0;
+    double v = 0.0, signe = 1.0;
+    if (longueur > 0 && (s[0] == '-' || s[0] == '+')) { signe = (s[0] == '-') ? -1.0 : 1.0; i = 1; }
+    for (; i < longueur && s[i] >= '0' && s[i] <= '9'; i++, chiffres++)
+        v = v * 10.0 + (s[i] - '0');
+    if (i < longueur && s[i] == '.') {
+        double echelle = 1.0;
+        long fraction = 0;
+        int n = 0;
+        for (i++; i < longueur && s[i] >= '0' && s[i] <= '9'; i++, chiffres++) {
+            if (n < 15) { fraction = fraction * 10 + (s[i] - '0'); echelle *= 10.0; n++; }
+        }
+        v += fraction / echelle;
+    }
+    if (i == longueur && chiffres > 0) {
+        *valeur = signe * v;
+        return 1;
+    }
+    // Exposant ou autre écriture : strtod sur une copie terminée par '\0'
+    char tampon[64];
+    char* finLecture;
+    if (longueur <= 0 || longueur >= (int)sizeof(tampon)) return 0;
+    memcpy(tampon, s, longueur);
+    tampon[longueur] = '\0';
+    *valeur = strtod(tampon, &finLecture);
+    return finLecture == tampon + longueur;
+}
+
+/* Traite une ligne du format texte ; retourne 0 si elle est invalide */
+static int carte_ligne(Carte* c, char* ligne, char* fin) {
+    char* champs[8];
+    int longueurs[8];
+    int n = carte_champs(ligne, fin, champs, longueurs, 8);
+    if (longueurs[0] == 0 || champs[0][0] == '#')
+        return 1; // Ligne vide ou commentaire
+    if (longueurs[0] != 1) return 0;
+    int v[5] = { 0, 0, 0, 0, 0 }, i;
+    switch (champs[0][0]) {
+    case 'C':
+        if (n < 4) return 0;
+        for (i = 0; i < 3; i++)
+            if (!carte_entier(champs[i + 1], longueurs[i + 1], &v[i]) || v[i] < 0 || v[i] > CARTE_MAX_ELEMENTS)
+                return 0;
+        return carte_reserver_tailles(c, v[0], v[1], v[2]) && carte_etendre_noeuds(c, v[0]);
+    case 'N':
+        if (n < 6) return 0;
+        for (i = 0; i < 3; i++)
+            if (!carte_entier(champs[i + 1], longueurs[i + 1], &v[i])) return 0;
+        return carte_ajouter_noeud(c, v[0], v[1], v[2], champs[4], longueurs[4], champs[5], longueurs[5]);
+    case 'A': {
+        double distance = -1.0;
+        if (n < 3 || !carte_entier(champs[1], longueurs[1], &v[0]) || !carte_entier(champs[2], longueurs[2], &v[1]))
+            return 0;
+        if (n > 3 && longueurs[3] > 0 && !(longueurs[3] == 1 && champs[3][0] == '-') &&
+            (!carte_reel(champs[3], longueurs[3], &distance) || distance < 0))
+            return 0;
+        for (i = 4; i < n && i < 7; i++)
+            if (longueurs[i] > 0 && !carte_entier(champs[i], longueurs[i], &v[i - 2])) return 0;
+        return carte_ajouter_arete(c, v[0], v[1], distance, v[2], v[3], v[4]);
+    }
+    case 'F':
+        if (n < 6) return 0;
+        for (i = 0; i < 5; i++)
+            if (!carte_entier(champs[i + 1], longueurs[i + 1], &v[i])) return 0;
+        return carte_ajouter_feu(c, v[0], v[1], v[2], v[3], v[4]);
+    }
+    return 0;
+}
+
+/**
+ * Charge une carte au format texte. Le fichier est lu par blocs de 1 Mo et découpé sur place :
+ * seules les lignes à cheval sur deux blocs sont déplacées. En cas d'erreur, 'erreur' reçoit
+ * un message avec le numéro de ligne.
+ */
+int carte_charger_texte(Carte* c, const char* fichier, char* erreur, size_t tailleErreur) {
+    const size_t TAILLE_LECTURE = 1 << 20;
+    FILE* f = fopen(fichier, "rb");
+    carte_init(c);
+    if (!f) {
+        if (erreur) snprintf(erreur, tailleErreur, "impossible d'ouvrir %s", fichier);
+        return 0;
+    }
+    char* tampon = (char*)malloc(TAILLE_LECTURE);
+    size_t reste = 0;   // Début de ligne incomplète conservé en tête du tampon
+    long numero = 0;
+    int ok = tampon != NULL, finFichier = 0;
+    while (ok && !finFichier) {
+        size_t lus = fread(tampon + reste, 1, TAILLE_LECTURE - reste, f);
+        size_t taille = reste + lus;
+        finFichier = (lus == 0);
+        char* p = tampon;
+        char* limite = tampon + taille;
+        for (;;) {
+            char* nl = (char*)memchr(p, '\n', limite - p);
+            if (!nl) {
+                // Dernière ligne sans retour à la ligne, ou ligne à compléter par le bloc suivant
+                if (finFichier && p < limite) {
+                    numero++;
+                    ok = carte_ligne(c, p, limite);
+                    p = limite;
+                }
+                break;
+            }
+            numero++;
+            if (!carte_ligne(c, p, nl)) {
+                ok = 0;
+                break;
+            }
+            p = nl + 1;
+        }
+        reste = limite - p;
+        if (ok && reste == TAILLE_LECTURE) {
+            ok = 0; // Ligne plus longue que le tampon
+            break;
+        }
+        memmove(tampon, p, reste);
+    }
+    if (!ok && erreur)
+        snprintf(erreur, tailleErreur, "%s : ligne %ld invalide", fichier, numero);
+    free(tampon);
+    fclose(f);
+    if (ok && !carte_verifier(c, erreur, tailleErreur))
+        ok = 0;
+    if (!ok) {
+        carte_liberer(c);
+        return 0;
+    }
+    carte_completer_distances(c);
+    return 1;
+}
+
+/* ----- Format binaire ----- */
+
+/* Écrit ou lit n éléments ; un tableau vide peut ne pas être alloué (pointeur NULL) */
+static int carte_fwrite(const void* tableau, size_t taille, int n, FILE* f) {
+    return n == 0 || fwrite(tableau, taille, n, f) == (size_t)n;
+}
+
+static int carte_fread(void* tableau, size_t taille, int n, FILE* f) {
+    return n == 0 || fread(tableau, taille, n, f) == (size_t)n;
+}
+
+/**
+ * Écrit la carte au format binaire. Retourne 0 en cas d'erreur d'écriture.
+ */
+int carte_ecrire_binaire(const Carte* c, const char* fichier) {
+    FILE* f = fopen(fichier, "wb");
+    if (!f) return 0;
+    int entete[5] = { CARTE_VERSION, c->nbNoeuds, c->nbAretes, c->nbFeux, c->tailleTextes };
+    int ok = fwrite("CART", 1, 4, f) == 4 &&
+             fwrite(entete, sizeof(int), 5, f) == 5 &&
+             carte_fwrite(c->noeuds, sizeof(NoeudCarte), c->nbNoeuds, f) &&
+             carte_fwrite(c->aretes, sizeof(AreteCarte), c->nbAretes, f) &&
+             carte_fwrite(c->feux, sizeof(FeuCarte), c->nbFeux, f) &&
+             carte_fwrite(c->textes, 1, c->tailleTextes, f);
+    return (fclose(f) == 0) && ok;
+}
+
+/**
+ * Charge une carte au format binaire (même architecture que la machine qui l'a écrite).
+ */
+int carte_charger_binaire(Carte* c, const char* fichier, char* erreur, size_t tailleErreur) {
+    FILE* f = fopen(fichier, "rb");
+    char magie[4];
+    int entete[5];
+    carte_init(c);
+    if (!f) {
+        if (erreur) snprintf(erreur, tailleErreur, "impossible d'ouvrir %s", fichier);
+        return 0;
+    }
+    int ok = fread(magie, 1, 4, f) == 4 && memcmp(magie, "CART", 4) == 0 &&
+             fread(entete, sizeof(int), 5, f) == 5 && entete[0] == CARTE_VERSION &&
+             entete[1] >= 0 && entete[2] >= 0 && entete[3] >= 0 && entete[4] >= 0;
+    if (ok) {
+        // Les tableaux annoncés doivent tenir dans le fichier : pas d'allocation démesurée sur un en-tête faux
+        unsigned long long attendu = 4 + sizeof(entete) + (unsigned long long)entete[1] * sizeof(NoeudCarte) +
+                                     (unsigned long long)entete[2] * sizeof(AreteCarte) +
+                                     (unsigned long long)entete[3] * sizeof(FeuCarte) + (unsigned long long)entete[4];
+        long position = ftell(f);
+        ok = position >= 0 && fseek(f, 0, SEEK_END) == 0 && ftell(f) >= 0 &&
+             (unsigned long long)ftell(f) >= attendu && fseek(f, position, SEEK_SET) == 0;
+    }
+    ok = ok && carte_reserver_tailles(c, entete[1], entete[2], entete[3]) &&
+             carte_reserver((void**)&c->textes, &c->capaciteTextes, entete[4], 1);
+    if (ok) {
+        c->nbNoeuds = entete[1];
+        c->nbAretes = entete[2];
+        c->nbFeux = entete[3];
+        c->tailleTextes = entete[4];
+        ok = carte_fread(c->noeuds, sizeof(NoeudCarte), c->nbNoeuds, f) &&
+             carte_fread(c->aretes, sizeof(AreteCarte), c->nbAretes, f) &&
+             carte_fread(c->feux, sizeof(FeuCarte), c->nbFeux, f) &&
+             carte_fread(c->textes, 1, c->tailleTextes, f);
+    }
+    fclose(f);
+    if (!ok && erreur)
+        snprintf(erreur, tailleErreur, "%s : fichier binaire invalide", fichier);
+    if (ok && !carte_verifier(c, erreur, tailleErreur))
+        ok = 0;
+    if (!ok)
+        carte_liberer(c);
+    return ok;
+}
+
+/**
+ * Charge une carte en reconnaissant son format (binaire si le fichier commence par "CART").
+ */
+int carte_charger(Carte* c, const char* fichier, char* erreur, size_t tailleErreur) {
+    char magie[4] = { 0, 0, 0, 0 };
+    FILE* f = fopen(fichier, "rb");
+    if (f) {
+        size_t lus = fread(magie, 1, 4, f);
+        fclose(f);
+        if (lus == 4 && memcmp(magie, "CART", 4) == 0)
+            return carte_charger_binaire(c, fichier, erreur, tailleErreur);
+    }
+    return carte_charger_texte(c, fichier, erreur, tailleErreur);
+}
+
+/**
+ * Écrit la carte au format texte (distances explicites, nœuds non définis omis).
+ */
+int carte_ecrire_texte(const Carte* c, const char* fichier) {
+    FILE* f = fopen(fichier, "w");
+    int i;
+    if (!f) return 0;
+    fprintf(f, "C,%d,%d,%d\n", c->nbNoeuds, c->nbAretes, c->nbFeux);
+    for (i = 0; i < c->nbNoeuds; i++)
+        if (c->noeuds[i].nom >= 0)
+            fprintf(f, "N,%d,%d,%d,%s,%s\n", i, c->noeuds[i].x, c->noeuds[i].y,
+                    carte_texte(c, c->noeuds[i].nom), carte_texte(c, c->noeuds[i].type));
+    for (i = 0; i < c->nbAretes; i++) {
+        const AreteCarte* a = &c->aretes[i];
+        fprintf(f, "A,%d,%d,%.17g,%d,%d,%d\n", a->source, a->destination, a->distance, a->prioritaire, a->capacite, a->drapeaux);
+    }
+    for (i = 0; i < c->nbFeux; i++) {
+        const FeuCarte* fe = &c->feux[i];
+        fprintf(f, "F,%d,%d,%d,%d,%d\n", fe->id, fe->position, fe->etat, fe->dureeRouge, fe->dureeVert);
+    }
+    return fclose(f) == 0;
+}
+
+#endif
@@ -0,0 +1,122 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "FormatCarte.h"
+#include "Instantane.h"
+
+/* ===================== Générateur de carte embarquée ===================== */
+/*
+ * Convertit une carte (texte ou binaire) en un fichier C de tableaux statiques : nœuds, arêtes
+ * et feux aux types de Graphe.h, adjacence compacte (CSR) et index des feux par nœud. Compilé
+ * dans l'interface graphique avec -DCARTE_EMBARQUEE, il remplace le chargement de la carte :
+ * le démarrage ne lit aucun fichier et n'alloue rien pour le graphe.
+ *
+ * Usage : generer_carte carte.txt sortie.h
+ */
+
+/* Chaîne C littérale, tronquée comme dans graphe_depuis_carte (49 caractères) */
+static void ecrire_chaine(FILE* f, const char* s) {
+    int i;
+    fputc('"', f);
+    for (i = 0; s[i] && i < 49; i++) {
+        unsigned char c = (unsigned char)s[i];
+        if (c == '"' || c == '\\') fprintf(f, "\\%c", c);
+        else if (c < 32 || c > 126) fprintf(f, "\\%03o", c); // Octal : pas d'ambiguïté avec le caractère suivant
+        else fputc(c, f);
+    }
+    fputc('"', f);
+}
+
+/* Tableau d'entiers, 16 valeurs par ligne (au moins une valeur : pas de tableau vide en C) */
+static void ecrire_entiers(FILE* f, const char* nom, const int* valeurs, int n) {
+    int i;
+    fprintf(f, "static const int %s[%d] = {", nom, n > 0 ? n : 1);
+    for (i = 0; i < n; i++)
+        fprintf(f, "%s%d,", (i % 16) ? " " : "\n    ", valeurs[i]);
+    fprintf(f, "%s\n};\n\n", n > 0 ? "" : " 0");
+}
+
+static void ecrire_reels(FILE* f, const char* nom, const double* valeurs, int n) {
+    int i;
+    fprintf(f, "static const double %s[%d] = {", nom, n > 0 ? n : 1);
+    for (i = 0; i < n; i++)
+        fprintf(f, "%s%.17g,", (i % 8) ? " " : "\n    ", valeurs[i]);
+    fprintf(f, "%s\n};\n\n", n > 0 ? "" : " 0");
+}
+
+int generer_carte(const Carte* carte, const char* source, FILE* f) {
+    Reseau* r;
+    FeuRouge* feux;
+    IndexFeux index;
+    int i, n = carte->nbNoeuds, m = carte->nbAretes, nbFeux = carte_nb_feux(carte);
+    if (!carte_construire_reseau(carte, &r, &feux, &index))
+        return 0;
+    fprintf(f, "/* Fichier généré par GenerateurCarte depuis %s : ne pas modifier */\n", source);
+    fprintf(f, "#ifndef CARTE_EMBARQUEE_H\n#define CARTE_EMBARQUEE_H\n\n");
+    fprintf(f, "#define CARTE_NB_NOEUDS %d\n#define CARTE_NB_ARETES %d\n#define CARTE_NB_FEUX %d\n\n", n, m, nbFeux);
+
+    // Nœuds, arêtes et feux : types de Graphe.h, modifiables (état des feux pendant l'animation)
+    fprintf(f, "static Noeud carte_noeuds[%d] = {\n", n > 0 ? n : 1);
+    for (i = 0; i < n; i++) {
+        fprintf(f, "    { %d, ", i);
+        ecrire_chaine(f, carte_texte(carte, carte->noeuds[i].nom));
+        fprintf(f, ", ");
+        ecrire_chaine(f, carte_texte(carte, carte->noeuds[i].type));
+        fprintf(f, ", %d, %d },\n", carte->noeuds[i].x, carte->noeuds[i].y);
+    }
+    fprintf(f, "%s};\n\n", n > 0 ? "" : "    { 0 }\n");
+    fprintf(f, "static Arete carte_aretes[%d] = {\n", m > 0 ? m : 1);
+    for (i = 0; i < m; i++) {
+        const AreteCarte* a = &carte->aretes[i];
+        fprintf(f, "    { %d, %d, %.17g, %d, %d, %d },\n", a->source, a->destination, a->distance,
+                (a->drapeaux & CARTE_EMBOUTEILLAGE) != 0, (a->drapeaux & CARTE_FEU) != 0,
+                (a->drapeaux & CARTE_PASSAGERS) != 0);
+    }
+    fprintf(f, "%s};\n\n", m > 0 ? "" : "    { 0 }\n");
+    fprintf(f, "static FeuRouge carte_feux[%d] = {\n", nbFeux > 0 ? nbFeux : 1);
+    for (i = 0; i < nbFeux; i++)
+        fprintf(f, "    { %d, %d, %d, %d, %d, %d, %d },\n", feux[i].ID, feux[i].PositionNoeud, feux[i].Etat,
+                feux[i].DureeRouge, feux[i].DureeVert, feux[i].TempsRestant, feux[i].Decalage);
+    fprintf(f, "%s};\n\n", nbFeux > 0 ? "" : "    { 0 }\n");
+
+    // Adjacence compacte et index des feux, en lecture seule
+    ecrire_entiers(f, "carte_debut", r->debut, n + 1);
+    ecrire_entiers(f, "carte_cible", r->cible, r->nbAretes);
+    ecrire_reels(f, "carte_poids", r->poids, r->nbAretes);
+    ecrire_entiers(f, "carte_id_arete", r->idArete, r->nbAretes);
+    ecrire_entiers(f, "carte_x", r->X, n);
+    ecrire_entiers(f, "carte_y", r->Y, n);
+    ecrire_entiers(f, "carte_index_debut", index.debut, n + 1);
+    ecrire_entiers(f, "carte_index_feux", index.feux, index.debut[n]);
+
+    fprintf(f, "static Graphe carte_graphe = { CARTE_NB_NOEUDS, CARTE_NB_ARETES, CARTE_NB_FEUX, "
+               "carte_noeuds, carte_aretes, carte_feux };\n");
+    fprintf(f, "static Reseau carte_reseau = { CARTE_NB_NOEUDS, %d, (int*)carte_debut, (int*)carte_cible, "
+               "(double*)carte_poids,\n    (int*)carte_id_arete, (int*)carte_x, (int*)carte_y };\n", r->nbAretes);
+    fprintf(f, "static IndexFeux carte_index = { CARTE_NB_NOEUDS, (int*)carte_index_debut, (int*)carte_index_feux };\n\n");
+    fprintf(f, "#endif\n");
+    free(feux);
+    index_feux_liberer(&index);
+    reseau_liberer(r);
+    return 1;
+}
+
+int main(int argc, char** argv) {
+    Carte carte;
+    char erreur[256];
+    if (argc < 3) {
+        printf("Usage : %s carte sortie.h\n", argv[0]);
+        return 1;
+    }
+    if (!carte_charger(&carte, argv[1], erreur, sizeof(erreur))) {
+        printf("Erreur lors du chargement de la carte : %s\n", erreur);
+        return 1;
+    }
+    FILE* f = fopen(argv[2], "w");
+    int ok = f && generer_carte(&carte, argv[1], f);
+    if (f) ok = (fclose(f) == 0) && ok;
+    printf("%s : %d noeuds, %d aretes, %d feux%s\n", argv[2], carte.nbNoeuds, carte.nbAretes, carte.nbFeux,
+           ok ? "" : " (erreur d'ecriture)");
+    carte_liberer(&carte);
+    return ok ? 0 : 1;
+}
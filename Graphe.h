@@ -2,6 +2,10 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include "Feux.h"
+#include "Reseau.h"
+#include "Fermetures.h"
+#include "FormatCarte.h"
 
 #define INF 1000000000
 
@@ -26,16 +30,6 @@ typedef struct {
     int passagers;
 } Arete;
 
-/* Structure pour représenter un feu rouge */
-typedef struct {
-    int ID;
-    int PositionNoeud;
-    int Etat;      // 0 = Vert, 1 = Rouge
-    int DureeRouge;
-    int DureeVert;
-    int TempsRestant;
-} FeuRouge;
-
 /* Structure pour représenter un graphe */
 typedef struct {
     int nbnoeuds;
@@ -61,7 +55,7 @@ Graphe* creergraphe(int Nbnoeuds, int Nbaretes, int NbFeux) {
     graph->nbFeux = NbFeux;
     graph->N = (Noeud*)malloc(sizeof(Noeud) * Nbnoeuds);
     graph->A = (Arete*)malloc(sizeof(Arete) * Nbaretes);
-    graph->F = (FeuRouge*)malloc(sizeof(FeuRouge) * NbFeux);
+    graph->F = (FeuRouge*)calloc(NbFeux > 0 ? NbFeux : 1, sizeof(FeuRouge)); // Feux non définis : toujours verts
     if (!graph->N || !graph->A || !graph->F) {
         printf("Erreur d'allocation mémoire !\n");
         if (graph->N) free(graph->N);
@@ -109,6 +103,7 @@ void ajouterarete(Graphe* graph, int indice, int source, int destination, double
 
 /**
  * Ajoute un feu rouge au graphe.
+ * Un feu créé rouge commence son cycle à la date 0, un feu créé vert commence par sa phase verte.
  */
 void ajouterFeuRouge(Graphe* graph, int id, int position, int etat, int dureeRouge, int dureeVert) {
     if (id >= graph->nbFeux) {
@@ -120,7 +115,8 @@ void ajouterFeuRouge(Graphe* graph, int id, int position, int etat, int dureeRou
     feu->Etat = etat;
     feu->DureeRouge = dureeRouge;
     feu->DureeVert = dureeVert;
-    feu->TempsRestant = dureeRouge;
+    feu->Decalage = etat ? 0 : dureeVert;
+    feu_actualiser(feu, 0.0);
 }
 
 /* ===================== Fonction utilitaire ===================== */
@@ -140,8 +136,8 @@ typedef struct {
     int longueur;   // Nombre de nœuds dans le chemin
 } CheminResult;
 
-/* Fonction Dijkstra */
-CheminResult dijkstra(Graphe* graph, int source, int target) {
+/* Fonction Dijkstra (fermetures peut être NULL) */
+CheminResult dijkstra(Graphe* graph, int source, int target, const Fermetures* fermetures) {
     CheminResult result;
     result.chemin = NULL;
     result.longueur = 0;
@@ -169,7 +165,7 @@ CheminResult dijkstra(Graphe* graph, int source, int target) {
             break;
         for(k = 0; k < graph->nbaretes; k++){
             Arete* a = &graph->A[k];
-            if(a->Source == u){
+            if(a->Source == u && !arete_fermee(fermetures, k)){
                 int v = a->Destination;
                 if(!visited[v]){
                     int alt = dist[u] + (int)a->Distance;
@@ -202,3 +198,69 @@ CheminResult dijkstra(Graphe* graph, int source, int target) {
     }
 }
 
+/**
+ * Construit le réseau compact (arêtes regroupées par nœud source) utilisé par les recherches rapides.
+ */
+Reseau* graphe_vers_reseau(Graphe* graph) {
+    int n = graph->nbnoeuds, m = graph->nbaretes, i;
+    int* sources = (int*)malloc(sizeof(int) * (m > 0 ? m : 1));
+    int* destinations = (int*)malloc(sizeof(int) * (m > 0 ? m : 1));
+    double* distances = (double*)malloc(sizeof(double) * (m > 0 ? m : 1));
+    int* X = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    int* Y = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    Reseau* r = NULL;
+    if (sources && destinations && distances && X && Y) {
+        for (i = 0; i < m; i++) {
+            sources[i] = graph->A[i].Source;
+            destinations[i] = graph->A[i].Destination;
+            distances[i] = graph->A[i].Distance;
+        }
+        for (i = 0; i < n; i++) {
+            X[i] = graph->N[i].X;
+            Y[i] = graph->N[i].Y;
+        }
+        r = reseau_creer(n, m, sources, destinations, distances, X, Y);
+    }
+    free(sources);
+    free(destinations);
+    free(distances);
+    free(X);
+    free(Y);
+    return r;
+}
+
+
+/**
+ * Crée le graphe décrit par une carte chargée depuis un fichier (voir FormatCarte.h).
+ * Les nœuds non définis par la carte restent vides, en (0, 0).
+ */
+Graphe* graphe_depuis_carte(const Carte* carte) {
+    int i;
+    int n = carte->nbNoeuds > 0 ? carte->nbNoeuds : 1, m = carte->nbAretes > 0 ? carte->nbAretes : 1;
+    Graphe* graph = creergraphe(n, m, carte_nb_feux(carte));
+    if (!graph) {
+        return NULL;
+    }
+    graph->nbnoeuds = carte->nbNoeuds;
+    graph->nbaretes = carte->nbAretes;
+    for (i = 0; i < carte->nbNoeuds; i++) {
+        Noeud* noeud = &graph->N[i];
+        noeud->ID = i;
+        snprintf(noeud->Nom, sizeof(noeud->Nom), "%s", carte_texte(carte, carte->noeuds[i].nom));
+        snprintf(noeud->Type, sizeof(noeud->Type), "%s", carte_texte(carte, carte->noeuds[i].type));
+        noeud->X = carte->noeuds[i].x;
+        noeud->Y = carte->noeuds[i].y;
+    }
+    for (i = 0; i < carte->nbAretes; i++) {
+        const AreteCarte* a = &carte->aretes[i];
+        ajouterarete(graph, i, a->source, a->destination, a->distance);
+        graph->A[i].feuxRouges = (a->drapeaux & CARTE_FEU) != 0;
+        graph->A[i].embouteillages = (a->drapeaux & CARTE_EMBOUTEILLAGE) != 0;
+        graph->A[i].passagers = (a->drapeaux & CARTE_PASSAGERS) != 0;
+    }
+    for (i = 0; i < carte->nbFeux; i++) {
+        const FeuCarte* f = &carte->feux[i];
+        ajouterFeuRouge(graph, f->id, f->position, f->etat, f->dureeRouge, f->dureeVert);
+    }
+    return graph;
+}
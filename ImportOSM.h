@@ -0,0 +1,553 @@
+#ifndef IMPORT_OSM_H
+#define IMPORT_OSM_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include "Chrono.h"
+#include "FormatCarte.h"
+#include "Renumerotation.h"
+
+/* ===================== Import d'extraits OpenStreetMap (XML) ===================== */
+/*
+ * Le fichier .osm est lu deux fois par tranches de taille fixe, sans jamais être chargé
+ * en entier. Chaque tranche est découpée en parts, qui sont analysées en parallèle (un
+ * thread par part). Les coupures tombent toujours avant une balise <node>, <way> ou
+ * <relation>.
+ *
+ *  1. Voies : les <way> carrossables (highway=...) sont retenues avec leurs références de nœuds,
+ *     leur sens unique et leur nombre de voies. Les références triées et dédoublonnées
+ *     donnent la numérotation compacte des nœuds.
+ *  2. Nœuds : seules les coordonnées des nœuds utilisés sont conservées. La lecture s'arrête
+ *     à la première <way> (les extraits rangent les nœuds avant les voies).
+ *
+ * La mémoire dépend du réseau routier retenu et non de la taille du fichier : une tranche par
+ * lecture, plus les références des voies carrossables. Chaque nœud garde son identifiant OSM
+ * comme nom pour retrouver sa correspondance. Les nœuds sont enfin renumérotés selon la courbe
+ * de Hilbert : l'ordre des identifiants OSM n'a aucun rapport avec la géographie.
+ */
+
+#define OSM_TAILLE_PART (4 << 20)   // Octets analysés par thread et par tranche
+#define OSM_RAYON_TERRE 6371000.0   // Mètres
+#define OSM_DEGRE (3.14159265358979323846 / 180.0)
+
+/* Classes de routes carrossables, capacité par voie (véhicules) et priorité */
+static const struct { const char* nom; int capacite; int prioritaire; } OSM_CLASSES[] = {
+    { "motorway", 60, 1 }, { "trunk", 50, 1 }, { "primary", 40, 1 }, { "secondary", 30, 0 },
+    { "tertiary", 25, 0 }, { "unclassified", 15, 0 }, { "residential", 15, 0 }, { "living_street", 5, 0 },
+    { "service", 5, 0 }, { "road", 15, 0 }, { "motorway_link", 40, 1 }, { "trunk_link", 30, 1 },
+    { "primary_link", 30, 1 }, { "secondary_link", 20, 0 }, { "tertiary_link", 20, 0 },
+};
+#define OSM_NB_CLASSES ((int)(sizeof(OSM_CLASSES) / sizeof(OSM_CLASSES[0])))
+
+/* Voie carrossable retenue : références [debut, debut + nbRefs) */
+typedef struct {
+    long debut;
+    int nbRefs;
+    signed char classe;
+    signed char sens;   // 1 : sens unique, -1 : sens unique inversé, 0 : double sens
+    unsigned char voies;
+} VoieOSM;
+
+/* Résultats d'une part (passe des voies), fusionnés après chaque tranche */
+typedef struct {
+    long long* refs;
+    long nbRefs, capaciteRefs;
+    VoieOSM* voies;
+    int nbVoies, capaciteVoies;
+} PartVoies;
+
+/* Travail d'un thread sur sa part de la tranche courante */
+typedef struct ImportOSM ImportOSM;
+typedef struct {
+    ImportOSM* import;
+    const char* debut;
+    const char* fin;
+    PartVoies voies;
+    int erreur;          // Mémoire épuisée
+    int voiesAtteintes;  // Passe des nœuds : une <way> a été vue
+} TravailOSM;
+
+struct ImportOSM {
+    int nbThreads;
+    // Après la passe des voies
+    long long* refs;            // Références des voies, puis indices dans ids (dans le même tableau)
+    long nbRefs, capaciteRefs;
+    VoieOSM* voies;
+    int nbVoies, capaciteVoies;
+    long long* ids;             // Identifiants OSM des nœuds utilisés, triés
+    int nbIds;
+    // Passe des nœuds
+    double* lat;                // NAN tant que le nœud n'a pas été lu
+    double* lon;
+};
+
+/* Statistiques d'import */
+typedef struct {
+    double octets;              // Octets lus (deux passes)
+    double secondes;
+    int nbVoies;
+    int nbNoeuds, nbAretes;
+    int nbNoeudsAbsents;        // Référencés par une voie mais absents de l'extrait
+} StatsImportOSM;
+
+/* ----- Analyse XML minimale ----- */
+
+/* La balise commençant en p (après '<') est-elle 'nom' (suivi d'un espace, de '>' ou de '/') ? */
+static int osm_balise(const char* p, const char* fin, const char* nom) {
+    size_t n = strlen(nom);
+    if ((size_t)(fin - p) <= n || memcmp(p, nom, n) != 0) return 0;
+    char c = p[n];
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '>' || c == '/';
+}
+
+/* Valeur de l'attribut 'nom' dans la balise [p, fin de balise) : guillemets simples ou doubles */
+static int osm_attribut(const char* p, const char* fin, const char* nom, const char** valeur, int* longueur) {
+    size_t n = strlen(nom);
+    while (p < fin && *p != '>') {
+        if ((p[-1] == ' ' || p[-1] == '\t' || p[-1] == '\n' || p[-1] == '\r') && (size_t)(fin - p) > n + 1 &&
+            memcmp(p, nom, n) == 0 && p[n] == '=' && (p[n + 1] == '"' || p[n + 1] == '\'')) {
+            char guillemet = p[n + 1];
+            const char* v = p + n + 2;
+            const char* f = v;
+            while (f < fin && *f != guillemet) f++;
+            if (f >= fin) return 0;
+            *valeur = v;
+            *longueur = (int)(f - v);
+            return 1;
+        }
+        p++;
+    }
+    return 0;
+}
+
+static long long osm_entier(const char* v, int longueur) {
+    long long x = 0;
+    int i, signe = 1;
+    for (i = 0; i < longueur && v[i] == '-'; i++) signe = -1;
+    for (; i < longueur && v[i] >= '0' && v[i] <= '9'; i++) x = x * 10 + (v[i] - '0');
+    return signe * x;
+}
+
+static int osm_egal(const char* v, int longueur, const char* s) {
+    return (int)strlen(s) == longueur && memcmp(v, s, longueur) == 0;
+}
+
+/* Fin de la balise ouverte en p : pointe sur '>' (ou fin) */
+static const char* osm_fin_balise(const char* p, const char* fin) {
+    const char* q = (const char*)memchr(p, '>', fin - p);
+    return q ? q : fin;
+}
+
+/* ----- Passe des voies ----- */
+
+static int part_ajouter_ref(PartVoies* r, long long ref) {
+    if (r->nbRefs == r->capaciteRefs) {
+        long capacite = r->capaciteRefs ? 2 * r->capaciteRefs : 65536;
+        long long* refs = (long long*)realloc(r->refs, sizeof(long long) * capacite);
+        if (!refs) return 0;
+        r->refs = refs;
+        r->capaciteRefs = capacite;
+    }
+    r->refs[r->nbRefs++] = ref;
+    return 1;
+}
+
+static int part_ajouter_voie(PartVoies* r, const VoieOSM* v) {
+    if (r->nbVoies == r->capaciteVoies) {
+        int capacite = r->capaciteVoies ? 2 * r->capaciteVoies : 4096;
+        VoieOSM* voies = (VoieOSM*)realloc(r->voies, sizeof(VoieOSM) * capacite);
+        if (!voies) return 0;
+        r->voies = voies;
+        r->capaciteVoies = capacite;
+    }
+    r->voies[r->nbVoies++] = *v;
+    return 1;
+}
+
+/* Analyse une <way> commençant en p (sur '<') ; retourne la position après la voie */
+static const char* osm_lire_voie(TravailOSM* t, const char* p, const char* fin) {
+    PartVoies* r = &t->voies;
+    const char* q = osm_fin_balise(p, fin);
+    if (q >= fin || q[-1] == '/') return q; // <way .../> : aucune référence
+    long debutRefs = r->nbRefs;
+    int classe = -1, sens = 0, voies = 0, interdite = 0, sensDonne = 0;
+    const char* v;
+    int n;
+    p = q + 1;
+    while ((p = (const char*)memchr(p, '<', fin - p)) != NULL) {
+        p++;
+        if (p < fin && *p == '/') break; // </way>
+        q = osm_fin_balise(p, fin);
+        if (osm_balise(p, fin, "nd")) {
+            if (osm_attribut(p, q, "ref", &v, &n) && !part_ajouter_ref(r, osm_entier(v, n))) {
+                t->erreur = 1;
+                break;
+            }
+        } else if (osm_balise(p, fin, "tag") && osm_attribut(p, q, "k", &v, &n)) {
+            const char* k = v;
+            int lk = n, i;
+            if (!osm_attribut(p, q, "v", &v, &n)) {
+                p = q;
+                continue;
+            }
+            if (osm_egal(k, lk, "highway")) {
+                for (i = 0; i < OSM_NB_CLASSES; i++)
+                    if (osm_egal(v, n, OSM_CLASSES[i].nom)) classe = i;
+            } else if (osm_egal(k, lk, "oneway")) {
+                sensDonne = 1;
+                if (osm_egal(v, n, "yes") || osm_egal(v, n, "1") || osm_egal(v, n, "true")) sens = 1;
+                else if (osm_egal(v, n, "-1") || osm_egal(v, n, "reverse")) sens = -1;
+                else sens = 0;
+            } else if (osm_egal(k, lk, "junction")) {
+                if (!sensDonne && (osm_egal(v, n, "roundabout") || osm_egal(v, n, "circular"))) sens = 1;
+            } else if (osm_egal(k, lk, "lanes")) {
+                long long l = osm_entier(v, n);
+                voies = l < 1 ? 0 : (l > 16 ? 16 : (int)l);
+            } else if (osm_egal(k, lk, "access") || osm_egal(k, lk, "motor_vehicle")) {
+                if (osm_egal(v, n, "no") || osm_egal(v, n, "private")) interdite = 1;
+            } else if (osm_egal(k, lk, "area")) {
+                if (osm_egal(v, n, "yes")) interdite = 1; // Surface (place piétonne...), pas une route
+            }
+        }
+        p = q;
+    }
+    if (!p) p = fin;
+    // Autoroutes à sens unique par défaut
+    if (classe == 0 && !sensDonne) sens = 1;
+    if (classe < 0 || interdite || r->nbRefs - debutRefs < 2 || t->erreur) {
+        r->nbRefs = debutRefs;
+        return p;
+    }
+    VoieOSM voie = { debutRefs, (int)(r->nbRefs - debutRefs), (signed char)classe, (signed char)sens, (unsigned char)voies };
+    if (!part_ajouter_voie(r, &voie)) t->erreur = 1;
+    return p;
+}
+
+static void* osm_travail_voies(void* arg) {
+    TravailOSM* t = (TravailOSM*)arg;
+    const char* p = t->debut;
+    while (!t->erreur && (p = (const char*)memchr(p, '<', t->fin - p)) != NULL) {
+        p++;
+        if (osm_balise(p, t->fin, "way")) p = osm_lire_voie(t, p, t->fin);
+    }
+    return NULL;
+}
+
+/* ----- Passe des nœuds ----- */
+
+/* Indice du nœud d'identifiant OSM 'id' dans ids (trié), -1 s'il n'est pas utilisé */
+static int osm_indice(const long long* ids, int n, long long id) {
+    int a = 0, b = n - 1;
+    while (a <= b) {
+        int m = a + (b - a) / 2;
+        if (ids[m] < id) a = m + 1;
+        else if (ids[m] > id) b = m - 1;
+        else return m;
+    }
+    return -1;
+}
+
+static void* osm_travail_noeuds(void* arg) {
+    TravailOSM* t = (TravailOSM*)arg;
+    ImportOSM* import = t->import;
+    const char* p = t->debut;
+    const char* v;
+    int n;
+    while ((p = (const char*)memchr(p, '<', t->fin - p)) != NULL) {
+        p++;
+        if (osm_balise(p, t->fin, "way")) {
+            t->voiesAtteintes = 1;
+            break;
+        }
+        if (!osm_balise(p, t->fin, "node")) continue;
+        const char* q = osm_fin_balise(p, t->fin);
+        if (!osm_attribut(p, q, "id", &v, &n)) continue;
+        int i = osm_indice(import->ids, import->nbIds, osm_entier(v, n));
+        if (i < 0) continue;
+        // Chaque nœud n'apparaît qu'une fois : les threads écrivent à des indices distincts
+        if (osm_attribut(p, q, "lat", &v, &n)) import->lat[i] = strtod(v, NULL);
+        if (osm_attribut(p, q, "lon", &v, &n)) import->lon[i] = strtod(v, NULL);
+        p = q;
+    }
+    return NULL;
+}
+
+/* ----- Lecture par tranches ----- */
+
+/* Dernière coupure possible dans [debut, fin) : '<' d'une balise de premier niveau, sinon debut */
+static size_t osm_coupure(const char* tampon, size_t debut, size_t fin) {
+    size_t p = fin;
+    while (p > debut + 1) {
+        p--;
+        if (tampon[p] != '<') continue;
+        const char* b = tampon + p + 1;
+        const char* f = tampon + fin;
+        if (osm_balise(b, f, "node") || osm_balise(b, f, "way") || osm_balise(b, f, "relation") || osm_balise(b, f, "/osm"))
+            return p;
+    }
+    return debut;
+}
+
+/**
+ * Lit le fichier par tranches et applique 'travail' en parallèle sur les parts de chaque tranche.
+ * 'apresTranche' (optionnel) est appelé après chaque tranche et retourne 0 pour arrêter la lecture.
+ */
+static int osm_parcourir(ImportOSM* import, const char* fichier, void* (*travail)(void*),
+                         int (*apresTranche)(ImportOSM* import, TravailOSM* travaux), double* octets) {
+    int k, T = import->nbThreads, ok = 1;
+    FILE* f = fopen(fichier, "rb");
+    if (!f) return 0;
+    size_t capacite = (size_t)T * OSM_TAILLE_PART, taille = 0;
+    char* tampon = (char*)malloc(capacite + 1);
+    TravailOSM* travaux = (TravailOSM*)calloc(T, sizeof(TravailOSM));
+    pthread_t* threads = (pthread_t*)malloc(sizeof(pthread_t) * T);
+    char* lance = (char*)malloc(T); // Parts confiées à un thread qui a démarré
+    if (!tampon || !travaux || !threads || !lance) ok = 0;
+    int finFichier = 0;
+    while (ok) {
+        size_t lus = fread(tampon + taille, 1, capacite - taille, f);
+        *octets += lus;
+        taille += lus;
+        finFichier = (taille < capacite);
+        size_t coupure = finFichier ? taille : osm_coupure(tampon, 0, taille);
+        if (coupure == 0 && !finFichier) {
+            // Un seul élément plus grand que le tampon : agrandissement
+            char* plus = (char*)realloc(tampon, 2 * capacite + 1);
+            if (!plus) {
+                ok = 0;
+                break;
+            }
+            tampon = plus;
+            capacite *= 2;
+            continue;
+        }
+        // Parts de taille voisine, chacune commençant par une balise de premier niveau
+        size_t debutPart = 0;
+        for (k = 0; k < T; k++) {
+            size_t finPart = (k == T - 1) ? coupure : osm_coupure(tampon, debutPart, coupure * (k + 1) / T);
+            if (finPart < debutPart) finPart = debutPart;
+            travaux[k].import = import;
+            travaux[k].debut = tampon + debutPart;
+            travaux[k].fin = tampon + finPart;
+            travaux[k].erreur = 0;
+            travaux[k].voiesAtteintes = 0;
+            debutPart = finPart;
+        }
+        for (k = 1; k < T; k++)
+            lance[k] = pthread_create(&threads[k], NULL, travail, &travaux[k]) == 0;
+        // Le thread appelant fait sa part et celles des threads qui n'ont pas pu démarrer
+        travail(&travaux[0]);
+        for (k = 1; k < T; k++)
+            if (!lance[k]) travail(&travaux[k]);
+        for (k = 1; k < T; k++)
+            if (lance[k]) pthread_join(threads[k], NULL);
+        for (k = 0; k < T; k++)
+            if (travaux[k].erreur) ok = 0;
+        if (ok && apresTranche && !apresTranche(import, travaux)) break;
+        if (finFichier) break;
+        // Le reste (élément coupé) passe au début de la tranche suivante
+        memmove(tampon, tampon + coupure, taille - coupure);
+        taille -= coupure;
+    }
+    for (k = 0; k < T; k++) {
+        free(travaux[k].voies.refs);
+        free(travaux[k].voies.voies);
+    }
+    free(travaux);
+    free(threads);
+    free(lance);
+    free(tampon);
+    fclose(f);
+    return ok;
+}
+
+/* Fusionne les voies des parts, dans l'ordre du fichier */
+static int osm_fusionner_voies(ImportOSM* import, TravailOSM* travaux) {
+    int k, i;
+    for (k = 0; k < import->nbThreads; k++) {
+        PartVoies* r = &travaux[k].voies;
+        if (import->nbRefs + r->nbRefs > import->capaciteRefs) {
+            long capacite = import->capaciteRefs ? import->capaciteRefs : 65536;
+            while (capacite < import->nbRefs + r->nbRefs) capacite *= 2;
+            long long* refs = (long long*)realloc(import->refs, sizeof(long long) * capacite);
+            if (!refs) return 0;
+            import->refs = refs;
+            import->capaciteRefs = capacite;
+        }
+        if (import->nbVoies + r->nbVoies > import->capaciteVoies) {
+            int capacite = import->capaciteVoies ? import->capaciteVoies : 4096;
+            while (capacite < import->nbVoies + r->nbVoies) capacite *= 2;
+            VoieOSM* voies = (VoieOSM*)realloc(import->voies, sizeof(VoieOSM) * capacite);
+            if (!voies) return 0;
+            import->voies = voies;
+            import->capaciteVoies = capacite;
+        }
+        if (r->nbRefs > 0) memcpy(import->refs + import->nbRefs, r->refs, sizeof(long long) * r->nbRefs);
+        for (i = 0; i < r->nbVoies; i++) {
+            VoieOSM v = r->voies[i];
+            v.debut += import->nbRefs;
+            import->voies[import->nbVoies++] = v;
+        }
+        import->nbRefs += r->nbRefs;
+        r->nbRefs = 0;
+        r->nbVoies = 0;
+    }
+    return 1;
+}
+
+/* Arrêt de la passe des nœuds dès que les voies commencent */
+static int osm_suite_noeuds(ImportOSM* import, TravailOSM* travaux) {
+    int k;
+    for (k = 0; k < import->nbThreads; k++)
+        if (travaux[k].voiesAtteintes) return 0;
+    return 1;
+}
+
+static int osm_comparer_ids(const void* a, const void* b) {
+    long long x = *(const long long*)a, y = *(const long long*)b;
+    return (x > y) - (x < y);
+}
+
+static void osm_liberer(ImportOSM* import) {
+    free(import->refs);
+    free(import->voies);
+    free(import->ids);
+    free(import->lat);
+    free(import->lon);
+}
+
+/* Distance (m) entre deux points donnés en degrés (formule de haversine) */
+static double osm_distance(double lat1, double lon1, double lat2, double lon2) {
+    double r = OSM_DEGRE;
+    double dlat = (lat2 - lat1) * r, dlon = (lon2 - lon1) * r;
+    double a = sin(dlat / 2) * sin(dlat / 2) + cos(lat1 * r) * cos(lat2 * r) * sin(dlon / 2) * sin(dlon / 2);
+    return 2.0 * OSM_RAYON_TERRE * asin(sqrt(a < 1.0 ? a : 1.0));
+}
+
+/**
+ * Importe le réseau routier d'un extrait OSM (XML) dans une carte vide : un nœud par nœud OSM
+ * utilisé (coordonnées en mètres, nom = identifiant OSM), une arête par segment de voie et par
+ * sens autorisé (longueur réelle en mètres). Retourne 0 en cas d'erreur.
+ */
+int osm_importer(Carte* carte, const char* fichier, int nbThreads, StatsImportOSM* stats, char* erreur, size_t tailleErreur) {
+    ImportOSM import;
+    long i;
+    double debut = chrono_secondes();
+    memset(&import, 0, sizeof(import));
+    memset(stats, 0, sizeof(StatsImportOSM));
+    import.nbThreads = nbThreads > 0 ? nbThreads : 1;
+    carte_init(carte);
+    // 1. Voies carrossables
+    if (!osm_parcourir(&import, fichier, osm_travail_voies, osm_fusionner_voies, &stats->octets)) {
+        if (erreur) snprintf(erreur, tailleErreur, "%s : lecture impossible ou memoire epuisee", fichier);
+        osm_liberer(&import);
+        return 0;
+    }
+    // Numérotation compacte : identifiants utilisés, triés et dédoublonnés
+    import.ids = (long long*)malloc(sizeof(long long) * (import.nbRefs > 0 ? import.nbRefs : 1));
+    if (!import.ids) {
+        osm_liberer(&import);
+        return 0;
+    }
+    memcpy(import.ids, import.refs, sizeof(long long) * import.nbRefs);
+    qsort(import.ids, import.nbRefs, sizeof(long long), osm_comparer_ids);
+    long n = 0;
+    for (i = 0; i < import.nbRefs; i++)
+        if (n == 0 || import.ids[i] != import.ids[n - 1]) import.ids[n++] = import.ids[i];
+    import.nbIds = (int)n;
+    import.lat = (double*)malloc(sizeof(double) * (n > 0 ? n : 1));
+    import.lon = (double*)malloc(sizeof(double) * (n > 0 ? n : 1));
+    if (!import.lat || !import.lon) {
+        osm_liberer(&import);
+        return 0;
+    }
+    for (i = 0; i < n; i++) import.lat[i] = import.lon[i] = NAN;
+    // 2. Coordonnées des nœuds utilisés
+    if (!osm_parcourir(&import, fichier, osm_travail_noeuds, osm_suite_noeuds, &stats->octets)) {
+        if (erreur) snprintf(erreur, tailleErreur, "%s : lecture impossible", fichier);
+        osm_liberer(&import);
+        return 0;
+    }
+    // Nœuds absents de l'extrait (voies coupées au bord) : retirés de la numérotation
+    int* numero = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    double latMin = 90, latMax = -90, lonMin = 180;
+    int nbNoeuds = 0;
+    for (i = 0; numero && i < n; i++) {
+        if (isnan(import.lat[i]) || isnan(import.lon[i])) {
+            numero[i] = -1;
+            stats->nbNoeudsAbsents++;
+            continue;
+        }
+        numero[i] = nbNoeuds++;
+        if (import.lat[i] < latMin) latMin = import.lat[i];
+        if (import.lat[i] > latMax) latMax = import.lat[i];
+        if (import.lon[i] < lonMin) lonMin = import.lon[i];
+    }
+    int ok = numero && carte_reserver_tailles(carte, nbNoeuds, (int)(2 * (import.nbRefs - import.nbVoies)), 0) &&
+             carte_etendre_noeuds(carte, nbNoeuds);
+    // Projection équirectangulaire en mètres autour de l'extrait (y vers le sud, comme à l'écran)
+    double echelleY = OSM_RAYON_TERRE * OSM_DEGRE;
+    double echelleX = echelleY * cos((latMin + latMax) / 2 * OSM_DEGRE);
+    int type = ok ? carte_ajouter_texte(carte, "osm", 3) : -1;
+    char nom[24];
+    for (i = 0; ok && i < n; i++) {
+        if (numero[i] < 0) continue;
+        NoeudCarte* noeud = &carte->noeuds[numero[i]];
+        noeud->x = (int)lround((import.lon[i] - lonMin) * echelleX);
+        noeud->y = (int)lround((latMax - import.lat[i]) * echelleY);
+        noeud->nom = carte_ajouter_texte(carte, nom, snprintf(nom, sizeof(nom), "%lld", import.ids[i]));
+        noeud->type = type;
+        ok = noeud->nom >= 0 && type >= 0;
+    }
+    // Références -> indices dans ids (dans le même tableau), puis une arête par segment et par sens
+    for (i = 0; ok && i < import.nbRefs; i++)
+        import.refs[i] = osm_indice(import.ids, import.nbIds, import.refs[i]);
+    int v, j;
+    for (v = 0; ok && v < import.nbVoies; v++) {
+        const VoieOSM* voie = &import.voies[v];
+        int voies = voie->voies ? voie->voies : 1;
+        if (voie->sens == 0 && voie->voies) voies = (voie->voies + 1) / 2; // Voies réparties sur les deux sens
+        int capacite = OSM_CLASSES[voie->classe].capacite * voies;
+        int prioritaire = OSM_CLASSES[voie->classe].prioritaire;
+        for (j = 0; ok && j + 1 < voie->nbRefs; j++) {
+            int a = (int)import.refs[voie->debut + j], b = (int)import.refs[voie->debut + j + 1];
+            if (numero[a] < 0 || numero[b] < 0 || a == b) continue;
+            double d = osm_distance(import.lat[a], import.lon[a], import.lat[b], import.lon[b]);
+            if (voie->sens >= 0) ok = carte_ajouter_arete(carte, numero[a], numero[b], d, prioritaire, capacite, 0);
+            if (ok && voie->sens <= 0) ok = carte_ajouter_arete(carte, numero[b], numero[a], d, prioritaire, capacite, 0);
+        }
+    }
+    // Numérotation de Hilbert : nœuds voisins sur la carte = numéros voisins
+    if (ok && carte->nbNoeuds > 0) {
+        Numerotation num;
+        int* X = (int*)malloc(sizeof(int) * carte->nbNoeuds);
+        int* Y = (int*)malloc(sizeof(int) * carte->nbNoeuds);
+        for (i = 0; X && Y && i < carte->nbNoeuds; i++) {
+            X[i] = carte->noeuds[i].x;
+            Y[i] = carte->noeuds[i].y;
+        }
+        ok = X && Y && numerotation_hilbert(&num, X, Y, carte->nbNoeuds);
+        if (ok) {
+            ok = carte_renumeroter(carte, &num);
+            numerotation_liberer(&num);
+        }
+        free(X);
+        free(Y);
+    }
+    stats->nbVoies = import.nbVoies;
+    stats->nbNoeuds = carte->nbNoeuds;
+    stats->nbAretes = carte->nbAretes;
+    stats->secondes = chrono_secondes() - debut;
+    free(numero);
+    osm_liberer(&import);
+    if (!ok) {
+        if (erreur) snprintf(erreur, tailleErreur, "memoire epuisee");
+        carte_liberer(carte);
+    }
+    return ok;
+}
+
+#endif
@@ -0,0 +1,431 @@
+#ifndef INSTANTANE_H
+#define INSTANTANE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#include "FormatCarte.h"
+#include "Reseau.h"
+#include "Feux.h"
+
+/* ===================== Instantané du graphe construit ===================== */
+/*
+ * Un instantané contient le graphe déjà construit : nœuds et noms, adjacence compacte (CSR),
+ * attributs des arêtes, feux et index nœud -> feux. Chaque section est un tableau aligné sur
+ * 8 octets, repéré par son décalage dans l'en-tête : le fichier est projeté en mémoire en
+ * lecture seule (mmap) et utilisé tel quel, sans copie ni correction de pointeurs. Plusieurs
+ * processus qui ouvrent le même instantané partagent les mêmes pages.
+ *
+ * L'instantané dépend de l'architecture (boutisme, taille des types), vérifiée à l'ouverture,
+ * et de la carte d'origine. L'en-tête garde la taille et l'empreinte des octets du fichier de
+ * carte : savoir si l'instantané est à jour ne demande pas d'analyser la carte. Les nœuds, les
+ * arêtes et les feux de la carte y sont aussi, pour construire le graphe d'affichage sans elle.
+ */
+
+#define INSTANTANE_VERSION 2
+
+enum {
+    INST_NOEUDS,      // NoeudCarte[nbNoeuds]
+    INST_TEXTES,      // char[tailleTextes]
+    INST_DEBUT,       // int[nbNoeuds + 1]   (Reseau)
+    INST_CIBLE,       // int[nbAretesReseau]
+    INST_POIDS,       // double[nbAretesReseau]
+    INST_ID_ARETE,    // int[nbAretesReseau]
+    INST_X,           // int[nbNoeuds]
+    INST_Y,           // int[nbNoeuds]
+    INST_ARETES,      // AreteCarte[nbAretes], dans l'ordre de la carte
+    INST_FEUX,        // FeuRouge[nbFeux], indicés par identifiant de feu
+    INST_INDEX_DEBUT, // int[nbNoeuds + 1]   (IndexFeux)
+    INST_INDEX_FEUX,  // int[nbFeux]
+    INST_FEUX_CARTE,  // FeuCarte[nbFeuxCarte], dans l'ordre de la carte
+    INST_NB_SECTIONS
+};
+
+typedef struct {
+    char magie[4];            // "INST"
+    uint32_t version;
+    uint32_t boutisme;        // 0x01020304 écrit par la machine d'origine
+    uint32_t tailleEntete;    // sizeof(EnteteInstantane), contrôle de la disposition des types
+    int32_t nbNoeuds;
+    int32_t nbAretes;         // Arêtes de la carte
+    int32_t nbAretesReseau;   // Arêtes valides retenues dans le CSR
+    int32_t nbFeux;
+    int32_t tailleTextes;
+    int32_t nbFeuxCarte;      // Lignes F de la carte
+    uint64_t empreinteCarte;  // Empreinte de la carte d'origine (carte_empreinte)
+    uint64_t tailleSource;    // Taille du fichier de carte, 0 s'il n'est pas connu
+    uint64_t empreinteSource; // Empreinte de ses octets (fichier_empreinte)
+    uint64_t tailleFichier;
+    uint64_t decalage[INST_NB_SECTIONS];
+} EnteteInstantane;
+
+typedef struct {
+    const EnteteInstantane* entete;
+    size_t taille;
+    const NoeudCarte* noeuds;
+    const char* textes;
+    const AreteCarte* aretes;
+    const FeuRouge* feux;
+    int nbFeux;
+    Reseau reseau;            // Tableaux dans la projection : ne pas modifier ni libérer
+    IndexFeux indexFeux;      // Idem
+#ifdef _WIN32
+    HANDLE fichier;
+    HANDLE projection;
+#endif
+} Instantane;
+
+/* Empreinte FNV-1a 64 bits d'une zone mémoire, à enchaîner */
+static uint64_t instantane_fnv(uint64_t h, const void* donnees, size_t taille) {
+    const unsigned char* p = (const unsigned char*)donnees;
+    size_t i;
+    for (i = 0; i < taille; i++) {
+        h ^= p[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+/**
+ * Empreinte des octets d'un fichier et sa taille. Retourne 0 si le fichier ne peut pas être lu.
+ */
+int fichier_empreinte(const char* fichier, uint64_t* empreinte, uint64_t* taille) {
+    unsigned char tampon[65536];
+    size_t lus;
+    FILE* f = fopen(fichier, "rb");
+    if (!f) return 0;
+    *empreinte = 14695981039346656037ULL;
+    *taille = 0;
+    while ((lus = fread(tampon, 1, sizeof(tampon), f)) > 0) {
+        *empreinte = instantane_fnv(*empreinte, tampon, lus);
+        *taille += lus;
+    }
+    int ok = !ferror(f);
+    fclose(f);
+    return ok;
+}
+
+/**
+ * Empreinte d'une carte (nœuds, arêtes, feux, textes) : permet de reconnaître un instantané périmé.
+ */
+uint64_t carte_empreinte(const Carte* c) {
+    uint64_t h = 14695981039346656037ULL;
+    int tailles[4] = { c->nbNoeuds, c->nbAretes, c->nbFeux, c->tailleTextes }, i;
+    h = instantane_fnv(h, tailles, sizeof(tailles));
+    // Champ par champ : le bourrage des structures n'a pas de valeur définie
+    for (i = 0; i < c->nbNoeuds; i++) {
+        const NoeudCarte* noeud = &c->noeuds[i];
+        int champs[4] = { noeud->x, noeud->y, noeud->nom, noeud->type };
+        h = instantane_fnv(h, champs, sizeof(champs));
+    }
+    for (i = 0; i < c->nbAretes; i++) {
+        const AreteCarte* a = &c->aretes[i];
+        int champs[5] = { a->source, a->destination, a->prioritaire, a->capacite, a->drapeaux };
+        h = instantane_fnv(h, champs, sizeof(champs));
+        h = instantane_fnv(h, &a->distance, sizeof(double));
+    }
+    for (i = 0; i < c->nbFeux; i++) {
+        const FeuCarte* f = &c->feux[i];
+        int champs[5] = { f->id, f->position, f->etat, f->dureeRouge, f->dureeVert };
+        h = instantane_fnv(h, champs, sizeof(champs));
+    }
+    h = instantane_fnv(h, c->textes, c->tailleTextes);
+    return h;
+}
+
+/* Écrit une section à la position courante (complétée à un multiple de 8) et note son décalage */
+static int instantane_section(FILE* f, EnteteInstantane* e, int section, const void* donnees, size_t taille) {
+    static const char zeros[8] = { 0 };
+    long position = ftell(f);
+    if (position < 0) return 0;
+    e->decalage[section] = (uint64_t)position;
+    if (taille > 0 && fwrite(donnees, 1, taille, f) != taille) return 0;
+    size_t bourrage = (8 - taille % 8) % 8;
+    return bourrage == 0 || fwrite(zeros, 1, bourrage, f) == bourrage;
+}
+
+/**
+ * Construit le graphe décrit par la carte : réseau compact, feux rangés par identifiant et
+ * index nœud -> feux. Retourne 0 en cas d'erreur (rien n'est alors à libérer).
+ */
+int carte_construire_reseau(const Carte* carte, Reseau** reseau, FeuRouge** feuxSortie, IndexFeux* index) {
+    int n = carte->nbNoeuds, m = carte->nbAretes, nbFeux = carte_nb_feux(carte), i;
+    int* sources = (int*)malloc(sizeof(int) * (m > 0 ? m : 1));
+    int* destinations = (int*)malloc(sizeof(int) * (m > 0 ? m : 1));
+    double* distances = (double*)malloc(sizeof(double) * (m > 0 ? m : 1));
+    int* X = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    int* Y = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    FeuRouge* feux = (FeuRouge*)calloc(nbFeux > 0 ? nbFeux : 1, sizeof(FeuRouge));
+    Reseau* r = NULL;
+    int ok = sources && destinations && distances && X && Y && feux;
+    index->debut = index->feux = NULL;
+    if (ok) {
+        for (i = 0; i < m; i++) {
+            sources[i] = carte->aretes[i].source;
+            destinations[i] = carte->aretes[i].destination;
+            distances[i] = carte->aretes[i].distance;
+        }
+        for (i = 0; i < n; i++) {
+            X[i] = carte->noeuds[i].x;
+            Y[i] = carte->noeuds[i].y;
+        }
+        // Feux initialisés comme par ajouterFeuRouge
+        for (i = 0; i < carte->nbFeux; i++) {
+            const FeuCarte* fc = &carte->feux[i];
+            FeuRouge* feu = &feux[fc->id];
+            feu->ID = fc->id;
+            feu->PositionNoeud = fc->position;
+            feu->Etat = fc->etat;
+            feu->DureeRouge = fc->dureeRouge;
+            feu->DureeVert = fc->dureeVert;
+            feu->Decalage = fc->etat ? 0 : fc->dureeVert;
+            feu_actualiser(feu, 0.0);
+        }
+        r = reseau_creer(n, m, sources, destinations, distances, X, Y);
+        ok = r && index_feux_construire(index, feux, nbFeux, n);
+    }
+    free(sources);
+    free(destinations);
+    free(distances);
+    free(X);
+    free(Y);
+    if (!ok) {
+        free(feux);
+        reseau_liberer(r);
+        index_feux_liberer(index);
+        return 0;
+    }
+    *reseau = r;
+    *feuxSortie = feux;
+    return 1;
+}
+
+/**
+ * Construit le graphe décrit par la carte et l'écrit dans un instantané. 'fichierCarte' est le
+ * fichier dont la carte a été chargée (NULL : l'instantané ne sera jamais tenu pour à jour).
+ * Retourne 0 en cas d'erreur.
+ */
+int instantane_ecrire(const char* fichier, const Carte* carte, const char* fichierCarte) {
+    int n = carte->nbNoeuds, m = carte->nbAretes, nbFeux = carte_nb_feux(carte);
+    Reseau* r = NULL;
+    FeuRouge* feux = NULL;
+    IndexFeux index;
+    int ok = carte_construire_reseau(carte, &r, &feux, &index);
+    FILE* f = ok ? fopen(fichier, "wb") : NULL;
+    if (f) {
+        EnteteInstantane e;
+        memset(&e, 0, sizeof(e));
+        memcpy(e.magie, "INST", 4);
+        e.version = INSTANTANE_VERSION;
+        e.boutisme = 0x01020304u;
+        e.tailleEntete = sizeof(EnteteInstantane);
+        e.nbNoeuds = n;
+        e.nbAretes = m;
+        e.nbAretesReseau = r->nbAretes;
+        e.nbFeux = nbFeux;
+        e.tailleTextes = carte->tailleTextes;
+        e.nbFeuxCarte = carte->nbFeux;
+        e.empreinteCarte = carte_empreinte(carte);
+        if (fichierCarte && !fichier_empreinte(fichierCarte, &e.empreinteSource, &e.tailleSource))
+            e.tailleSource = e.empreinteSource = 0;
+        // En-tête provisoire, réécrit une fois les décalages connus
+        ok = fwrite(&e, sizeof(e), 1, f) == 1 &&
+             instantane_section(f, &e, INST_NOEUDS, carte->noeuds, sizeof(NoeudCarte) * n) &&
+             instantane_section(f, &e, INST_TEXTES, carte->textes, carte->tailleTextes) &&
+             instantane_section(f, &e, INST_DEBUT, r->debut, sizeof(int) * (n + 1)) &&
+             instantane_section(f, &e, INST_CIBLE, r->cible, sizeof(int) * r->nbAretes) &&
+             instantane_section(f, &e, INST_POIDS, r->poids, sizeof(double) * r->nbAretes) &&
+             instantane_section(f, &e, INST_ID_ARETE, r->idArete, sizeof(int) * r->nbAretes) &&
+             instantane_section(f, &e, INST_X, r->X, sizeof(int) * n) &&
+             instantane_section(f, &e, INST_Y, r->Y, sizeof(int) * n) &&
+             instantane_section(f, &e, INST_ARETES, carte->aretes, sizeof(AreteCarte) * m) &&
+             instantane_section(f, &e, INST_FEUX, feux, sizeof(FeuRouge) * nbFeux) &&
+             instantane_section(f, &e, INST_INDEX_DEBUT, index.debut, sizeof(int) * (n + 1)) &&
+             instantane_section(f, &e, INST_INDEX_FEUX, index.feux, sizeof(int) * index.debut[n]) &&
+             instantane_section(f, &e, INST_FEUX_CARTE, carte->feux, sizeof(FeuCarte) * carte->nbFeux);
+        long fin = ftell(f);
+        e.tailleFichier = fin > 0 ? (uint64_t)fin : 0;
+        ok = ok && fin > 0 && fseek(f, 0, SEEK_SET) == 0 && fwrite(&e, sizeof(e), 1, f) == 1;
+        ok = (fclose(f) == 0) && ok;
+    } else {
+        ok = 0;
+    }
+    if (r) {
+        free(feux);
+        reseau_liberer(r);
+        index_feux_liberer(&index);
+    }
+    return ok;
+}
+
+/* Vérifie qu'une section de 'taille' octets tient dans le fichier */
+static int instantane_section_valide(const Instantane* inst, int section, size_t taille) {
+    uint64_t d = inst->entete->decalage[section];
+    return d % 8 == 0 && d >= sizeof(EnteteInstantane) && d <= inst->taille && taille <= inst->taille - d;
+}
+
+/**
+ * Carte de l'instantané : vue sur ses sections (nœuds, textes, arêtes, feux), en lecture seule.
+ * Ne pas la modifier ni la libérer ; elle reste valide jusqu'à instantane_fermer.
+ */
+void instantane_carte(const Instantane* inst, Carte* vue) {
+    const EnteteInstantane* e = inst->entete;
+    const char* octets = (const char*)e;
+    carte_init(vue);
+    vue->nbNoeuds = e->nbNoeuds;
+    vue->nbAretes = e->nbAretes;
+    vue->nbFeux = e->nbFeuxCarte;
+    vue->tailleTextes = e->tailleTextes;
+    vue->noeuds = (NoeudCarte*)(octets + e->decalage[INST_NOEUDS]);
+    vue->aretes = (AreteCarte*)(octets + e->decalage[INST_ARETES]);
+    vue->feux = (FeuCarte*)(octets + e->decalage[INST_FEUX_CARTE]);
+    vue->textes = (char*)(octets + e->decalage[INST_TEXTES]);
+}
+
+/**
+ * Vrai si l'instantané a été écrit depuis 'fichierCarte' dans son état actuel : même taille,
+ * puis même empreinte des octets. Le fichier est lu, pas analysé.
+ */
+int instantane_a_jour(const Instantane* inst, const char* fichierCarte) {
+    uint64_t empreinte, taille;
+    struct stat st;
+    const EnteteInstantane* e = inst->entete;
+    if (!e || e->tailleSource == 0) return 0;
+    if (stat(fichierCarte, &st) != 0 || (uint64_t)st.st_size != e->tailleSource) return 0;
+    return fichier_empreinte(fichierCarte, &empreinte, &taille) && taille == e->tailleSource &&
+           empreinte == e->empreinteSource;
+}
+
+/* Le CSR et l'index des feux sont donnés tels quels aux recherches : chaque indice doit désigner
+   un élément existant (un fichier corrompu ferait sinon lire hors des tableaux) */
+static int instantane_indices_valides(const Instantane* inst) {
+    const Reseau* r = &inst->reseau;
+    const IndexFeux* index = &inst->indexFeux;
+    int n = r->nbNoeuds, nbFeux = inst->entete->nbFeux, u, k;
+    if (r->debut[0] != 0 || r->debut[n] != r->nbAretes) return 0;
+    for (u = 0; u < n; u++)
+        if (r->debut[u + 1] < r->debut[u]) return 0;
+    for (k = 0; k < r->nbAretes; k++)
+        if (r->cible[k] < 0 || r->cible[k] >= n || r->idArete[k] < 0 || r->idArete[k] >= inst->entete->nbAretes)
+            return 0;
+    if (index->debut[0] != 0 || index->debut[n] < 0 || index->debut[n] > nbFeux ||
+        !instantane_section_valide(inst, INST_INDEX_FEUX, sizeof(int) * (size_t)index->debut[n]))
+        return 0;
+    for (u = 0; u < n; u++)
+        if (index->debut[u + 1] < index->debut[u]) return 0;
+    for (k = 0; k < index->debut[n]; k++)
+        if (index->feux[k] < 0 || index->feux[k] >= nbFeux) return 0;
+    return 1;
+}
+
+void instantane_fermer(Instantane* inst) {
+    if (!inst->entete) return;
+#ifdef _WIN32
+    UnmapViewOfFile((void*)inst->entete);
+    CloseHandle(inst->projection);
+    CloseHandle(inst->fichier);
+#else
+    munmap((void*)inst->entete, inst->taille);
+#endif
+    memset(inst, 0, sizeof(Instantane));
+}
+
+/**
+ * Projette un instantané en mémoire en lecture seule et prépare les vues (réseau, feux, index)
+ * sur ses sections. Aucune donnée n'est copiée : les pages sont lues à la demande.
+ */
+int instantane_ouvrir(Instantane* inst, const char* fichier, char* erreur, size_t tailleErreur) {
+    void* base = NULL;
+    size_t taille = 0;
+    memset(inst, 0, sizeof(Instantane));
+#ifdef _WIN32
+    inst->fichier = CreateFileA(fichier, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (inst->fichier != INVALID_HANDLE_VALUE) {
+        LARGE_INTEGER t;
+        if (GetFileSizeEx(inst->fichier, &t)) taille = (size_t)t.QuadPart;
+        inst->projection = CreateFileMappingA(inst->fichier, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (inst->projection) base = MapViewOfFile(inst->projection, FILE_MAP_READ, 0, 0, 0);
+        if (!base) {
+            if (inst->projection) CloseHandle(inst->projection);
+            CloseHandle(inst->fichier);
+        }
+    }
+#else
+    int fd = open(fichier, O_RDONLY);
+    struct stat st;
+    if (fd >= 0 && fstat(fd, &st) == 0 && st.st_size > 0) {
+        taille = (size_t)st.st_size;
+        base = mmap(NULL, taille, PROT_READ, MAP_SHARED, fd, 0);
+        if (base == MAP_FAILED) base = NULL;
+    }
+    if (fd >= 0) close(fd); // La projection reste valide après la fermeture du descripteur
+#endif
+    if (!base) {
+        if (erreur) snprintf(erreur, tailleErreur, "impossible de projeter %s", fichier);
+        return 0;
+    }
+    inst->entete = (const EnteteInstantane*)base;
+    inst->taille = taille;
+    const EnteteInstantane* e = inst->entete;
+    int n = e->nbNoeuds, ok = taille >= sizeof(EnteteInstantane);
+    ok = ok && memcmp(e->magie, "INST", 4) == 0 && e->version == INSTANTANE_VERSION &&
+         e->boutisme == 0x01020304u && e->tailleEntete == sizeof(EnteteInstantane) && e->tailleFichier == taille &&
+         n >= 0 && e->nbAretes >= 0 && e->nbAretesReseau >= 0 && e->nbFeux >= 0 && e->tailleTextes >= 0 &&
+         e->nbFeuxCarte >= 0;
+    ok = ok && instantane_section_valide(inst, INST_NOEUDS, sizeof(NoeudCarte) * n) &&
+         instantane_section_valide(inst, INST_TEXTES, e->tailleTextes) &&
+         instantane_section_valide(inst, INST_DEBUT, sizeof(int) * ((size_t)n + 1)) &&
+         instantane_section_valide(inst, INST_CIBLE, sizeof(int) * e->nbAretesReseau) &&
+         instantane_section_valide(inst, INST_POIDS, sizeof(double) * e->nbAretesReseau) &&
+         instantane_section_valide(inst, INST_ID_ARETE, sizeof(int) * e->nbAretesReseau) &&
+         instantane_section_valide(inst, INST_X, sizeof(int) * n) &&
+         instantane_section_valide(inst, INST_Y, sizeof(int) * n) &&
+         instantane_section_valide(inst, INST_ARETES, sizeof(AreteCarte) * e->nbAretes) &&
+         instantane_section_valide(inst, INST_FEUX, sizeof(FeuRouge) * e->nbFeux) &&
+         instantane_section_valide(inst, INST_INDEX_DEBUT, sizeof(int) * ((size_t)n + 1)) &&
+         instantane_section_valide(inst, INST_INDEX_FEUX, 0) &&
+         instantane_section_valide(inst, INST_FEUX_CARTE, sizeof(FeuCarte) * e->nbFeuxCarte);
+    if (!ok) {
+        if (erreur) snprintf(erreur, tailleErreur, "%s : instantane invalide ou d'une autre version", fichier);
+        instantane_fermer(inst);
+        return 0;
+    }
+    const char* octets = (const char*)base;
+    inst->noeuds = (const NoeudCarte*)(octets + e->decalage[INST_NOEUDS]);
+    inst->textes = octets + e->decalage[INST_TEXTES];
+    inst->aretes = (const AreteCarte*)(octets + e->decalage[INST_ARETES]);
+    inst->feux = (const FeuRouge*)(octets + e->decalage[INST_FEUX]);
+    inst->nbFeux = e->nbFeux;
+    // Vues sur les sections : les pointeurs non const de Reseau et IndexFeux ne servent qu'en lecture
+    inst->reseau.nbNoeuds = n;
+    inst->reseau.nbAretes = e->nbAretesReseau;
+    inst->reseau.debut = (int*)(octets + e->decalage[INST_DEBUT]);
+    inst->reseau.cible = (int*)(octets + e->decalage[INST_CIBLE]);
+    inst->reseau.poids = (double*)(octets + e->decalage[INST_POIDS]);
+    inst->reseau.idArete = (int*)(octets + e->decalage[INST_ID_ARETE]);
+    inst->reseau.X = (int*)(octets + e->decalage[INST_X]);
+    inst->reseau.Y = (int*)(octets + e->decalage[INST_Y]);
+    inst->indexFeux.nbNoeuds = n;
+    inst->indexFeux.debut = (int*)(octets + e->decalage[INST_INDEX_DEBUT]);
+    inst->indexFeux.feux = (int*)(octets + e->decalage[INST_INDEX_FEUX]);
+    // Cohérence des tableaux d'indices et de la carte
+    Carte vue;
+    instantane_carte(inst, &vue);
+    if (!carte_verifier(&vue, NULL, 0) || !instantane_indices_valides(inst)) {
+        if (erreur) snprintf(erreur, tailleErreur, "%s : instantane incoherent", fichier);
+        instantane_fermer(inst);
+        return 0;
+    }
+    return 1;
+}
+
+#endif
@@ -0,0 +1,133 @@
+#ifndef ISOCHRONES_H
+#define ISOCHRONES_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "Reseau.h"
+#include "Recherche.h"
+#include "RoutageTemporel.h"
+
+/* ===================== Isochrones ===================== */
+/*
+ * Zone accessible depuis un nœud en une durée donnée : Dijkstra dépendant du temps (feux,
+ * congestion, arrêts, fermetures) arrêté dès que la date d'arrivée dépasse la limite. Seuls les
+ * nœuds atteints sont touchés, grâce aux marques de passage de l'espace de recherche.
+ * Les isochrones de plusieurs sources se calculent en parallèle, un espace de recherche par thread.
+ */
+
+typedef struct {
+    int* noeuds;     // Nœuds atteints, par durée croissante (la source en premier)
+    double* temps;   // Durée pour atteindre chacun depuis le départ
+    int nb;
+    int capacite;
+} Isochrone;
+
+void isochrone_liberer(Isochrone* iso) {
+    free(iso->noeuds);
+    free(iso->temps);
+    memset(iso, 0, sizeof(Isochrone));
+}
+
+static int isochrone_ajouter(Isochrone* iso, int noeud, double temps) {
+    if (iso->nb == iso->capacite) {
+        int cap = iso->capacite ? 2 * iso->capacite : 64;
+        int* noeuds = (int*)realloc(iso->noeuds, sizeof(int) * cap);
+        if (noeuds) iso->noeuds = noeuds;
+        double* t = (double*)realloc(iso->temps, sizeof(double) * cap);
+        if (t) iso->temps = t;
+        if (!noeuds || !t) return 0;
+        iso->capacite = cap;
+    }
+    iso->noeuds[iso->nb] = noeud;
+    iso->temps[iso->nb++] = temps;
+    return 1;
+}
+
+/**
+ * Nœuds atteints depuis 'source' en au plus dureeMax secondes, départ à la date 'depart'.
+ * L'isochrone est remplie (vidée d'abord) ; retourne 0 si la mémoire manque.
+ */
+int isochrone(const Reseau* r, const ParametresTemporels* prm, int source, double depart, double dureeMax,
+              EspaceRecherche* e, Isochrone* iso) {
+    iso->nb = 0;
+    if (source < 0 || source >= r->nbNoeuds || prm->vitesse <= 0) return 1;
+    double limite = depart + dureeMax;
+    espace_nouvelle_recherche(e);
+    espace_fixer(e, source, depart, -1, -1);
+    tas_inserer(&e->tas, depart, source);
+    while (e->tas.taille > 0) {
+        ElementTas x = tas_extraire(&e->tas);
+        int u = x.valeur;
+        double du = espace_dist(e, u);
+        if (x.cle > du) continue; // Entrée périmée
+        if (!isochrone_ajouter(iso, u, du - depart)) return 0;
+        int k;
+        for (k = r->debut[u]; k < r->debut[u + 1]; k++) {
+            if (arete_fermee(prm->fermetures, r->idArete[k])) continue;
+            int v = r->cible[k];
+            double a = arrivee_arete(r, prm, k, du);
+            if (a <= limite && a < espace_dist(e, v)) {
+                espace_fixer(e, v, a, u, k);
+                tas_inserer(&e->tas, a, v);
+            }
+        }
+    }
+    return 1;
+}
+
+/* ===================== Isochrones en lot ===================== */
+
+typedef struct {
+    const Reseau* r;
+    const ParametresTemporels* prm;
+    const int* sources;
+    int nbSources;
+    double depart;
+    double dureeMax;
+    Isochrone* resultats;
+    atomic_int prochaine;
+    atomic_int echec;
+} TravailIsochrones;
+
+static void* isochrones_travailleur(void* arg) {
+    TravailIsochrones* t = (TravailIsochrones*)arg;
+    EspaceRecherche e;
+    if (!espace_init(&e, t->r->nbNoeuds)) {
+        atomic_store(&t->echec, 1);
+        return NULL;
+    }
+    int i;
+    while ((i = atomic_fetch_add(&t->prochaine, 1)) < t->nbSources)
+        if (!isochrone(t->r, t->prm, t->sources[i], t->depart, t->dureeMax, &e, &t->resultats[i]))
+            atomic_store(&t->echec, 1);
+    espace_liberer(&e);
+    return NULL;
+}
+
+/**
+ * Isochrones de nbSources sources, réparties entre nbThreads threads (l'appelant compris) :
+ * resultats[i] est celle de sources[i], quel que soit le nombre de threads. Les isochrones doivent
+ * être initialisées (à zéro ou par un appel précédent). Retourne 0 si la mémoire a manqué.
+ */
+int isochrones_lot(const Reseau* r, const ParametresTemporels* prm, const int* sources, int nbSources,
+                   double depart, double dureeMax, int nbThreads, Isochrone* resultats) {
+    pthread_t threads[64];
+    TravailIsochrones t = { .r = r, .prm = prm, .sources = sources, .nbSources = nbSources, .depart = depart,
+                            .dureeMax = dureeMax, .resultats = resultats };
+    int i, lances = 0;
+    atomic_init(&t.prochaine, 0);
+    atomic_init(&t.echec, 0);
+    if (nbThreads > nbSources) nbThreads = nbSources;
+    if (nbThreads > 64) nbThreads = 64;
+    for (i = 1; i < nbThreads; i++)
+        if (pthread_create(&threads[lances], NULL, isochrones_travailleur, &t) == 0) lances++;
+    isochrones_travailleur(&t); // Le thread appelant travaille aussi
+    for (i = 0; i < lances; i++)
+        pthread_join(threads[i], NULL);
+    return !atomic_load(&t.echec);
+}
+
+#endif
@@ -0,0 +1,261 @@
+#ifndef LOT_REQUETES_H
+#define LOT_REQUETES_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "Reseau.h"
+#include "Recherche.h"
+#include "RoutageTemporel.h"
+#include "Virages.h"
+
+/* ===================== Requêtes en lot ===================== */
+/*
+ * Un pool de threads permanents traite des lots de requêtes (source, cible, profil). Chaque
+ * thread garde ses espaces de recherche d'un lot à l'autre. Le lot est découpé en plages
+ * contiguës, une par thread. Un thread prend les requêtes au début de sa plage. Quand sa plage
+ * est vide, il vole la moitié de la plage restante d'un autre thread, par la fin. Les longues
+ * requêtes ne bloquent donc pas un thread pendant que les autres attendent. Les résultats sont
+ * rangés dans l'ordre des requêtes, quel que soit le thread qui les a calculées.
+ */
+
+/* Profil de véhicule : paramètres de la recherche dépendante du temps, et virages */
+typedef struct {
+    ParametresTemporels prm;
+    const Virages* virages;    // NULL : virages gratuits (recherche sur les nœuds, plus rapide)
+} ProfilRequete;
+
+typedef struct {
+    int source;
+    int cible;
+    int profil;                // Indice dans le tableau des profils du lot
+    double depart;             // Date de départ (référence des cycles de feux)
+} Requete;
+
+/* Plage de requêtes d'un thread : [debut, fin) */
+typedef struct {
+    pthread_mutex_t verrou;
+    int debut;
+    int fin;
+} PlageRequetes;
+
+typedef struct PoolRequetes PoolRequetes;
+
+typedef struct {
+    PoolRequetes* pool;
+    int id;
+    EspaceRecherche espace;
+    EspaceVirages espaceVirages;   // Alloué à la première requête qui compte les virages
+    int avecVirages;
+    long nbTraitees;               // Requêtes calculées par ce thread (dernier lot)
+    long nbVols;
+} TravailleurRequetes;
+
+struct PoolRequetes {
+    const Reseau* r;
+    int nbThreads;                 // Appelant compris
+    pthread_t* threads;
+    int nbLances;                  // Threads lancés (threads[1 .. nbLances])
+    TravailleurRequetes* travailleurs;
+    PlageRequetes* plages;
+    pthread_mutex_t verrou;
+    pthread_cond_t reveil;         // Un lot est prêt, ou arrêt
+    pthread_cond_t fini;           // Le dernier travailleur a terminé le lot
+    unsigned long lot;             // Numéro du lot en cours
+    int actifs;                    // Travailleurs (hors appelant) qui n'ont pas fini le lot
+    int arret;
+    /* Lot en cours */
+    const Requete* requetes;
+    const ProfilRequete* profils;
+    Itineraire* resultats;
+};
+
+static void requete_calculer(TravailleurRequetes* t, int i) {
+    PoolRequetes* p = t->pool;
+    const Requete* q = &p->requetes[i];
+    const ProfilRequete* profil = &p->profils[q->profil];
+    if (profil->virages) {
+        if (!t->avecVirages) t->avecVirages = espace_virages_init(&t->espaceVirages, p->r->nbNoeuds, p->r->nbAretes);
+        if (t->avecVirages)
+            p->resultats[i] = itineraire_virages(p->r, &profil->prm, profil->virages, q->source, q->cible, q->depart,
+                                                 &t->espaceVirages);
+    } else {
+        p->resultats[i] = itineraire_temporel(p->r, &profil->prm, q->source, q->cible, q->depart, &t->espace);
+    }
+    t->nbTraitees++;
+}
+
+/* Prochaine requête de la plage du thread, -1 si elle est vide */
+static int plage_prendre(PlageRequetes* plage) {
+    int i = -1;
+    pthread_mutex_lock(&plage->verrou);
+    if (plage->debut < plage->fin) i = plage->debut++;
+    pthread_mutex_unlock(&plage->verrou);
+    return i;
+}
+
+/* Vole la moitié (arrondie au-dessus) de la plage restante d'un autre thread ; 0 si toutes sont vides */
+static int plage_voler(TravailleurRequetes* t) {
+    PoolRequetes* p = t->pool;
+    int k;
+    for (k = 1; k < p->nbThreads; k++) {
+        PlageRequetes* victime = &p->plages[(t->id + k) % p->nbThreads];
+        pthread_mutex_lock(&victime->verrou);
+        int reste = victime->fin - victime->debut;
+        int debut = victime->fin - (reste + 1) / 2, fin = victime->fin;
+        if (reste > 0) victime->fin = debut;
+        pthread_mutex_unlock(&victime->verrou);
+        if (reste > 0) {
+            PlageRequetes* moi = &p->plages[t->id];
+            pthread_mutex_lock(&moi->verrou);
+            moi->debut = debut;
+            moi->fin = fin;
+            pthread_mutex_unlock(&moi->verrou);
+            t->nbVols++;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void pool_requetes_traiter(TravailleurRequetes* t) {
+    PlageRequetes* plage = &t->pool->plages[t->id];
+    for (;;) {
+        int i = plage_prendre(plage);
+        if (i >= 0)
+            requete_calculer(t, i);
+        else if (!plage_voler(t))
+            return;
+    }
+}
+
+static void* pool_requetes_boucle(void* arg) {
+    TravailleurRequetes* t = (TravailleurRequetes*)arg;
+    PoolRequetes* p = t->pool;
+    unsigned long vu = 0;
+    for (;;) {
+        pthread_mutex_lock(&p->verrou);
+        while (p->lot == vu && !p->arret)
+            pthread_cond_wait(&p->reveil, &p->verrou);
+        if (p->arret) {
+            pthread_mutex_unlock(&p->verrou);
+            return NULL;
+        }
+        vu = p->lot;
+        pthread_mutex_unlock(&p->verrou);
+        pool_requetes_traiter(t);
+        pthread_mutex_lock(&p->verrou);
+        if (--p->actifs == 0) pthread_cond_signal(&p->fini);
+        pthread_mutex_unlock(&p->verrou);
+    }
+}
+
+void pool_requetes_liberer(PoolRequetes* p) {
+    int i;
+    if (!p) return;
+    if (p->threads) {
+        pthread_mutex_lock(&p->verrou);
+        p->arret = 1;
+        pthread_cond_broadcast(&p->reveil);
+        pthread_mutex_unlock(&p->verrou);
+        for (i = 1; i <= p->nbLances; i++)
+            pthread_join(p->threads[i], NULL);
+    }
+    if (p->travailleurs)
+        for (i = 0; i < p->nbThreads; i++) {
+            espace_liberer(&p->travailleurs[i].espace);
+            if (p->travailleurs[i].avecVirages) espace_virages_liberer(&p->travailleurs[i].espaceVirages);
+        }
+    if (p->plages)
+        for (i = 0; i < p->nbThreads; i++) pthread_mutex_destroy(&p->plages[i].verrou);
+    pthread_mutex_destroy(&p->verrou);
+    pthread_cond_destroy(&p->reveil);
+    pthread_cond_destroy(&p->fini);
+    free(p->threads);
+    free(p->travailleurs);
+    free(p->plages);
+    free(p);
+}
+
+/**
+ * Crée un pool de nbThreads threads (l'appelant compris) pour des requêtes sur le réseau r.
+ * Retourne NULL si la mémoire manque.
+ */
+PoolRequetes* pool_requetes_creer(const Reseau* r, int nbThreads) {
+    int i;
+    if (nbThreads < 1) nbThreads = 1;
+    PoolRequetes* p = (PoolRequetes*)calloc(1, sizeof(PoolRequetes));
+    if (!p) return NULL;
+    p->r = r;
+    p->nbThreads = nbThreads;
+    pthread_mutex_init(&p->verrou, NULL);
+    pthread_cond_init(&p->reveil, NULL);
+    pthread_cond_init(&p->fini, NULL);
+    p->travailleurs = (TravailleurRequetes*)calloc(nbThreads, sizeof(TravailleurRequetes));
+    p->plages = (PlageRequetes*)calloc(nbThreads, sizeof(PlageRequetes));
+    if (!p->travailleurs || !p->plages) {
+        free(p->plages);
+        p->plages = NULL;
+        pool_requetes_liberer(p);
+        return NULL;
+    }
+    for (i = 0; i < nbThreads; i++) pthread_mutex_init(&p->plages[i].verrou, NULL);
+    for (i = 0; i < nbThreads; i++) {
+        p->travailleurs[i].pool = p;
+        p->travailleurs[i].id = i;
+        if (!espace_init(&p->travailleurs[i].espace, r->nbNoeuds)) {
+            pool_requetes_liberer(p);
+            return NULL;
+        }
+    }
+    p->threads = (pthread_t*)malloc(sizeof(pthread_t) * nbThreads);
+    if (!p->threads) {
+        pool_requetes_liberer(p);
+        return NULL;
+    }
+    for (i = 1; i < nbThreads; i++) {
+        if (pthread_create(&p->threads[i], NULL, pool_requetes_boucle, &p->travailleurs[i]) != 0) {
+            pool_requetes_liberer(p); // Arrête les threads déjà lancés
+            return NULL;
+        }
+        p->nbLances = i;
+    }
+    return p;
+}
+
+/**
+ * Calcule les nb requêtes : resultats[i] est l'itinéraire de requetes[i] (coût : date d'arrivée),
+ * vide s'il n'y a pas de chemin. L'appelant travaille aussi et attend la fin du lot. Le réseau,
+ * les profils et ce qu'ils désignent ne doivent pas changer pendant l'appel.
+ */
+void pool_requetes_executer(PoolRequetes* p, const Requete* requetes, int nb, const ProfilRequete* profils,
+                            Itineraire* resultats) {
+    int i;
+    memset(resultats, 0, sizeof(Itineraire) * (nb > 0 ? nb : 0));
+    if (nb <= 0) return;
+    p->requetes = requetes;
+    p->profils = profils;
+    p->resultats = resultats;
+    // Plages de même taille, une par thread
+    for (i = 0; i < p->nbThreads; i++) {
+        pthread_mutex_lock(&p->plages[i].verrou);
+        p->plages[i].debut = (int)((long)nb * i / p->nbThreads);
+        p->plages[i].fin = (int)((long)nb * (i + 1) / p->nbThreads);
+        pthread_mutex_unlock(&p->plages[i].verrou);
+        p->travailleurs[i].nbTraitees = 0;
+        p->travailleurs[i].nbVols = 0;
+    }
+    pthread_mutex_lock(&p->verrou);
+    p->actifs = p->nbThreads - 1;
+    p->lot++;
+    pthread_cond_broadcast(&p->reveil);
+    pthread_mutex_unlock(&p->verrou);
+    pool_requetes_traiter(&p->travailleurs[0]);
+    pthread_mutex_lock(&p->verrou);
+    while (p->actifs > 0)
+        pthread_cond_wait(&p->fini, &p->verrou);
+    pthread_mutex_unlock(&p->verrou);
+}
+
+#endif
@@ -0,0 +1,807 @@
+#ifndef PARTITION_H
+#define PARTITION_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "Reseau.h"
+
+/* ===================== Partition multiniveau du réseau ===================== */
+/*
+ * Découpe le réseau en k parties de poids (nombre de nœuds) équilibrés en coupant peu d'arcs :
+ *  - contraction : les nœuds sont appariés deux à deux le long des arêtes les plus lourdes
+ *    (nombre d'arcs entre eux), jusqu'à un graphe de quelques dizaines de nœuds par partie ;
+ *  - découpage initial de ce petit graphe par bissection des coordonnées (barycentres) ;
+ *  - retour niveau par niveau : la partition est projetée puis affinée en déplaçant les nœuds
+ *    de bord vers la partie voisine qui réduit la coupe, sans dépasser la tolérance de poids.
+ * Appariement, contraction et recherche des déplacements sont répartis entre threads par blocs
+ * de nœuds en nombre fixe ; les déplacements sont appliqués dans l'ordre des blocs. Le résultat
+ * ne dépend donc pas du nombre de threads.
+ */
+
+#define PARTITION_BLOCS 64              // Blocs de nœuds au plus, répartis entre threads
+#define PARTITION_NOEUDS_BLOC 2048      // Taille minimale d'un bloc
+#define PARTITION_NOEUDS_PAR_PARTIE 30  // Taille visée du graphe contracté : 30 nœuds par partie
+#define PARTITION_PASSES 8              // Passes d'affinage par niveau au plus
+
+/* Graphe non orienté pondéré, une entrée par voisin */
+typedef struct {
+    int nbNoeuds;
+    int* debut;          // Voisins du nœud u : voisin[debut[u] .. debut[u+1]-1]
+    int* voisin;
+    int* poidsArete;     // Nombre d'arcs du réseau entre les deux nœuds (dans les deux sens)
+    int* poidsNoeud;     // Nombre de nœuds du réseau regroupés
+    double* X;           // Barycentre (découpage initial)
+    double* Y;
+    long poidsTotal;
+} GraphePartition;
+
+typedef struct {
+    int nbParties;
+    long coupe;          // Arcs du réseau entre deux parties
+    double desequilibre; // Poids de la plus grosse partie / poids moyen - 1
+    int nbNiveaux;       // Graphes de la contraction, réseau compris
+} StatsPartition;
+
+void graphe_partition_liberer(GraphePartition* g) {
+    if (!g) return;
+    free(g->debut);
+    free(g->voisin);
+    free(g->poidsArete);
+    free(g->poidsNoeud);
+    free(g->X);
+    free(g->Y);
+    free(g);
+}
+
+static GraphePartition* graphe_partition_allouer(int nbNoeuds, int nbVoisins) {
+    GraphePartition* g = (GraphePartition*)calloc(1, sizeof(GraphePartition));
+    if (!g) return NULL;
+    g->nbNoeuds = nbNoeuds;
+    g->debut = (int*)calloc(nbNoeuds + 1, sizeof(int));
+    g->voisin = (int*)malloc(sizeof(int) * (nbVoisins > 0 ? nbVoisins : 1));
+    g->poidsArete = (int*)malloc(sizeof(int) * (nbVoisins > 0 ? nbVoisins : 1));
+    g->poidsNoeud = (int*)malloc(sizeof(int) * (nbNoeuds > 0 ? nbNoeuds : 1));
+    g->X = (double*)malloc(sizeof(double) * (nbNoeuds > 0 ? nbNoeuds : 1));
+    g->Y = (double*)malloc(sizeof(double) * (nbNoeuds > 0 ? nbNoeuds : 1));
+    if (!g->debut || !g->voisin || !g->poidsArete || !g->poidsNoeud || !g->X || !g->Y) {
+        graphe_partition_liberer(g);
+        return NULL;
+    }
+    return g;
+}
+
+/* ===================== Exécution par blocs ===================== */
+
+typedef struct {
+    void (*tache)(void* contexte, int bloc);
+    void* contexte;
+    int nbBlocs;
+    atomic_int prochain;
+} TravailPartition;
+
+static void* partition_travailleur(void* arg) {
+    TravailPartition* t = (TravailPartition*)arg;
+    int b;
+    while ((b = atomic_fetch_add(&t->prochain, 1)) < t->nbBlocs)
+        t->tache(t->contexte, b);
+    return NULL;
+}
+
+/* Exécute tache(contexte, b) pour chaque bloc b, réparti entre nbThreads threads */
+static void partition_parallele(int nbThreads, int nbBlocs, void (*tache)(void*, int), void* contexte) {
+    pthread_t threads[64];
+    TravailPartition t;
+    int i, lances = 0;
+    t.tache = tache;
+    t.contexte = contexte;
+    t.nbBlocs = nbBlocs;
+    atomic_init(&t.prochain, 0);
+    if (nbThreads > nbBlocs) nbThreads = nbBlocs;
+    if (nbThreads > 64) nbThreads = 64;
+    for (i = 1; i < nbThreads; i++)
+        if (pthread_create(&threads[lances], NULL, partition_travailleur, &t) == 0) lances++;
+    partition_travailleur(&t); // Le thread appelant travaille aussi
+    for (i = 0; i < lances; i++)
+        pthread_join(threads[i], NULL);
+}
+
+static int partition_nb_blocs(int nbNoeuds) {
+    int b = nbNoeuds / PARTITION_NOEUDS_BLOC + 1;
+    return b < PARTITION_BLOCS ? b : PARTITION_BLOCS;
+}
+
+/* Premier nœud du bloc b */
+static inline int partition_debut_bloc(int nbNoeuds, int nbBlocs, int b) {
+    return (int)((long long)nbNoeuds * b / nbBlocs);
+}
+
+/* ===================== Construction ===================== */
+
+static int comparer_voisins(const void* a, const void* b) {
+    const int* x = (const int*)a;
+    const int* y = (const int*)b;
+    return (x[0] > y[0]) - (x[0] < y[0]);
+}
+
+/* Trie des couples (voisin, poids) par voisin et fusionne les doublons ; retourne le nouveau nombre */
+static int fusionner_voisins(int* couples, int nb) {
+    int i, n = 0;
+    if (nb <= 1) return nb;
+    qsort(couples, nb, 2 * sizeof(int), comparer_voisins);
+    for (i = 0; i < nb; i++) {
+        if (n > 0 && couples[2 * (n - 1)] == couples[2 * i]) {
+            couples[2 * (n - 1) + 1] += couples[2 * i + 1];
+        } else {
+            couples[2 * n] = couples[2 * i];
+            couples[2 * n + 1] = couples[2 * i + 1];
+            n++;
+        }
+    }
+    return n;
+}
+
+/**
+ * Graphe non orienté du réseau : chaque arc u -> v compte 1 dans le poids de l'arête {u, v}.
+ */
+GraphePartition* graphe_partition_creer(const Reseau* r) {
+    int n = r->nbNoeuds, u, k;
+    int* degre = (int*)calloc(n + 1, sizeof(int));
+    int* couples = (int*)malloc(sizeof(int) * 4 * (r->nbAretes > 0 ? r->nbAretes : 1));
+    if (!degre || !couples) {
+        free(degre);
+        free(couples);
+        return NULL;
+    }
+    // Arcs sortants et entrants de chaque nœud, rangés par nœud (comptage)
+    for (u = 0; u < n; u++)
+        for (k = r->debut[u]; k < r->debut[u + 1]; k++)
+            if (r->cible[k] != u) {
+                degre[u + 1]++;
+                degre[r->cible[k] + 1]++;
+            }
+    for (u = 0; u < n; u++) degre[u + 1] += degre[u];
+    int* curseur = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    if (!curseur) {
+        free(degre);
+        free(couples);
+        return NULL;
+    }
+    memcpy(curseur, degre, sizeof(int) * n);
+    for (u = 0; u < n; u++)
+        for (k = r->debut[u]; k < r->debut[u + 1]; k++) {
+            int v = r->cible[k];
+            if (v == u) continue;
+            couples[2 * curseur[u]] = v;
+            couples[2 * curseur[u]++ + 1] = 1;
+            couples[2 * curseur[v]] = u;
+            couples[2 * curseur[v]++ + 1] = 1;
+        }
+    free(curseur);
+    // Fusion des doublons de chaque nœud, sur place
+    int total = 0;
+    for (u = 0; u < n; u++) {
+        int nb = fusionner_voisins(couples + 2 * degre[u], degre[u + 1] - degre[u]);
+        memmove(couples + 2 * total, couples + 2 * degre[u], sizeof(int) * 2 * nb);
+        degre[u] = total;
+        total += nb;
+    }
+    degre[n] = total;
+    GraphePartition* g = graphe_partition_allouer(n, total);
+    if (g) {
+        memcpy(g->debut, degre, sizeof(int) * (n + 1));
+        for (k = 0; k < total; k++) {
+            g->voisin[k] = couples[2 * k];
+            g->poidsArete[k] = couples[2 * k + 1];
+        }
+        for (u = 0; u < n; u++) {
+            g->poidsNoeud[u] = 1;
+            g->X[u] = r->X[u];
+            g->Y[u] = r->Y[u];
+        }
+        g->poidsTotal = n;
+    }
+    free(degre);
+    free(couples);
+    return g;
+}
+
+/* ===================== Contraction ===================== */
+
+typedef struct {
+    const GraphePartition* g;
+    int* partenaire;       // Nœud apparié (lui-même s'il reste seul)
+    int* carte;            // Nœud du graphe contracté
+    int* nbRepresentants;  // Par bloc
+    int nbBlocs;
+    int poidsMax;          // Poids maximal d'un nœud contracté
+    GraphePartition* grossier;
+    int** couples;         // Voisins (contractés) de chaque bloc du graphe contracté
+    int* debutBloc;        // Premier nœud contracté de chaque bloc
+    int echec;
+} Contraction;
+
+/* Appariement lourd dans un bloc : chaque nœud libre prend son voisin libre du même bloc relié par
+   l'arête la plus lourde, à poids égal le plus léger */
+static void apparier_bloc(void* contexte, int b) {
+    Contraction* c = (Contraction*)contexte;
+    const GraphePartition* g = c->g;
+    int premier = partition_debut_bloc(g->nbNoeuds, c->nbBlocs, b);
+    int dernier = partition_debut_bloc(g->nbNoeuds, c->nbBlocs, b + 1), u, k, nb = 0;
+    for (u = premier; u < dernier; u++) {
+        if (c->partenaire[u] >= 0) continue;
+        int meilleur = -1;
+        for (k = g->debut[u]; k < g->debut[u + 1]; k++) {
+            int v = g->voisin[k];
+            if (v < premier || v >= dernier || v == u || c->partenaire[v] >= 0) continue;
+            if (g->poidsNoeud[u] + g->poidsNoeud[v] > c->poidsMax) continue;
+            if (meilleur < 0 || g->poidsArete[k] > g->poidsArete[meilleur] ||
+                (g->poidsArete[k] == g->poidsArete[meilleur] && g->poidsNoeud[v] < g->poidsNoeud[g->voisin[meilleur]]))
+                meilleur = k;
+        }
+        if (meilleur >= 0) {
+            c->partenaire[u] = g->voisin[meilleur];
+            c->partenaire[g->voisin[meilleur]] = u;
+        } else {
+            c->partenaire[u] = u;
+        }
+        nb++;
+    }
+    c->nbRepresentants[b] = nb;
+}
+
+/* Numérote les nœuds contractés du bloc (représentant = le plus petit des deux) */
+static void numeroter_bloc(void* contexte, int b) {
+    Contraction* c = (Contraction*)contexte;
+    int premier = partition_debut_bloc(c->g->nbNoeuds, c->nbBlocs, b);
+    int dernier = partition_debut_bloc(c->g->nbNoeuds, c->nbBlocs, b + 1), u, id = c->debutBloc[b];
+    for (u = premier; u < dernier; u++)
+        if (c->partenaire[u] >= u) {
+            c->carte[u] = id;
+            c->carte[c->partenaire[u]] = id++;
+        }
+}
+
+/* Voisins des nœuds contractés du bloc : union des voisins des deux nœuds, doublons fusionnés */
+static void contracter_bloc(void* contexte, int b) {
+    Contraction* c = (Contraction*)contexte;
+    const GraphePartition* g = c->g;
+    GraphePartition* h = c->grossier;
+    int premier = partition_debut_bloc(g->nbNoeuds, c->nbBlocs, b);
+    int dernier = partition_debut_bloc(g->nbNoeuds, c->nbBlocs, b + 1), u, k, j, total = 0;
+    for (u = premier; u < dernier; u++) total += g->debut[u + 1] - g->debut[u];
+    int* couples = (int*)malloc(sizeof(int) * 2 * (total > 0 ? total : 1));
+    if (!couples) {
+        c->echec = 1;
+        return;
+    }
+    total = 0;
+    for (u = premier; u < dernier; u++) {
+        if (c->partenaire[u] < u) continue;
+        int cu = c->carte[u], debut = total, extremites[2] = { u, c->partenaire[u] };
+        for (j = 0; j < (extremites[1] == u ? 1 : 2); j++) {
+            int w = extremites[j];
+            for (k = g->debut[w]; k < g->debut[w + 1]; k++) {
+                int cv = c->carte[g->voisin[k]];
+                if (cv == cu) continue;
+                couples[2 * total] = cv;
+                couples[2 * total++ + 1] = g->poidsArete[k];
+            }
+        }
+        int nb = fusionner_voisins(couples + 2 * debut, total - debut);
+        total = debut + nb;
+        h->debut[cu + 1] = nb;
+        int p = u, q = c->partenaire[u];
+        h->poidsNoeud[cu] = g->poidsNoeud[p] + (q != p ? g->poidsNoeud[q] : 0);
+        h->X[cu] = (g->X[p] * g->poidsNoeud[p] + (q != p ? g->X[q] * g->poidsNoeud[q] : 0.0)) / h->poidsNoeud[cu];
+        h->Y[cu] = (g->Y[p] * g->poidsNoeud[p] + (q != p ? g->Y[q] * g->poidsNoeud[q] : 0.0)) / h->poidsNoeud[cu];
+    }
+    c->couples[b] = couples;
+}
+
+/* Recopie les voisins du bloc à leur place définitive */
+static void recopier_bloc(void* contexte, int b) {
+    Contraction* c = (Contraction*)contexte;
+    GraphePartition* h = c->grossier;
+    int premier = c->debutBloc[b], dernier = c->debutBloc[b + 1], k;
+    int nb = h->debut[dernier] - h->debut[premier];
+    for (k = 0; k < nb; k++) {
+        h->voisin[h->debut[premier] + k] = c->couples[b][2 * k];
+        h->poidsArete[h->debut[premier] + k] = c->couples[b][2 * k + 1];
+    }
+}
+
+/**
+ * Contracte g par appariement. carte (g->nbNoeuds entrées) reçoit le nœud contracté de chaque nœud.
+ */
+static GraphePartition* graphe_partition_contracter(const GraphePartition* g, int poidsMax, int* carte, int nbThreads) {
+    Contraction c;
+    int b, u;
+    memset(&c, 0, sizeof(c));
+    c.g = g;
+    c.carte = carte;
+    c.poidsMax = poidsMax;
+    c.nbBlocs = partition_nb_blocs(g->nbNoeuds);
+    c.partenaire = (int*)malloc(sizeof(int) * (g->nbNoeuds > 0 ? g->nbNoeuds : 1));
+    c.nbRepresentants = (int*)calloc(c.nbBlocs, sizeof(int));
+    c.debutBloc = (int*)calloc(c.nbBlocs + 1, sizeof(int));
+    c.couples = (int**)calloc(c.nbBlocs, sizeof(int*));
+    if (!c.partenaire || !c.nbRepresentants || !c.debutBloc || !c.couples) goto fin;
+    for (u = 0; u < g->nbNoeuds; u++) c.partenaire[u] = -1;
+    partition_parallele(nbThreads, c.nbBlocs, apparier_bloc, &c);
+    for (b = 0; b < c.nbBlocs; b++) c.debutBloc[b + 1] = c.debutBloc[b] + c.nbRepresentants[b];
+    partition_parallele(nbThreads, c.nbBlocs, numeroter_bloc, &c);
+    int nc = c.debutBloc[c.nbBlocs];
+    // Premier passage : voisins de chaque bloc dans un tampon, et degré de chaque nœud contracté
+    c.grossier = graphe_partition_allouer(nc, 0);
+    if (!c.grossier) goto fin;
+    partition_parallele(nbThreads, c.nbBlocs, contracter_bloc, &c);
+    if (c.echec) goto fin;
+    GraphePartition* h = c.grossier;
+    for (u = 0; u < nc; u++) h->debut[u + 1] += h->debut[u];
+    int* voisin = (int*)realloc(h->voisin, sizeof(int) * (h->debut[nc] > 0 ? h->debut[nc] : 1));
+    if (voisin) h->voisin = voisin;
+    int* poidsArete = (int*)realloc(h->poidsArete, sizeof(int) * (h->debut[nc] > 0 ? h->debut[nc] : 1));
+    if (poidsArete) h->poidsArete = poidsArete;
+    if (!voisin || !poidsArete) goto fin;
+    partition_parallele(nbThreads, c.nbBlocs, recopier_bloc, &c);
+    h->poidsTotal = g->poidsTotal;
+    c.grossier = NULL;
+    for (b = 0; b < c.nbBlocs; b++) free(c.couples[b]);
+    free(c.couples);
+    free(c.partenaire);
+    free(c.nbRepresentants);
+    free(c.debutBloc);
+    return h;
+fin:
+    if (c.couples)
+        for (b = 0; b < c.nbBlocs; b++) free(c.couples[b]);
+    free(c.couples);
+    free(c.partenaire);
+    free(c.nbRepresentants);
+    free(c.debutBloc);
+    graphe_partition_liberer(c.grossier);
+    return NULL;
+}
+
+/* ===================== Découpage initial ===================== */
+
+typedef struct {
+    double cle;
+    int noeud;
+} ClePartition;
+
+static int comparer_cle_partition(const void* a, const void* b) {
+    const ClePartition* x = (const ClePartition*)a;
+    const ClePartition* y = (const ClePartition*)b;
+    if (x->cle != y->cle) return (x->cle < y->cle) ? -1 : 1;
+    return x->noeud - y->noeud;
+}
+
+/*
+ * Sélection pondérée : réordonne t pour que ses 'coupe' premiers éléments soient les plus petits
+ * (clé, nœud), où coupe est le premier rang dont le poids cumulé, plus la moitié du sien, atteint
+ * 'vise' (n si aucun). Même découpage qu'un tri complet, en temps linéaire en moyenne.
+ */
+static int selection_ponderee(const GraphePartition* g, ClePartition* t, int n, double vise) {
+    int bas = 0, haut = n, i;
+    double avant = 0.0;
+    while (bas < haut) {
+        ClePartition pivot = t[bas + (haut - bas) / 2], echange;
+        t[bas + (haut - bas) / 2] = t[haut - 1];
+        t[haut - 1] = pivot;
+        int p = bas;
+        double poidsInferieurs = 0.0;
+        for (i = bas; i < haut - 1; i++)
+            if (comparer_cle_partition(&t[i], &pivot) < 0) {
+                poidsInferieurs += g->poidsNoeud[t[i].noeud];
+                echange = t[i];
+                t[i] = t[p];
+                t[p++] = echange;
+            }
+        t[haut - 1] = t[p];
+        t[p] = pivot;
+        if (avant + poidsInferieurs + g->poidsNoeud[pivot.noeud] / 2.0 >= vise) {
+            haut = p;
+        } else {
+            avant += poidsInferieurs + g->poidsNoeud[pivot.noeud];
+            bas = p + 1;
+        }
+    }
+    return bas;
+}
+
+/* Bissection récursive des barycentres, coupée au poids proportionnel au nombre de parties */
+static void bissection_ponderee(const GraphePartition* g, ClePartition* t, int n, int premiere, int nbParties,
+                                int* partie) {
+    int i;
+    if (nbParties <= 1 || n <= 1) {
+        for (i = 0; i < n; i++) partie[t[i].noeud] = premiere;
+        return;
+    }
+    double minX = INFINITY, maxX = -INFINITY, minY = INFINITY, maxY = -INFINITY;
+    long poids = 0;
+    for (i = 0; i < n; i++) {
+        int u = t[i].noeud;
+        if (g->X[u] < minX) minX = g->X[u];
+        if (g->X[u] > maxX) maxX = g->X[u];
+        if (g->Y[u] < minY) minY = g->Y[u];
+        if (g->Y[u] > maxY) maxY = g->Y[u];
+        poids += g->poidsNoeud[u];
+    }
+    int selonX = (maxX - minX) >= (maxY - minY);
+    for (i = 0; i < n; i++)
+        t[i].cle = selonX ? g->X[t[i].noeud] : g->Y[t[i].noeud];
+    int gauche = nbParties / 2;
+    int coupe = selection_ponderee(g, t, n, (double)poids * gauche / nbParties);
+    if (coupe > n - 1) coupe = n - 1;
+    if (coupe == 0) coupe = 1;
+    bissection_ponderee(g, t, coupe, premiere, gauche, partie);
+    bissection_ponderee(g, t + coupe, n - coupe, premiere + gauche, nbParties - gauche, partie);
+}
+
+/* ===================== Affinage ===================== */
+
+typedef struct {
+    int noeud;
+    int cible;
+} DeplacementPartition;
+
+typedef struct {
+    const GraphePartition* g;
+    int* partie;
+    long* poidsPartie;
+    int nbParties;
+    long poidsMax;
+    int nbBlocs;
+    long* connexion;              // nbParties entrées par bloc, remises à zéro après usage
+    DeplacementPartition** candidats; // Par bloc
+    int* nbCandidats;
+    int echec;
+} Affinage;
+
+/*
+ * Meilleure partie voisine de u selon la partition courante : gain = arcs vers elle - arcs vers la
+ * partie de u. Retourne -1 si u n'a aucun voisin dans une autre partie (ou aucune n'a de place
+ * quand 'place' est vrai).
+ */
+static int meilleure_partie(const Affinage* a, long* connexion, int u, int place, long* gain) {
+    const GraphePartition* g = a->g;
+    int k, p = a->partie[u], meilleure = -1;
+    for (k = g->debut[u]; k < g->debut[u + 1] && a->partie[g->voisin[k]] == p; k++)
+        ;
+    if (k == g->debut[u + 1]) return -1; // Nœud intérieur
+    for (k = g->debut[u]; k < g->debut[u + 1]; k++)
+        connexion[a->partie[g->voisin[k]]] += g->poidsArete[k];
+    for (k = g->debut[u]; k < g->debut[u + 1]; k++) {
+        int q = a->partie[g->voisin[k]];
+        if (q == p) continue;
+        if (place && a->poidsPartie[q] + g->poidsNoeud[u] > a->poidsMax) continue;
+        if (meilleure < 0 || connexion[q] > connexion[meilleure] ||
+            (connexion[q] == connexion[meilleure] && a->poidsPartie[q] < a->poidsPartie[meilleure]))
+            meilleure = q;
+    }
+    if (meilleure >= 0) *gain = connexion[meilleure] - connexion[p];
+    for (k = g->debut[u]; k < g->debut[u + 1]; k++)
+        connexion[a->partie[g->voisin[k]]] = 0;
+    return meilleure;
+}
+
+/* Cherche les déplacements utiles du bloc d'après la partition au début de la passe */
+static void chercher_deplacements(void* contexte, int b) {
+    Affinage* a = (Affinage*)contexte;
+    const GraphePartition* g = a->g;
+    int premier = partition_debut_bloc(g->nbNoeuds, a->nbBlocs, b);
+    int dernier = partition_debut_bloc(g->nbNoeuds, a->nbBlocs, b + 1), u, capacite = 0;
+    long* connexion = a->connexion + (long)b * a->nbParties;
+    a->nbCandidats[b] = 0;
+    for (u = premier; u < dernier; u++) {
+        long gain;
+        int p = a->partie[u];
+        int q = meilleure_partie(a, connexion, u, 0, &gain);
+        if (q < 0) continue;
+        if (!(gain > 0 || (gain == 0 && a->poidsPartie[q] + g->poidsNoeud[u] < a->poidsPartie[p]) ||
+              a->poidsPartie[p] > a->poidsMax))
+            continue;
+        if (a->nbCandidats[b] == capacite) {
+            capacite = capacite ? 2 * capacite : 256;
+            DeplacementPartition* t = (DeplacementPartition*)realloc(a->candidats[b], sizeof(DeplacementPartition) * capacite);
+            if (!t) {
+                a->echec = 1;
+                return;
+            }
+            a->candidats[b] = t;
+        }
+        a->candidats[b][a->nbCandidats[b]].noeud = u;
+        a->candidats[b][a->nbCandidats[b]++].cible = q;
+    }
+}
+
+/* Passes d'affinage : recherche en parallèle, puis application dans l'ordre des blocs avec le gain
+   recalculé, pour que la coupe ne remonte jamais. Retourne 0 si la mémoire manque. */
+static int affiner(const GraphePartition* g, int* partie, int nbParties, double tolerance, int nbThreads) {
+    Affinage a;
+    int b, i, passe, u;
+    memset(&a, 0, sizeof(a));
+    a.g = g;
+    a.partie = partie;
+    a.nbParties = nbParties;
+    a.poidsMax = (long)ceil((1.0 + tolerance) * g->poidsTotal / nbParties);
+    a.nbBlocs = partition_nb_blocs(g->nbNoeuds);
+    a.poidsPartie = (long*)calloc(nbParties, sizeof(long));
+    a.connexion = (long*)calloc((size_t)a.nbBlocs * nbParties, sizeof(long));
+    a.candidats = (DeplacementPartition**)calloc(a.nbBlocs, sizeof(DeplacementPartition*));
+    a.nbCandidats = (int*)calloc(a.nbBlocs, sizeof(int));
+    if (!a.poidsPartie || !a.connexion || !a.candidats || !a.nbCandidats) a.echec = 1;
+    for (u = 0; !a.echec && u < g->nbNoeuds; u++) a.poidsPartie[partie[u]] += g->poidsNoeud[u];
+    for (passe = 0; !a.echec && passe < PARTITION_PASSES; passe++) {
+        partition_parallele(nbThreads, a.nbBlocs, chercher_deplacements, &a);
+        if (a.echec) break;
+        int nbDeplaces = 0;
+        for (b = 0; b < a.nbBlocs; b++)
+            for (i = 0; i < a.nbCandidats[b]; i++) {
+                long gain;
+                u = a.candidats[b][i].noeud;
+                int p = partie[u], w = g->poidsNoeud[u];
+                int q = meilleure_partie(&a, a.connexion, u, 1, &gain);
+                if (q < 0) continue;
+                if (gain > 0 || (gain == 0 && a.poidsPartie[q] + w < a.poidsPartie[p]) || a.poidsPartie[p] > a.poidsMax) {
+                    partie[u] = q;
+                    a.poidsPartie[p] -= w;
+                    a.poidsPartie[q] += w;
+                    nbDeplaces++;
+                }
+            }
+        if (nbDeplaces == 0) break;
+    }
+    int ok = !a.echec;
+    if (a.candidats)
+        for (b = 0; b < a.nbBlocs; b++) free(a.candidats[b]);
+    free(a.candidats);
+    free(a.nbCandidats);
+    free(a.connexion);
+    free(a.poidsPartie);
+    return ok;
+}
+
+/* ===================== Partition ===================== */
+
+/* Contraction, découpage du graphe contracté, puis projection et affinage niveau par niveau */
+static int* partitionner_multiniveau(const GraphePartition* g, int nbParties, double tolerance, int nbThreads,
+                                     int* nbNiveaux) {
+    GraphePartition* niveaux[64];
+    int* cartes[64];
+    int nb = 1, i, u;
+    niveaux[0] = (GraphePartition*)g;
+    if (nbParties < 1) nbParties = 1;
+    // 1. Contraction jusqu'à ~30 nœuds par partie, tant que le graphe rétrécit d'au moins 10 %
+    long poidsMax = g->poidsTotal / ((long)nbParties * PARTITION_NOEUDS_PAR_PARTIE / 2) + 1;
+    while (nb < 64 && niveaux[nb - 1]->nbNoeuds > nbParties * PARTITION_NOEUDS_PAR_PARTIE) {
+        GraphePartition* fin = niveaux[nb - 1];
+        cartes[nb - 1] = (int*)malloc(sizeof(int) * (fin->nbNoeuds > 0 ? fin->nbNoeuds : 1));
+        GraphePartition* grossier = cartes[nb - 1] ?
+            graphe_partition_contracter(fin, (int)(poidsMax < INT_MAX ? poidsMax : INT_MAX), cartes[nb - 1], nbThreads) : NULL;
+        if (!grossier || grossier->nbNoeuds > 0.9 * fin->nbNoeuds) {
+            graphe_partition_liberer(grossier);
+            free(cartes[nb - 1]);
+            break;
+        }
+        niveaux[nb++] = grossier;
+    }
+    if (nbNiveaux) *nbNiveaux = nb;
+    // 2. Découpage initial du graphe le plus contracté
+    GraphePartition* h = niveaux[nb - 1];
+    int* partie = (int*)malloc(sizeof(int) * (h->nbNoeuds > 0 ? h->nbNoeuds : 1));
+    ClePartition* t = (ClePartition*)malloc(sizeof(ClePartition) * (h->nbNoeuds > 0 ? h->nbNoeuds : 1));
+    int ok = partie && t;
+    if (ok) {
+        for (u = 0; u < h->nbNoeuds; u++) t[u].noeud = u;
+        bissection_ponderee(h, t, h->nbNoeuds, 0, nbParties, partie);
+        ok = affiner(h, partie, nbParties, tolerance, nbThreads);
+    }
+    free(t);
+    // 3. Projection et affinage, niveau par niveau
+    for (i = nb - 2; i >= 0; i--) {
+        int* fine = ok ? (int*)malloc(sizeof(int) * (niveaux[i]->nbNoeuds > 0 ? niveaux[i]->nbNoeuds : 1)) : NULL;
+        if (fine) {
+            for (u = 0; u < niveaux[i]->nbNoeuds; u++) fine[u] = partie[cartes[i][u]];
+            ok = affiner(niveaux[i], fine, nbParties, tolerance, nbThreads);
+        } else {
+            ok = 0;
+        }
+        free(partie);
+        partie = fine;
+        free(cartes[i]);
+        graphe_partition_liberer(niveaux[i + 1]);
+    }
+    if (!ok) {
+        free(partie);
+        return NULL;
+    }
+    return partie;
+}
+
+/* Poids des arêtes coupées (deux fois chaque arête) et poids de la plus grosse partie */
+static void partition_mesurer(const GraphePartition* g, const int* partie, int nbParties, long* coupe, long* poidsMax) {
+    long* poids = (long*)calloc(nbParties, sizeof(long));
+    int u, k;
+    *coupe = 0;
+    *poidsMax = 0;
+    for (u = 0; u < g->nbNoeuds; u++) {
+        for (k = g->debut[u]; k < g->debut[u + 1]; k++)
+            if (partie[g->voisin[k]] != partie[u]) *coupe += g->poidsArete[k];
+        if (poids) poids[partie[u]] += g->poidsNoeud[u];
+    }
+    for (k = 0; poids && k < nbParties; k++)
+        if (poids[k] > *poidsMax) *poidsMax = poids[k];
+    free(poids);
+}
+
+/**
+ * Partition d'un graphe en nbParties parties. La partition multiniveau est comparée à la bissection
+ * des coordonnées du graphe complet, affinée de la même façon : sur une grille régulière, la seconde
+ * est déjà presque optimale. La meilleure coupe dans la tolérance l'emporte. Retourne la partie de
+ * chaque nœud (à libérer), ou NULL si la mémoire manque.
+ */
+static int* partitionner_graphe(const GraphePartition* g, int nbParties, double tolerance, int nbThreads,
+                                int* nbNiveaux) {
+    if (nbParties <= 1) {
+        if (nbNiveaux) *nbNiveaux = 1;
+        return (int*)calloc(g->nbNoeuds > 0 ? g->nbNoeuds : 1, sizeof(int));
+    }
+    int* partie = partitionner_multiniveau(g, nbParties, tolerance, nbThreads, nbNiveaux);
+    int* indice = partie ? (int*)malloc(sizeof(int) * (g->nbNoeuds > 0 ? g->nbNoeuds : 1)) : NULL;
+    ClePartition* t = indice ? (ClePartition*)malloc(sizeof(ClePartition) * (g->nbNoeuds > 0 ? g->nbNoeuds : 1)) : NULL;
+    int u;
+    if (t) {
+        for (u = 0; u < g->nbNoeuds; u++) t[u].noeud = u;
+        bissection_ponderee(g, t, g->nbNoeuds, 0, nbParties, indice);
+    }
+    if (t && affiner(g, indice, nbParties, tolerance, nbThreads)) {
+        long coupe[2], poids[2], limite = (long)ceil((1.0 + tolerance) * g->poidsTotal / nbParties);
+        partition_mesurer(g, partie, nbParties, &coupe[0], &poids[0]);
+        partition_mesurer(g, indice, nbParties, &coupe[1], &poids[1]);
+        int equilibre[2] = { poids[0] <= limite, poids[1] <= limite };
+        if (equilibre[1] > equilibre[0] || (equilibre[1] == equilibre[0] && coupe[1] < coupe[0])) {
+            int* echange = partie;
+            partie = indice;
+            indice = echange;
+        }
+    }
+    free(t);
+    free(indice);
+    return partie;
+}
+
+/**
+ * Coupe (arcs du réseau entre deux parties) et déséquilibre d'une partition quelconque.
+ */
+void partition_evaluer(const Reseau* r, const int* partie, int nbParties, StatsPartition* stats) {
+    int u, k;
+    long* poids = (long*)calloc(nbParties > 0 ? nbParties : 1, sizeof(long));
+    stats->nbParties = nbParties;
+    stats->coupe = 0;
+    stats->desequilibre = 0.0;
+    for (u = 0; u < r->nbNoeuds; u++)
+        for (k = r->debut[u]; k < r->debut[u + 1]; k++)
+            if (partie[u] != partie[r->cible[k]]) stats->coupe++;
+    if (!poids) return;
+    long max = 0;
+    for (u = 0; u < r->nbNoeuds; u++) poids[partie[u]]++;
+    for (k = 0; k < nbParties; k++)
+        if (poids[k] > max) max = poids[k];
+    if (r->nbNoeuds > 0) stats->desequilibre = (double)max * nbParties / r->nbNoeuds - 1.0;
+    free(poids);
+}
+
+/**
+ * Partition multiniveau du réseau en nbParties parties (nombre de nœuds équilibré à 'tolerance'
+ * près, par exemple 0.03). Retourne la partie de chaque nœud (à libérer) ; stats peut être NULL.
+ */
+int* partition_multiniveau(const Reseau* r, int nbParties, double tolerance, int nbThreads, StatsPartition* stats) {
+    GraphePartition* g = graphe_partition_creer(r);
+    if (!g) return NULL;
+    int nbNiveaux = 0;
+    int* partie = partitionner_graphe(g, nbParties, tolerance, nbThreads, &nbNiveaux);
+    graphe_partition_liberer(g);
+    if (partie && stats) {
+        partition_evaluer(r, partie, nbParties, stats);
+        stats->nbNiveaux = nbNiveaux;
+    }
+    return partie;
+}
+
+/* Sous-graphe des nœuds de la partie p ; origine[i] reçoit le nœud de g du i-ème nœud */
+static GraphePartition* graphe_partition_extraire(const GraphePartition* g, const int* partie, int p, int* local,
+                                                  int* origine) {
+    int u, k, n = 0, m = 0;
+    for (u = 0; u < g->nbNoeuds; u++)
+        if (partie[u] == p) {
+            local[u] = n;
+            origine[n++] = u;
+        }
+    for (u = 0; u < n; u++)
+        for (k = g->debut[origine[u]]; k < g->debut[origine[u] + 1]; k++)
+            if (partie[g->voisin[k]] == p) m++;
+    GraphePartition* h = graphe_partition_allouer(n, m);
+    if (!h) return NULL;
+    m = 0;
+    for (u = 0; u < n; u++) {
+        int v = origine[u];
+        for (k = g->debut[v]; k < g->debut[v + 1]; k++)
+            if (partie[g->voisin[k]] == p) {
+                h->voisin[m] = local[g->voisin[k]];
+                h->poidsArete[m++] = g->poidsArete[k];
+            }
+        h->debut[u + 1] = m;
+        h->poidsNoeud[u] = g->poidsNoeud[v];
+        h->X[u] = g->X[v];
+        h->Y[u] = g->Y[v];
+        h->poidsTotal += g->poidsNoeud[v];
+    }
+    return h;
+}
+
+/* Découpe g en 2^bits cellules emboîtées, 'pas' bits à la fois ; feuille[origine[u]] = numéro */
+static int emboiter(const GraphePartition* g, const int* origine, int prefixe, int bits, int pas, double tolerance,
+                    int nbThreads, int* feuille) {
+    int u, p, ok = 1;
+    if (bits <= 0 || g->nbNoeuds <= 1) {
+        for (u = 0; u < g->nbNoeuds; u++) feuille[origine[u]] = prefixe << (bits > 0 ? bits : 0);
+        return 1;
+    }
+    // Le premier découpage prend les bits en trop, pour que les suivants tombent sur les niveaux
+    int b = bits % pas ? bits % pas : pas, k = 1 << b;
+    int* partie = partitionner_graphe(g, k, tolerance, nbThreads, NULL);
+    int* local = (int*)malloc(sizeof(int) * g->nbNoeuds);
+    int* sousOrigine = (int*)malloc(sizeof(int) * g->nbNoeuds);
+    int* indices = (int*)malloc(sizeof(int) * g->nbNoeuds);
+    if (!partie || !local || !sousOrigine || !indices) ok = 0;
+    for (p = 0; ok && p < k; p++) {
+        GraphePartition* h = graphe_partition_extraire(g, partie, p, local, indices);
+        if (!h) {
+            ok = 0;
+            break;
+        }
+        for (u = 0; u < h->nbNoeuds; u++) sousOrigine[u] = origine[indices[u]];
+        ok = emboiter(h, sousOrigine, (prefixe << b) | p, bits - b, pas, tolerance, nbThreads, feuille);
+        graphe_partition_liberer(h);
+    }
+    free(partie);
+    free(local);
+    free(sousOrigine);
+    free(indices);
+    return ok;
+}
+
+/**
+ * Cellules emboîtées pour le routage multiniveau : chaque nœud reçoit une feuille dans [0, 2^bits),
+ * et les feuilles qui partagent leurs bits de poids fort (par groupes de bitsParNiveau) forment les
+ * cellules des niveaux supérieurs. Chaque cellule est découpée par la partition multiniveau.
+ */
+int* partition_emboitee(const Reseau* r, int bits, int bitsParNiveau, double tolerance, int nbThreads) {
+    GraphePartition* g = graphe_partition_creer(r);
+    int* feuille = (int*)malloc(sizeof(int) * (r->nbNoeuds > 0 ? r->nbNoeuds : 1));
+    int* origine = (int*)malloc(sizeof(int) * (r->nbNoeuds > 0 ? r->nbNoeuds : 1));
+    int u, ok = g && feuille && origine;
+    if (ok) {
+        for (u = 0; u < r->nbNoeuds; u++) origine[u] = u;
+        // La tolérance se cumule d'un découpage à l'autre : chacun en reçoit une part
+        int pas = bitsParNiveau < 1 ? 1 : bitsParNiveau, nbDecoupages = (bits + pas - 1) / pas;
+        double toleranceDecoupage = nbDecoupages > 1 ? pow(1.0 + tolerance, 1.0 / nbDecoupages) - 1.0 : tolerance;
+        ok = emboiter(g, origine, 0, bits, pas, toleranceDecoupage, nbThreads, feuille);
+    }
+    graphe_partition_liberer(g);
+    free(origine);
+    if (!ok) {
+        free(feuille);
+        return NULL;
+    }
+    return feuille;
+}
+
+#endif
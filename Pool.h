@@ -0,0 +1,119 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* ===================== Pool d'objets de taille fixe ===================== */
+/*
+ * Les objets sont découpés dans de grands blocs (slabs). Un objet rendu est chaîné dans une
+ * liste libre (le lien est stocké dans l'objet lui-même) et resservira au prochain appel :
+ * en régime établi, allouer et rendre un objet ne coûte que quelques instructions et
+ * n'appelle jamais l'allocateur général.
+ */
+
+typedef struct {
+    size_t tailleObjet;      // Taille d'un objet (au moins celle d'un pointeur)
+    int objetsParBloc;
+    char** blocs;            // Blocs alloués, conservés jusqu'à pool_liberer
+    int nbBlocs;
+    int capaciteBlocs;
+    int blocCourant;         // Bloc en cours de découpage
+    int positionBloc;        // Prochain objet jamais servi dans le bloc courant
+    void* libres;            // Liste des objets rendus
+    long nbUtilises;         // Objets actuellement alloués
+    long nbAppelsAllocateur; // Appels à malloc/realloc faits par le pool
+} PoolObjets;
+
+/**
+ * Initialise un pool pour des objets de 'tailleObjet' octets, découpés par blocs de 'objetsParBloc'.
+ * Aucune mémoire n'est réservée avant la première allocation.
+ */
+void pool_init(PoolObjets* pool, size_t tailleObjet, int objetsParBloc) {
+    size_t alignement = sizeof(void*);
+    if (tailleObjet < sizeof(void*))
+        tailleObjet = sizeof(void*);
+    pool->tailleObjet = (tailleObjet + alignement - 1) / alignement * alignement;
+    pool->objetsParBloc = objetsParBloc > 0 ? objetsParBloc : 1024;
+    pool->blocs = NULL;
+    pool->nbBlocs = pool->capaciteBlocs = 0;
+    pool->blocCourant = 0;
+    pool->positionBloc = 0;
+    pool->libres = NULL;
+    pool->nbUtilises = 0;
+    pool->nbAppelsAllocateur = 0;
+}
+
+/**
+ * Retourne un objet non initialisé, ou NULL si la mémoire est épuisée.
+ */
+void* pool_allouer(PoolObjets* pool) {
+    // 1. Réutilisation d'un objet rendu
+    if (pool->libres) {
+        void* objet = pool->libres;
+        pool->libres = *(void**)objet;
+        pool->nbUtilises++;
+        return objet;
+    }
+    // 2. Bloc courant épuisé : passage au bloc suivant (déjà alloué après une remise à zéro, sinon nouveau)
+    if (pool->nbBlocs == 0 || pool->positionBloc == pool->objetsParBloc) {
+        if (pool->nbBlocs > 0 && pool->blocCourant + 1 < pool->nbBlocs) {
+            pool->blocCourant++;
+        } else {
+            if (pool->nbBlocs == pool->capaciteBlocs) {
+                int capacite = pool->capaciteBlocs ? 2 * pool->capaciteBlocs : 8;
+                char** blocs = (char**)realloc(pool->blocs, sizeof(char*) * capacite);
+                if (!blocs) return NULL;
+                pool->nbAppelsAllocateur++;
+                pool->blocs = blocs;
+                pool->capaciteBlocs = capacite;
+            }
+            char* bloc = (char*)malloc(pool->tailleObjet * pool->objetsParBloc);
+            if (!bloc) return NULL;
+            pool->nbAppelsAllocateur++;
+            pool->blocs[pool->nbBlocs] = bloc;
+            pool->blocCourant = pool->nbBlocs++;
+        }
+        pool->positionBloc = 0;
+    }
+    // 3. Découpage du bloc courant
+    void* objet = pool->blocs[pool->blocCourant] + pool->tailleObjet * pool->positionBloc++;
+    pool->nbUtilises++;
+    return objet;
+}
+
+/**
+ * Rend un objet au pool ; il sera réutilisé par une prochaine allocation.
+ */
+void pool_rendre(PoolObjets* pool, void* objet) {
+    if (!objet) return;
+    *(void**)objet = pool->libres;
+    pool->libres = objet;
+    pool->nbUtilises--;
+}
+
+/**
+ * Rend tous les objets d'un coup (fin de scénario) en conservant les blocs pour le scénario suivant.
+ * Les pointeurs vers les objets du pool deviennent invalides.
+ */
+void pool_reinitialiser(PoolObjets* pool) {
+    pool->libres = NULL;
+    pool->blocCourant = 0;
+    pool->positionBloc = 0;
+    pool->nbUtilises = 0;
+}
+
+/**
+ * Libère tous les blocs du pool.
+ */
+void pool_liberer(PoolObjets* pool) {
+    int i;
+    for (i = 0; i < pool->nbBlocs; i++)
+        free(pool->blocs[i]);
+    free(pool->blocs);
+    pool->blocs = NULL;
+    pool->nbBlocs = pool->capaciteBlocs = 0;
+    pool_reinitialiser(pool);
+}
+
+#endif
@@ -0,0 +1,138 @@
+#ifndef RECHERCHE_H
+#define RECHERCHE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Reseau.h"
+#include "Tas.h"
+
+/* ===================== Espace de travail des recherches ===================== */
+
+/* Tableaux réutilisés d'une requête à l'autre : la réinitialisation se fait par
+   numéro de passage (marque) et ne coûte donc rien, quelle que soit la taille du réseau. */
+typedef struct {
+    int nbNoeuds;
+    double* dist;      // Coût (distance ou date d'arrivée) du meilleur chemin connu
+    int* parent;       // Nœud précédent sur ce chemin
+    int* parentArete;  // Indice CSR de l'arête empruntée pour arriver au nœud
+    unsigned int* marque; // Numéro du passage qui a touché le nœud
+    unsigned int passage;
+    Tas tas;
+} EspaceRecherche;
+
+/* Résultat d'une recherche d'itinéraire */
+typedef struct {
+    int* noeuds;     // Nœuds du chemin, de la source à la cible
+    int longueur;    // Nombre de nœuds (0 si aucun chemin)
+    double cout;     // Coût total (distance ou durée selon la recherche)
+} Itineraire;
+
+void espace_liberer(EspaceRecherche* e) {
+    free(e->dist);
+    free(e->parent);
+    free(e->parentArete);
+    free(e->marque);
+    tas_liberer(&e->tas);
+    e->dist = NULL;
+    e->parent = e->parentArete = NULL;
+    e->marque = NULL;
+    e->nbNoeuds = 0;
+}
+
+/**
+ * Alloue un espace de travail pour un réseau de nbNoeuds nœuds.
+ */
+int espace_init(EspaceRecherche* e, int nbNoeuds) {
+    e->nbNoeuds = nbNoeuds;
+    e->dist = (double*)malloc(sizeof(double) * (nbNoeuds > 0 ? nbNoeuds : 1));
+    e->parent = (int*)malloc(sizeof(int) * (nbNoeuds > 0 ? nbNoeuds : 1));
+    e->parentArete = (int*)malloc(sizeof(int) * (nbNoeuds > 0 ? nbNoeuds : 1));
+    e->marque = (unsigned int*)calloc(nbNoeuds > 0 ? nbNoeuds : 1, sizeof(unsigned int));
+    e->passage = 0;
+    if (!e->dist || !e->parent || !e->parentArete || !e->marque || !tas_init(&e->tas, 256)) {
+        espace_liberer(e);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Agrandit l'espace de travail à nbNoeuds nœuds (réseau qui a grandi). Retourne 0 si la mémoire
+ * manque ; l'espace reste alors utilisable pour son ancienne taille.
+ */
+int espace_agrandir(EspaceRecherche* e, int nbNoeuds) {
+    if (nbNoeuds <= e->nbNoeuds) return 1;
+    double* dist = (double*)realloc(e->dist, sizeof(double) * nbNoeuds);
+    if (dist) e->dist = dist;
+    int* parent = (int*)realloc(e->parent, sizeof(int) * nbNoeuds);
+    if (parent) e->parent = parent;
+    int* parentArete = (int*)realloc(e->parentArete, sizeof(int) * nbNoeuds);
+    if (parentArete) e->parentArete = parentArete;
+    unsigned int* marque = (unsigned int*)realloc(e->marque, sizeof(unsigned int) * nbNoeuds);
+    if (marque) e->marque = marque;
+    if (!dist || !parent || !parentArete || !marque) return 0;
+    memset(e->marque + e->nbNoeuds, 0, sizeof(unsigned int) * (nbNoeuds - e->nbNoeuds));
+    e->nbNoeuds = nbNoeuds;
+    return 1;
+}
+
+/**
+ * Prépare une nouvelle recherche : tous les nœuds redeviennent inconnus en O(1).
+ */
+void espace_nouvelle_recherche(EspaceRecherche* e) {
+    e->tas.taille = 0;
+    if (++e->passage == 0) {
+        int i;
+        for (i = 0; i < e->nbNoeuds; i++) e->marque[i] = 0;
+        e->passage = 1;
+    }
+}
+
+/* Coût connu d'un nœud (infini s'il n'a pas été atteint pendant ce passage) */
+static inline double espace_dist(const EspaceRecherche* e, int u) {
+    return e->marque[u] == e->passage ? e->dist[u] : 1e300;
+}
+
+static inline void espace_fixer(EspaceRecherche* e, int u, double d, int parent, int arete) {
+    e->marque[u] = e->passage;
+    e->dist[u] = d;
+    e->parent[u] = parent;
+    e->parentArete[u] = arete;
+}
+
+/**
+ * Reconstitue le chemin source -> cible à partir des parents. Retourne un itinéraire vide
+ * si la cible n'a pas été atteinte.
+ */
+Itineraire espace_itineraire(const EspaceRecherche* e, int source, int cible) {
+    Itineraire it = { NULL, 0, 0.0 };
+    if (espace_dist(e, cible) >= 1e300)
+        return it;
+    int n = 0, u = cible;
+    while (u != -1) {
+        n++;
+        if (u == source) break;
+        u = e->parent[u];
+    }
+    it.noeuds = (int*)malloc(sizeof(int) * n);
+    if (!it.noeuds)
+        return it;
+    u = cible;
+    int i;
+    for (i = n - 1; i >= 0; i--) {
+        it.noeuds[i] = u;
+        u = e->parent[u];
+    }
+    it.longueur = n;
+    it.cout = e->dist[cible];
+    return it;
+}
+
+void itineraire_liberer(Itineraire* it) {
+    free(it->noeuds);
+    it->noeuds = NULL;
+    it->longueur = 0;
+}
+
+#endif
@@ -0,0 +1,310 @@
+#ifndef RENUMEROTATION_H
+#define RENUMEROTATION_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Reseau.h"
+#include "Feux.h"
+#include "Recherche.h"
+#include "FormatCarte.h"
+
+/* ===================== Renumérotation des nœuds pour la localité ===================== */
+/*
+ * Les recherches lisent dist[], marque[] et les coordonnées des voisins de chaque nœud exploré.
+ * Quand des voisins ont des numéros éloignés, chaque lecture touche une autre ligne de cache.
+ * Renuméroter les nœuds pour que des nœuds proches aient des numéros proches regroupe ces
+ * lectures. Deux ordres sont proposés :
+ *  - Hilbert : tri des nœuds le long d'une courbe de Hilbert sur (X, Y), indépendant des arêtes ;
+ *  - RCM (Cuthill-McKee inversé) : parcours en largeur, qui réduit l'écart entre voisins.
+ *
+ * Les numéros externes (ceux de la carte, saisis par l'utilisateur et affichés) restent ceux de
+ * l'API : la Numerotation traduit les requêtes en numéros internes et les résultats en retour.
+ * Les indices d'arêtes d'origine (idArete) ne changent pas.
+ */
+
+typedef struct {
+    int nbNoeuds;
+    int* versInterne;   // Numéro externe -> interne
+    int* versExterne;   // Numéro interne -> externe
+} Numerotation;
+
+void numerotation_liberer(Numerotation* num) {
+    free(num->versInterne);
+    free(num->versExterne);
+    num->versInterne = num->versExterne = NULL;
+    num->nbNoeuds = 0;
+}
+
+/* Alloue les deux tables ; versExterne doit ensuite être rempli, puis numerotation_inverser appelé */
+static int numerotation_allouer(Numerotation* num, int n) {
+    num->nbNoeuds = n;
+    num->versInterne = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    num->versExterne = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    if (!num->versInterne || !num->versExterne) {
+        numerotation_liberer(num);
+        return 0;
+    }
+    return 1;
+}
+
+static void numerotation_inverser(Numerotation* num) {
+    int i;
+    for (i = 0; i < num->nbNoeuds; i++)
+        num->versInterne[num->versExterne[i]] = i;
+}
+
+/* Position d'un point (x, y) de [0, 2^16)² sur la courbe de Hilbert d'ordre 16 */
+static unsigned int hilbert_indice(unsigned int x, unsigned int y) {
+    unsigned int d = 0, s, rx, ry;
+    for (s = 1u << 15; s > 0; s >>= 1) {
+        rx = (x & s) > 0;
+        ry = (y & s) > 0;
+        d += s * s * ((3 * rx) ^ ry);
+        // Rotation du quadrant
+        if (ry == 0) {
+            if (rx == 1) {
+                x = s - 1 - x;
+                y = s - 1 - y;
+            }
+            unsigned int t = x;
+            x = y;
+            y = t;
+        }
+    }
+    return d;
+}
+
+static int comparer_cles(const void* a, const void* b) {
+    unsigned long long x = *(const unsigned long long*)a, y = *(const unsigned long long*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Numérotation selon la courbe de Hilbert des coordonnées (à égalité, ordre d'origine).
+ */
+int numerotation_hilbert(Numerotation* num, const int* X, const int* Y, int n) {
+    int i, xMin = 0, xMax = 0, yMin = 0, yMax = 0;
+    unsigned long long* cles = (unsigned long long*)malloc(sizeof(unsigned long long) * (n > 0 ? n : 1));
+    if (!cles || !numerotation_allouer(num, n)) {
+        free(cles);
+        return 0;
+    }
+    for (i = 0; i < n; i++) {
+        if (i == 0 || X[i] < xMin) xMin = X[i];
+        if (i == 0 || X[i] > xMax) xMax = X[i];
+        if (i == 0 || Y[i] < yMin) yMin = Y[i];
+        if (i == 0 || Y[i] > yMax) yMax = Y[i];
+    }
+    double ex = xMax > xMin ? 65535.0 / ((double)xMax - xMin) : 0.0;
+    double ey = yMax > yMin ? 65535.0 / ((double)yMax - yMin) : 0.0;
+    // Clé = position sur la courbe (32 bits forts) puis numéro d'origine : tri stable et reproductible
+    for (i = 0; i < n; i++) {
+        unsigned int hx = (unsigned int)((X[i] - (double)xMin) * ex);
+        unsigned int hy = (unsigned int)((Y[i] - (double)yMin) * ey);
+        cles[i] = ((unsigned long long)hilbert_indice(hx, hy) << 32) | (unsigned int)i;
+    }
+    qsort(cles, n, sizeof(unsigned long long), comparer_cles);
+    for (i = 0; i < n; i++)
+        num->versExterne[i] = (int)(cles[i] & 0xFFFFFFFFu);
+    numerotation_inverser(num);
+    free(cles);
+    return 1;
+}
+
+/**
+ * Numérotation de Cuthill-McKee inversée sur le graphe non orienté sous-jacent : chaque
+ * composante est parcourue en largeur depuis un nœud de degré minimal, les voisins par degré
+ * croissant, puis l'ordre obtenu est retourné.
+ */
+int numerotation_rcm(Numerotation* num, const Reseau* r) {
+    int n = r->nbNoeuds, m = r->nbAretes, i, k;
+    int* debut = (int*)calloc(n + 1, sizeof(int));
+    int* voisins = (int*)malloc(sizeof(int) * (2 * m > 0 ? 2 * m : 1));
+    int* ordre = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    char* vu = (char*)calloc(n > 0 ? n : 1, 1);
+    if (!debut || !voisins || !ordre || !vu || !numerotation_allouer(num, n)) {
+        free(debut);
+        free(voisins);
+        free(ordre);
+        free(vu);
+        return 0;
+    }
+    // Adjacence non orientée (arêtes sortantes et entrantes)
+    for (i = 0; i < n; i++)
+        for (k = r->debut[i]; k < r->debut[i + 1]; k++) {
+            debut[i + 1]++;
+            debut[r->cible[k] + 1]++;
+        }
+    for (i = 0; i < n; i++) debut[i + 1] += debut[i];
+    int* curseur = ordre; // Sert de curseur de remplissage avant le parcours
+    memcpy(curseur, debut, sizeof(int) * n);
+    for (i = 0; i < n; i++)
+        for (k = r->debut[i]; k < r->debut[i + 1]; k++) {
+            voisins[curseur[i]++] = r->cible[k];
+            voisins[curseur[r->cible[k]]++] = i;
+        }
+    // Départs candidats : nœuds par degré croissant
+    unsigned long long* cles = (unsigned long long*)malloc(sizeof(unsigned long long) * (n > 0 ? n : 1));
+    if (!cles) {
+        free(debut);
+        free(voisins);
+        free(ordre);
+        free(vu);
+        numerotation_liberer(num);
+        return 0;
+    }
+    for (i = 0; i < n; i++)
+        cles[i] = ((unsigned long long)(debut[i + 1] - debut[i]) << 32) | (unsigned int)i;
+    qsort(cles, n, sizeof(unsigned long long), comparer_cles);
+    int tete = 0, queue = 0, c;
+    for (c = 0; c < n; c++) {
+        int depart = (int)(cles[c] & 0xFFFFFFFFu);
+        if (vu[depart]) continue;
+        vu[depart] = 1;
+        ordre[queue++] = depart;
+        while (tete < queue) {
+            int u = ordre[tete++];
+            int premier = queue;
+            for (k = debut[u]; k < debut[u + 1]; k++) {
+                int v = voisins[k];
+                if (vu[v]) continue;
+                vu[v] = 1;
+                // Insertion par degré croissant parmi les voisins ajoutés pour u
+                int j = queue++, dv = debut[v + 1] - debut[v];
+                while (j > premier && debut[ordre[j - 1] + 1] - debut[ordre[j - 1]] > dv) {
+                    ordre[j] = ordre[j - 1];
+                    j--;
+                }
+                ordre[j] = v;
+            }
+        }
+    }
+    for (i = 0; i < n; i++)
+        num->versExterne[i] = ordre[n - 1 - i];
+    numerotation_inverser(num);
+    free(cles);
+    free(debut);
+    free(voisins);
+    free(ordre);
+    free(vu);
+    return 1;
+}
+
+/**
+ * Réseau renuméroté : le nœud interne i est le nœud externe versExterne[i]. Les arêtes de
+ * chaque nœud gardent leur ordre et leur indice d'origine (idArete).
+ */
+Reseau* reseau_renumeroter(const Reseau* r, const Numerotation* num) {
+    int n = r->nbNoeuds, m = r->nbAretes, i, k;
+    Reseau* s = (Reseau*)calloc(1, sizeof(Reseau));
+    if (!s) return NULL;
+    s->nbNoeuds = n;
+    s->nbAretes = m;
+    s->debut = (int*)malloc(sizeof(int) * (n + 1));
+    s->cible = (int*)malloc(sizeof(int) * (m > 0 ? m : 1));
+    s->poids = (double*)malloc(sizeof(double) * (m > 0 ? m : 1));
+    s->idArete = (int*)malloc(sizeof(int) * (m > 0 ? m : 1));
+    s->X = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    s->Y = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    if (!s->debut || !s->cible || !s->poids || !s->idArete || !s->X || !s->Y) {
+        reseau_liberer(s);
+        return NULL;
+    }
+    int position = 0;
+    for (i = 0; i < n; i++) {
+        int u = num->versExterne[i];
+        s->debut[i] = position;
+        s->X[i] = r->X[u];
+        s->Y[i] = r->Y[u];
+        for (k = r->debut[u]; k < r->debut[u + 1]; k++) {
+            s->cible[position] = num->versInterne[r->cible[k]];
+            s->poids[position] = r->poids[k];
+            s->idArete[position] = r->idArete[k];
+            position++;
+        }
+    }
+    s->debut[n] = position;
+    return s;
+}
+
+/**
+ * Index des feux en numéros internes (les identifiants de feux ne changent pas).
+ */
+int index_feux_renumeroter(IndexFeux* dest, const IndexFeux* src, const Numerotation* num) {
+    int n = src->nbNoeuds, i, position = 0;
+    dest->nbNoeuds = n;
+    dest->debut = (int*)malloc(sizeof(int) * (n + 1));
+    dest->feux = (int*)malloc(sizeof(int) * (src->debut[n] > 0 ? src->debut[n] : 1));
+    if (!dest->debut || !dest->feux) {
+        index_feux_liberer(dest);
+        return 0;
+    }
+    for (i = 0; i < n; i++) {
+        int u = num->versExterne[i];
+        int nb = src->debut[u + 1] - src->debut[u];
+        dest->debut[i] = position;
+        memcpy(dest->feux + position, src->feux + src->debut[u], sizeof(int) * nb);
+        position += nb;
+    }
+    dest->debut[n] = position;
+    return 1;
+}
+
+/* Traduit les nœuds d'un itinéraire calculé sur le réseau renuméroté en numéros externes */
+void itineraire_vers_externe(Itineraire* it, const Numerotation* num) {
+    int i;
+    for (i = 0; i < it->longueur; i++)
+        it->noeuds[i] = num->versExterne[it->noeuds[i]];
+}
+
+/**
+ * Applique la numérotation à une carte : nœuds permutés, extrémités des arêtes et positions
+ * des feux traduites, arêtes regroupées par nœud source (dans l'ordre de la carte).
+ */
+int carte_renumeroter(Carte* c, const Numerotation* num) {
+    int n = c->nbNoeuds, m = c->nbAretes, i;
+    NoeudCarte* noeuds = (NoeudCarte*)malloc(sizeof(NoeudCarte) * (n > 0 ? n : 1));
+    AreteCarte* aretes = (AreteCarte*)malloc(sizeof(AreteCarte) * (m > 0 ? m : 1));
+    int* debut = (int*)calloc(n + 1, sizeof(int));
+    if (!noeuds || !aretes || !debut) {
+        free(noeuds);
+        free(aretes);
+        free(debut);
+        return 0;
+    }
+    for (i = 0; i < n; i++)
+        noeuds[i] = c->noeuds[num->versExterne[i]];
+    for (i = 0; i < m; i++)
+        debut[num->versInterne[c->aretes[i].source] + 1]++;
+    for (i = 0; i < n; i++)
+        debut[i + 1] += debut[i];
+    for (i = 0; i < m; i++) {
+        AreteCarte a = c->aretes[i];
+        a.source = num->versInterne[a.source];
+        a.destination = num->versInterne[a.destination];
+        aretes[debut[a.source]++] = a;
+    }
+    for (i = 0; i < c->nbFeux; i++)
+        c->feux[i].position = num->versInterne[c->feux[i].position];
+    free(c->noeuds);
+    free(c->aretes);
+    free(debut);
+    c->noeuds = noeuds;
+    c->aretes = aretes;
+    c->capaciteNoeuds = n > 0 ? n : 1;
+    c->capaciteAretes = m > 0 ? m : 1;
+    return 1;
+}
+
+/* Écart moyen entre les numéros des extrémités des arêtes (mesure de localité) */
+double reseau_ecart_moyen(const Reseau* r) {
+    double somme = 0.0;
+    int i, k;
+    for (i = 0; i < r->nbNoeuds; i++)
+        for (k = r->debut[i]; k < r->debut[i + 1]; k++)
+            somme += abs(r->cible[k] - i);
+    return r->nbAretes > 0 ? somme / r->nbAretes : 0.0;
+}
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef RESEAU_H
+#define RESEAU_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ===================== Réseau compact (adjacence CSR) ===================== */
+
+/* Représentation compacte du réseau, partagée par les deux interfaces.
+   Les arêtes sortantes du nœud u occupent les indices [debut[u], debut[u+1]). */
+typedef struct {
+    int nbNoeuds;
+    int nbAretes;
+    int* debut;     // nbNoeuds + 1 entrées
+    int* cible;     // Destination de chaque arête (ordre CSR)
+    double* poids;  // Distance de chaque arête (ordre CSR)
+    int* idArete;   // Indice de l'arête dans le tableau d'origine (graph->A)
+    int* X;         // Coordonnées des nœuds
+    int* Y;
+} Reseau;
+
+/**
+ * Libère un réseau compact.
+ */
+void reseau_liberer(Reseau* r) {
+    if (!r) return;
+    free(r->debut);
+    free(r->cible);
+    free(r->poids);
+    free(r->idArete);
+    free(r->X);
+    free(r->Y);
+    free(r);
+}
+
+/**
+ * Construit le réseau compact à partir d'une liste d'arêtes (tri par comptage sur la source).
+ * L'ordre relatif des arêtes d'un même nœud est conservé. Les arêtes dont une extrémité
+ * est hors limites sont ignorées.
+ */
+Reseau* reseau_creer(int nbNoeuds, int nbAretes, const int* sources, const int* destinations,
+                     const double* distances, const int* X, const int* Y) {
+    Reseau* r = (Reseau*)calloc(1, sizeof(Reseau));
+    if (!r) return NULL;
+    r->nbNoeuds = nbNoeuds;
+    r->debut = (int*)calloc(nbNoeuds + 1, sizeof(int));
+    r->cible = (int*)malloc(sizeof(int) * (nbAretes > 0 ? nbAretes : 1));
+    r->poids = (double*)malloc(sizeof(double) * (nbAretes > 0 ? nbAretes : 1));
+    r->idArete = (int*)malloc(sizeof(int) * (nbAretes > 0 ? nbAretes : 1));
+    r->X = (int*)malloc(sizeof(int) * (nbNoeuds > 0 ? nbNoeuds : 1));
+    r->Y = (int*)malloc(sizeof(int) * (nbNoeuds > 0 ? nbNoeuds : 1));
+    if (!r->debut || !r->cible || !r->poids || !r->idArete || !r->X || !r->Y) {
+        printf("Erreur d'allocation mémoire pour le réseau !\n");
+        reseau_liberer(r);
+        return NULL;
+    }
+    int i;
+    for (i = 0; i < nbNoeuds; i++) {
+        r->X[i] = X ? X[i] : 0;
+        r->Y[i] = Y ? Y[i] : 0;
+    }
+    // Comptage des arêtes sortantes de chaque nœud
+    for (i = 0; i < nbAretes; i++) {
+        if (sources[i] < 0 || sources[i] >= nbNoeuds || destinations[i] < 0 || destinations[i] >= nbNoeuds)
+            continue;
+        r->debut[sources[i] + 1]++;
+    }
+    for (i = 0; i < nbNoeuds; i++)
+        r->debut[i + 1] += r->debut[i];
+    r->nbAretes = r->debut[nbNoeuds];
+    // Placement des arêtes (debut[] sert de curseur puis est décalé en retour)
+    for (i = 0; i < nbAretes; i++) {
+        if (sources[i] < 0 || sources[i] >= nbNoeuds || destinations[i] < 0 || destinations[i] >= nbNoeuds)
+            continue;
+        int pos = r->debut[sources[i]]++;
+        r->cible[pos] = destinations[i];
+        r->poids[pos] = distances[i];
+        r->idArete[pos] = i;
+    }
+    for (i = nbNoeuds; i > 0; i--)
+        r->debut[i] = r->debut[i - 1];
+    r->debut[0] = 0;
+    return r;
+}
+
+#endif
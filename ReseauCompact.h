@@ -0,0 +1,231 @@
+#ifndef RESEAU_COMPACT_H
+#define RESEAU_COMPACT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdint.h>
+#include "Reseau.h"
+#include "Recherche.h"
+
+/* ===================== Réseau compressé pour les très grands graphes ===================== */
+/*
+ * Variante compacte du Reseau, décodée à la volée pendant les recherches. Les arêtes de chaque
+ * nœud forment une suite d'octets :
+ *  - nombre d'arêtes (entier variable, 7 bits par octet) ;
+ *  - pour chaque arête : écart entre sa cible et la précédente (la première par rapport au
+ *    nœud lui-même), en zigzag, décalé de 2 bits pour loger les drapeaux (prioritaire, bloquée) ;
+ *  - puis son poids quantifié sur 16 ou 32 bits (poids = quantum x pas, arrondi par excès pour
+ *    que l'heuristique euclidienne reste admissible).
+ * Avec des nœuds numérotés pour la localité (Renumerotation.h), l'écart tient souvent sur un
+ * octet : une arête occupe alors 3 octets au lieu de 16 dans le Reseau (et ~40 dans le Graphe).
+ * Les indices d'arêtes d'origine ne sont pas conservés : les profils de congestion et les
+ * facteurs par arête restent réservés au Reseau.
+ */
+
+#define COMPACT_PRIORITAIRE 1   // Route prioritaire
+#define COMPACT_BLOQUEE     2   // Arête inutilisable (accident, panne)
+
+typedef struct {
+    int nbNoeuds;
+    int nbAretes;
+    int bitsPoids;       // 16 ou 32
+    double pas;          // Poids réel = quantum x pas
+    uint32_t* debut;     // Position de la suite d'octets de chaque nœud (nbNoeuds + 1 entrées)
+    unsigned char* octets;
+    size_t tailleOctets;
+    int* X;              // Coordonnées des nœuds (heuristique A*)
+    int* Y;
+} ReseauCompact;
+
+/* Lecture séquentielle des arêtes d'un nœud */
+typedef struct {
+    const unsigned char* p;
+    int restantes;
+    int cible;           // Cible de la dernière arête lue
+} CurseurCompact;
+
+void reseau_compact_liberer(ReseauCompact* rc) {
+    if (!rc) return;
+    free(rc->debut);
+    free(rc->octets);
+    free(rc->X);
+    free(rc->Y);
+    free(rc);
+}
+
+static inline unsigned char* compact_ecrire_varint(unsigned char* p, uint32_t v) {
+    while (v >= 0x80) {
+        *p++ = (unsigned char)(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = (unsigned char)v;
+    return p;
+}
+
+static inline const unsigned char* compact_lire_varint(const unsigned char* p, uint32_t* v) {
+    uint32_t x = *p & 0x7F;
+    int decalage = 7;
+    while (*p++ & 0x80) {
+        x |= (uint32_t)(*p & 0x7F) << decalage;
+        decalage += 7;
+    }
+    *v = x;
+    return p;
+}
+
+/**
+ * Compresse un réseau. drapeaux (COMPACT_*, par arête d'origine idArete) peut être NULL.
+ * bitsPoids vaut 16 ou 32. Retourne NULL si la mémoire manque ou si le réseau est trop grand
+ * (suite d'octets au-delà de 4 Go, écart de cible au-delà de 2^29).
+ */
+ReseauCompact* reseau_compact_creer(const Reseau* r, const unsigned char* drapeaux, int bitsPoids) {
+    int n = r->nbNoeuds, m = r->nbAretes, u, k;
+    if (bitsPoids != 16) bitsPoids = 32;
+    int octetsPoids = bitsPoids / 8;
+    ReseauCompact* rc = (ReseauCompact*)calloc(1, sizeof(ReseauCompact));
+    if (!rc) return NULL;
+    rc->nbNoeuds = n;
+    rc->nbAretes = m;
+    rc->bitsPoids = bitsPoids;
+    double max = 0.0;
+    for (k = 0; k < m; k++)
+        if (r->poids[k] > max) max = r->poids[k];
+    rc->pas = max > 0 ? max / (bitsPoids == 16 ? 65535.0 : 4294967295.0) : 1.0;
+    // Taille maximale : 5 octets par entier variable, plus les poids
+    size_t borne = (size_t)n * 5 + (size_t)m * (5 + octetsPoids) + 1;
+    rc->debut = (uint32_t*)malloc(sizeof(uint32_t) * (n + 1));
+    rc->octets = (unsigned char*)malloc(borne);
+    rc->X = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    rc->Y = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    if (!rc->debut || !rc->octets || !rc->X || !rc->Y) {
+        reseau_compact_liberer(rc);
+        return NULL;
+    }
+    memcpy(rc->X, r->X, sizeof(int) * n);
+    memcpy(rc->Y, r->Y, sizeof(int) * n);
+    unsigned char* p = rc->octets;
+    for (u = 0; u < n; u++) {
+        if ((size_t)(p - rc->octets) > UINT32_MAX) {
+            reseau_compact_liberer(rc);
+            return NULL;
+        }
+        rc->debut[u] = (uint32_t)(p - rc->octets);
+        p = compact_ecrire_varint(p, (uint32_t)(r->debut[u + 1] - r->debut[u]));
+        int precedente = u;
+        for (k = r->debut[u]; k < r->debut[u + 1]; k++) {
+            int ecart = r->cible[k] - precedente;
+            if (ecart >= (1 << 29) || ecart < -(1 << 29)) {
+                reseau_compact_liberer(rc);
+                return NULL;
+            }
+            uint32_t zigzag = ((uint32_t)ecart << 1) ^ (uint32_t)(ecart >> 31);
+            uint32_t d = drapeaux ? (drapeaux[r->idArete[k]] & 3u) : 0u;
+            p = compact_ecrire_varint(p, (zigzag << 2) | d);
+            double q = ceil(r->poids[k] / rc->pas);
+            if (bitsPoids == 16) {
+                uint16_t v = (uint16_t)(q < 65535.0 ? q : 65535.0);
+                memcpy(p, &v, 2);
+            } else {
+                uint32_t v = (uint32_t)(q < 4294967295.0 ? q : 4294967295.0);
+                memcpy(p, &v, 4);
+            }
+            p += octetsPoids;
+            precedente = r->cible[k];
+        }
+    }
+    rc->debut[n] = (uint32_t)(p - rc->octets);
+    rc->tailleOctets = p - rc->octets;
+    // Rend la place réservée en trop
+    unsigned char* ajuste = (unsigned char*)realloc(rc->octets, rc->tailleOctets > 0 ? rc->tailleOctets : 1);
+    if (ajuste) rc->octets = ajuste;
+    return rc;
+}
+
+/* Mémoire occupée par le réseau compressé, en octets */
+size_t reseau_compact_octets(const ReseauCompact* rc) {
+    return sizeof(ReseauCompact) + sizeof(uint32_t) * (rc->nbNoeuds + 1) + rc->tailleOctets +
+           2 * sizeof(int) * rc->nbNoeuds;
+}
+
+static inline void compact_parcourir(const ReseauCompact* rc, int u, CurseurCompact* c) {
+    uint32_t nb;
+    c->p = compact_lire_varint(rc->octets + rc->debut[u], &nb);
+    c->restantes = (int)nb;
+    c->cible = u;
+}
+
+/* Arête suivante du curseur : retourne 0 quand il n'y en a plus */
+static inline int compact_suivante(const ReseauCompact* rc, CurseurCompact* c, int* cible, double* poids,
+                                   int* drapeaux) {
+    uint32_t x;
+    if (c->restantes == 0) return 0;
+    c->restantes--;
+    c->p = compact_lire_varint(c->p, &x);
+    *drapeaux = (int)(x & 3u);
+    x >>= 2;
+    c->cible += (int)(x >> 1) ^ -(int)(x & 1u);
+    *cible = c->cible;
+    if (rc->bitsPoids == 16) {
+        uint16_t v;
+        memcpy(&v, c->p, 2);
+        *poids = v * rc->pas;
+        c->p += 2;
+    } else {
+        uint32_t v;
+        memcpy(&v, c->p, 4);
+        *poids = v * rc->pas;
+        c->p += 4;
+    }
+    return 1;
+}
+
+/**
+ * Plus court chemin (Dijkstra, ou A* si heuristique) sur le réseau compressé. Les arêtes
+ * bloquées sont ignorées, le poids des routes prioritaires est multiplié par facteurPrioritaire.
+ */
+Itineraire itineraire_compact(const ReseauCompact* rc, int source, int cible, double facteurPrioritaire,
+                              int heuristique, EspaceRecherche* e) {
+    Itineraire vide = { NULL, 0, 0.0 };
+    if (source < 0 || source >= rc->nbNoeuds || cible < 0 || cible >= rc->nbNoeuds || facteurPrioritaire < 0)
+        return vide;
+    // Borne par unité de distance euclidienne : admissible même avec la réduction prioritaire
+    double borne = heuristique ? (facteurPrioritaire < 1.0 ? facteurPrioritaire : 1.0) : 0.0;
+    espace_nouvelle_recherche(e);
+    espace_fixer(e, source, 0.0, -1, -1);
+    tas_inserer(&e->tas, 0.0, source);
+    while (e->tas.taille > 0) {
+        ElementTas x = tas_extraire(&e->tas);
+        int u = x.valeur;
+        double du = espace_dist(e, u);
+        double hu = 0.0;
+        if (borne > 0) {
+            double dx = rc->X[u] - rc->X[cible], dy = rc->Y[u] - rc->Y[cible];
+            hu = sqrt(dx * dx + dy * dy) * borne;
+        }
+        if (x.cle > du + hu + 1e-9) continue; // Entrée périmée
+        if (u == cible) break;
+        CurseurCompact c;
+        int v, drapeaux;
+        double poids;
+        compact_parcourir(rc, u, &c);
+        while (compact_suivante(rc, &c, &v, &poids, &drapeaux)) {
+            if (drapeaux & COMPACT_BLOQUEE) continue;
+            if (drapeaux & COMPACT_PRIORITAIRE) poids *= facteurPrioritaire;
+            double a = du + poids;
+            if (a < espace_dist(e, v)) {
+                espace_fixer(e, v, a, u, -1);
+                double h = 0.0;
+                if (borne > 0) {
+                    double dx = rc->X[v] - rc->X[cible], dy = rc->Y[v] - rc->Y[cible];
+                    h = sqrt(dx * dx + dy * dy) * borne;
+                }
+                tas_inserer(&e->tas, a + h, v);
+            }
+        }
+    }
+    return espace_itineraire(e, source, cible);
+}
+
+#endif
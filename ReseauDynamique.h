@@ -0,0 +1,530 @@
+#ifndef RESEAU_DYNAMIQUE_H
+#define RESEAU_DYNAMIQUE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "Reseau.h"
+#include "Feux.h"
+#include "Recherche.h"
+
+/* ===================== Réseau modifiable pendant les recherches ===================== */
+/*
+ * Nœuds, arêtes et feux peuvent être ajoutés ou supprimés à tout moment pendant que d'autres
+ * threads calculent des itinéraires.
+ *
+ *  - Les éléments sont rangés dans des colonnes par blocs de taille fixe : un bloc n'est jamais
+ *    déplacé, un ajout coûte O(1) et ne perturbe pas les lecteurs. Un élément n'est jamais
+ *    réutilisé ; sa suppression est datée par le numéro de version qui l'a retiré.
+ *  - La base est un Reseau (CSR) construit à une version donnée. Les arêtes ajoutées depuis
+ *    forment la surcouche : une liste par nœud, la plus récente en tête.
+ *  - Un lecteur ouvre une vue : base, version et nombres d'éléments figés à l'ouverture. Tout ce
+ *    qui est ajouté ou supprimé ensuite lui reste invisible, la recherche voit donc un graphe
+ *    cohérent du début à la fin.
+ *  - Un thread de fusion reconstruit la base en arrière-plan quand la surcouche grossit, puis
+ *    l'échange contre l'ancienne. L'ancienne base est libérée quand sa dernière vue est fermée.
+ *
+ * Un seul thread à la fois doit modifier le réseau ; les lecteurs peuvent être nombreux.
+ */
+
+#define DYN_BITS_BLOC 16
+#define DYN_TAILLE_BLOC (1 << DYN_BITS_BLOC)
+#define DYN_MAX_BLOCS 4096               // 268 millions d'éléments par colonne
+#define DYN_SEUIL_FUSION 0.05            // Fusion quand la surcouche dépasse 5 % de la base
+
+/* Colonne d'éléments de taille fixe, découpée en blocs qui ne bougent jamais */
+typedef struct {
+    size_t taille;
+    char* blocs[DYN_MAX_BLOCS];
+} ColonneDyn;
+
+static inline void* colonne_element(const ColonneDyn* c, int i) {
+    return c->blocs[i >> DYN_BITS_BLOC] + (size_t)(i & (DYN_TAILLE_BLOC - 1)) * c->taille;
+}
+
+/* Garantit la place de l'élément i (blocs remplis de zéros) */
+static int colonne_reserver(ColonneDyn* c, int i) {
+    int b = i >> DYN_BITS_BLOC;
+    if (b >= DYN_MAX_BLOCS) return 0;
+    if (!c->blocs[b]) c->blocs[b] = (char*)calloc(DYN_TAILLE_BLOC, c->taille);
+    return c->blocs[b] != NULL;
+}
+
+static void colonne_liberer(ColonneDyn* c) {
+    int b;
+    for (b = 0; b < DYN_MAX_BLOCS; b++) {
+        free(c->blocs[b]);
+        c->blocs[b] = NULL;
+    }
+}
+
+/* Base CSR partagée par les vues qui l'utilisent */
+typedef struct {
+    Reseau* reseau;        // idArete = identifiant de l'arête dans les colonnes
+    unsigned int version;  // Version à laquelle la base a été construite
+    int nbAretes;          // Arêtes d'identifiant < nbAretes prises en compte
+    int nbSuppressions;    // Suppressions à cette version
+    int references;        // Vues ouvertes + 1 tant que c'est la base courante
+} BaseDyn;
+
+typedef struct {
+    // Nœuds
+    ColonneDyn X, Y;
+    ColonneDyn tete;           // atomic_int : dernière arête ajoutée depuis le nœud (-1 si aucune)
+    ColonneDyn teteFeu;        // atomic_int : dernier feu ajouté sur le nœud
+    ColonneDyn noeudSupprime;  // atomic_uint : version de suppression, 0 si présent
+    // Arêtes
+    ColonneDyn source, cible, poids;
+    ColonneDyn suivante;       // Arête précédente du même nœud dans la surcouche
+    ColonneDyn areteSupprimee;
+    // Feux
+    ColonneDyn feux;           // FeuRouge
+    ColonneDyn feuSuivant;
+    ColonneDyn feuSupprime;
+    // État publié (sous verrou)
+    int nbNoeuds, nbAretes, nbFeux, nbSuppressions;
+    unsigned int version;
+    BaseDyn* base;
+    pthread_mutex_t verrou;
+    // Fusion en arrière-plan
+    pthread_t fusion;
+    pthread_cond_t reveil;
+    int fusionDemandee, arret, fusionLancee;
+    int fusionSuspendue;       // Pendant un chargement en bloc
+    int nbFusions;
+} ReseauDynamique;
+
+/* Vue figée du réseau pour une ou plusieurs recherches */
+typedef struct {
+    const ReseauDynamique* d;
+    BaseDyn* base;
+    unsigned int version;
+    int nbNoeuds, nbAretes, nbFeux;
+    int verifierBase;          // 1 si des arêtes de la base ont pu être supprimées depuis sa construction
+} VueReseau;
+
+static void base_liberer(BaseDyn* b) {
+    if (!b) return;
+    reseau_liberer(b->reseau);
+    free(b);
+}
+
+/* Élément présent dans une vue de version v (s = version de suppression) */
+static inline int dyn_present(unsigned int s, unsigned int v) {
+    return s == 0 || s > v;
+}
+
+static inline unsigned int dyn_lire_version(const ColonneDyn* c, int i) {
+    return atomic_load_explicit((atomic_uint*)colonne_element(c, i), memory_order_acquire);
+}
+
+static inline int dyn_lire_tete(const ColonneDyn* c, int i) {
+    return atomic_load_explicit((atomic_int*)colonne_element(c, i), memory_order_acquire);
+}
+
+/* ---------- Construction de la base ---------- */
+
+/* Construit la base à partir de l'état publié (d->verrou ne doit pas être tenu) */
+static BaseDyn* dyn_construire_base(ReseauDynamique* d) {
+    pthread_mutex_lock(&d->verrou);
+    unsigned int v = d->version;
+    int n = d->nbNoeuds, m = d->nbAretes, s = d->nbSuppressions;
+    pthread_mutex_unlock(&d->verrou);
+    BaseDyn* b = (BaseDyn*)calloc(1, sizeof(BaseDyn));
+    int* src = (int*)malloc(sizeof(int) * (m > 0 ? m : 1));
+    int* dst = (int*)malloc(sizeof(int) * (m > 0 ? m : 1));
+    int* ids = (int*)malloc(sizeof(int) * (m > 0 ? m : 1));
+    double* poids = (double*)malloc(sizeof(double) * (m > 0 ? m : 1));
+    int* X = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    int* Y = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    int i, nb = 0;
+    if (b && src && dst && ids && poids && X && Y) {
+        for (i = 0; i < n; i++) {
+            X[i] = *(int*)colonne_element(&d->X, i);
+            Y[i] = *(int*)colonne_element(&d->Y, i);
+        }
+        // Arêtes présentes à la version v, entre deux nœuds présents
+        for (i = 0; i < m; i++) {
+            int a = *(int*)colonne_element(&d->source, i), c = *(int*)colonne_element(&d->cible, i);
+            if (!dyn_present(dyn_lire_version(&d->areteSupprimee, i), v) ||
+                !dyn_present(dyn_lire_version(&d->noeudSupprime, a), v) ||
+                !dyn_present(dyn_lire_version(&d->noeudSupprime, c), v))
+                continue;
+            src[nb] = a;
+            dst[nb] = c;
+            poids[nb] = *(double*)colonne_element(&d->poids, i);
+            ids[nb++] = i;
+        }
+        b->reseau = reseau_creer(n, nb, src, dst, poids, X, Y);
+    }
+    if (b && b->reseau) {
+        for (i = 0; i < b->reseau->nbAretes; i++)
+            b->reseau->idArete[i] = ids[b->reseau->idArete[i]];
+        b->version = v;
+        b->nbAretes = m;
+        b->nbSuppressions = s;
+        b->references = 1;
+    } else if (b) {
+        free(b);
+        b = NULL;
+    }
+    free(src);
+    free(dst);
+    free(ids);
+    free(poids);
+    free(X);
+    free(Y);
+    return b;
+}
+
+/* Remplace la base courante ; l'ancienne est libérée dès que plus aucune vue ne l'utilise */
+static void dyn_echanger_base(ReseauDynamique* d, BaseDyn* b) {
+    pthread_mutex_lock(&d->verrou);
+    BaseDyn* ancienne = d->base;
+    if (ancienne && ancienne->version > b->version) {
+        // Fusion plus récente déjà publiée (fusion manuelle pendant celle du thread)
+        ancienne = b;
+    } else {
+        d->base = b;
+        d->nbFusions++;
+    }
+    int libre = ancienne && --ancienne->references == 0;
+    pthread_mutex_unlock(&d->verrou);
+    if (libre) base_liberer(ancienne);
+}
+
+/* Fusionne la surcouche dans une nouvelle base, dans le thread appelant */
+int dyn_fusionner(ReseauDynamique* d) {
+    BaseDyn* b = dyn_construire_base(d);
+    if (!b) return 0;
+    dyn_echanger_base(d, b);
+    return 1;
+}
+
+static void* dyn_travail_fusion(void* arg) {
+    ReseauDynamique* d = (ReseauDynamique*)arg;
+    pthread_mutex_lock(&d->verrou);
+    while (!d->arret) {
+        if (!d->fusionDemandee) {
+            pthread_cond_wait(&d->reveil, &d->verrou);
+            continue;
+        }
+        d->fusionDemandee = 0;
+        pthread_mutex_unlock(&d->verrou);
+        dyn_fusionner(d);
+        pthread_mutex_lock(&d->verrou);
+    }
+    pthread_mutex_unlock(&d->verrou);
+    return NULL;
+}
+
+/* À appeler sous verrou après une modification : réveille la fusion si la surcouche est grosse */
+static void dyn_verifier_surcouche(ReseauDynamique* d) {
+    int base = d->base ? d->base->reseau->nbAretes : 0;
+    int ajouts = d->nbAretes - (d->base ? d->base->nbAretes : 0);
+    int suppressions = d->nbSuppressions - (d->base ? d->base->nbSuppressions : 0);
+    if (d->fusionLancee && !d->fusionSuspendue && !d->fusionDemandee && ajouts + suppressions > DYN_SEUIL_FUSION * base + 1024) {
+        d->fusionDemandee = 1;
+        pthread_cond_signal(&d->reveil);
+    }
+}
+
+/* ---------- Création et modifications ---------- */
+
+void reseau_dynamique_liberer(ReseauDynamique* d);
+
+/**
+ * Crée un réseau vide. Si fusionAuto vaut 1, un thread fusionne la surcouche en arrière-plan.
+ */
+ReseauDynamique* reseau_dynamique_creer(int fusionAuto) {
+    ReseauDynamique* d = (ReseauDynamique*)calloc(1, sizeof(ReseauDynamique));
+    if (!d) return NULL;
+    d->X.taille = d->Y.taille = d->source.taille = d->cible.taille = d->suivante.taille =
+        d->feuSuivant.taille = sizeof(int);
+    d->tete.taille = d->teteFeu.taille = sizeof(atomic_int);
+    d->noeudSupprime.taille = d->areteSupprimee.taille = d->feuSupprime.taille = sizeof(atomic_uint);
+    d->poids.taille = sizeof(double);
+    d->feux.taille = sizeof(FeuRouge);
+    pthread_mutex_init(&d->verrou, NULL);
+    pthread_cond_init(&d->reveil, NULL);
+    d->base = dyn_construire_base(d);
+    if (!d->base) {
+        reseau_dynamique_liberer(d);
+        return NULL;
+    }
+    if (fusionAuto)
+        d->fusionLancee = pthread_create(&d->fusion, NULL, dyn_travail_fusion, d) == 0;
+    return d;
+}
+
+/* Arrête la fusion et libère tout ; aucune vue ne doit rester ouverte */
+void reseau_dynamique_liberer(ReseauDynamique* d) {
+    if (!d) return;
+    if (d->fusionLancee) {
+        pthread_mutex_lock(&d->verrou);
+        d->arret = 1;
+        pthread_cond_signal(&d->reveil);
+        pthread_mutex_unlock(&d->verrou);
+        pthread_join(d->fusion, NULL);
+    }
+    base_liberer(d->base);
+    colonne_liberer(&d->X);
+    colonne_liberer(&d->Y);
+    colonne_liberer(&d->tete);
+    colonne_liberer(&d->teteFeu);
+    colonne_liberer(&d->noeudSupprime);
+    colonne_liberer(&d->source);
+    colonne_liberer(&d->cible);
+    colonne_liberer(&d->poids);
+    colonne_liberer(&d->suivante);
+    colonne_liberer(&d->areteSupprimee);
+    colonne_liberer(&d->feux);
+    colonne_liberer(&d->feuSuivant);
+    colonne_liberer(&d->feuSupprime);
+    pthread_mutex_destroy(&d->verrou);
+    pthread_cond_destroy(&d->reveil);
+    free(d);
+}
+
+/**
+ * Ajoute un nœud et retourne son numéro (-1 si la mémoire manque).
+ */
+int dyn_ajouter_noeud(ReseauDynamique* d, int x, int y) {
+    int u = d->nbNoeuds;
+    if (!colonne_reserver(&d->X, u) || !colonne_reserver(&d->Y, u) || !colonne_reserver(&d->tete, u) ||
+        !colonne_reserver(&d->teteFeu, u) || !colonne_reserver(&d->noeudSupprime, u))
+        return -1;
+    *(int*)colonne_element(&d->X, u) = x;
+    *(int*)colonne_element(&d->Y, u) = y;
+    atomic_store_explicit((atomic_int*)colonne_element(&d->tete, u), -1, memory_order_relaxed);
+    atomic_store_explicit((atomic_int*)colonne_element(&d->teteFeu, u), -1, memory_order_relaxed);
+    pthread_mutex_lock(&d->verrou);
+    d->nbNoeuds++;
+    d->version++;
+    pthread_mutex_unlock(&d->verrou);
+    return u;
+}
+
+/**
+ * Ajoute une arête et retourne son identifiant (-1 si un nœud n'existe pas ou si la mémoire manque).
+ */
+int dyn_ajouter_arete(ReseauDynamique* d, int source, int cible, double poids) {
+    int e = d->nbAretes;
+    if (source < 0 || source >= d->nbNoeuds || cible < 0 || cible >= d->nbNoeuds)
+        return -1;
+    if (!colonne_reserver(&d->source, e) || !colonne_reserver(&d->cible, e) || !colonne_reserver(&d->poids, e) ||
+        !colonne_reserver(&d->suivante, e) || !colonne_reserver(&d->areteSupprimee, e))
+        return -1;
+    *(int*)colonne_element(&d->source, e) = source;
+    *(int*)colonne_element(&d->cible, e) = cible;
+    *(double*)colonne_element(&d->poids, e) = poids;
+    atomic_int* tete = (atomic_int*)colonne_element(&d->tete, source);
+    *(int*)colonne_element(&d->suivante, e) = atomic_load_explicit(tete, memory_order_relaxed);
+    atomic_store_explicit(tete, e, memory_order_release);
+    pthread_mutex_lock(&d->verrou);
+    d->nbAretes++;
+    d->version++;
+    dyn_verifier_surcouche(d);
+    pthread_mutex_unlock(&d->verrou);
+    return e;
+}
+
+/* Date une suppression (élément d'une colonne de versions) */
+static int dyn_supprimer(ReseauDynamique* d, ColonneDyn* c, int i, int nb) {
+    if (i < 0 || i >= nb) return 0;
+    atomic_uint* s = (atomic_uint*)colonne_element(c, i);
+    if (atomic_load_explicit(s, memory_order_relaxed) != 0) return 0;
+    pthread_mutex_lock(&d->verrou);
+    atomic_store_explicit(s, d->version + 1, memory_order_release);
+    d->version++;
+    d->nbSuppressions++;
+    dyn_verifier_surcouche(d);
+    pthread_mutex_unlock(&d->verrou);
+    return 1;
+}
+
+/* Supprime une arête ; retourne 0 si elle n'existe pas ou est déjà supprimée */
+int dyn_supprimer_arete(ReseauDynamique* d, int e) {
+    return dyn_supprimer(d, &d->areteSupprimee, e, d->nbAretes);
+}
+
+/* Supprime un nœud : ses arêtes entrantes et sortantes disparaissent avec lui */
+int dyn_supprimer_noeud(ReseauDynamique* d, int u) {
+    return dyn_supprimer(d, &d->noeudSupprime, u, d->nbNoeuds);
+}
+
+/**
+ * Ajoute un feu sur un nœud et retourne son identifiant (-1 en cas d'erreur).
+ */
+int dyn_ajouter_feu(ReseauDynamique* d, int position, int etat, int dureeRouge, int dureeVert) {
+    int f = d->nbFeux;
+    if (position < 0 || position >= d->nbNoeuds)
+        return -1;
+    if (!colonne_reserver(&d->feux, f) || !colonne_reserver(&d->feuSuivant, f) || !colonne_reserver(&d->feuSupprime, f))
+        return -1;
+    FeuRouge* feu = (FeuRouge*)colonne_element(&d->feux, f);
+    feu->ID = f;
+    feu->PositionNoeud = position;
+    feu->Etat = etat;
+    feu->DureeRouge = dureeRouge;
+    feu->DureeVert = dureeVert;
+    feu->Decalage = etat ? 0 : dureeVert;
+    feu_actualiser(feu, 0.0);
+    atomic_int* tete = (atomic_int*)colonne_element(&d->teteFeu, position);
+    *(int*)colonne_element(&d->feuSuivant, f) = atomic_load_explicit(tete, memory_order_relaxed);
+    atomic_store_explicit(tete, f, memory_order_release);
+    pthread_mutex_lock(&d->verrou);
+    d->nbFeux++;
+    d->version++;
+    pthread_mutex_unlock(&d->verrou);
+    return f;
+}
+
+int dyn_supprimer_feu(ReseauDynamique* d, int f) {
+    return dyn_supprimer(d, &d->feuSupprime, f, d->nbFeux);
+}
+
+/**
+ * Charge un Reseau complet (arêtes dans l'ordre CSR) et en fait la base. Le réseau doit être vide.
+ */
+int dyn_charger_reseau(ReseauDynamique* d, const Reseau* r) {
+    int u, k, ok = 1;
+    if (d->nbNoeuds || d->nbAretes) return 0;
+    d->fusionSuspendue = 1; // Une seule fusion, à la fin
+    for (u = 0; ok && u < r->nbNoeuds; u++)
+        ok = dyn_ajouter_noeud(d, r->X[u], r->Y[u]) >= 0;
+    for (u = 0; ok && u < r->nbNoeuds; u++)
+        for (k = r->debut[u]; ok && k < r->debut[u + 1]; k++)
+            ok = dyn_ajouter_arete(d, u, r->cible[k], r->poids[k]) >= 0;
+    d->fusionSuspendue = 0;
+    return ok && dyn_fusionner(d);
+}
+
+/* ---------- Lecture ---------- */
+
+/* Ouvre une vue cohérente du réseau (quelques instructions sous verrou) */
+void vue_ouvrir(VueReseau* vue, ReseauDynamique* d) {
+    pthread_mutex_lock(&d->verrou);
+    vue->d = d;
+    vue->base = d->base;
+    vue->base->references++;
+    vue->version = d->version;
+    vue->nbNoeuds = d->nbNoeuds;
+    vue->nbAretes = d->nbAretes;
+    vue->nbFeux = d->nbFeux;
+    vue->verifierBase = d->nbSuppressions != d->base->nbSuppressions;
+    pthread_mutex_unlock(&d->verrou);
+}
+
+void vue_fermer(VueReseau* vue) {
+    ReseauDynamique* d = (ReseauDynamique*)vue->d;
+    pthread_mutex_lock(&d->verrou);
+    int libre = --vue->base->references == 0;
+    pthread_mutex_unlock(&d->verrou);
+    if (libre) base_liberer(vue->base);
+    vue->base = NULL;
+}
+
+static inline int vue_noeud_present(const VueReseau* vue, int u) {
+    return dyn_present(dyn_lire_version(&vue->d->noeudSupprime, u), vue->version);
+}
+
+static inline void vue_coordonnees(const VueReseau* vue, int u, int* x, int* y) {
+    const Reseau* r = vue->base->reseau;
+    if (u < r->nbNoeuds) {
+        *x = r->X[u];
+        *y = r->Y[u];
+    } else {
+        *x = *(int*)colonne_element(&vue->d->X, u);
+        *y = *(int*)colonne_element(&vue->d->Y, u);
+    }
+}
+
+/**
+ * Attente imposée par les feux présents dans la vue sur un nœud, à la date t.
+ */
+double vue_attente_feux(const VueReseau* vue, int noeud, double t) {
+    const ReseauDynamique* d = vue->d;
+    double attente = 0.0;
+    int f;
+    for (f = dyn_lire_tete(&d->teteFeu, noeud); f >= 0; f = *(int*)colonne_element(&d->feuSuivant, f)) {
+        if (f >= vue->nbFeux || !dyn_present(dyn_lire_version(&d->feuSupprime, f), vue->version)) continue;
+        double a = feu_attente((const FeuRouge*)colonne_element(&d->feux, f), t);
+        if (a > attente) attente = a;
+    }
+    return attente;
+}
+
+/* Relâche l'arête (u -> v, poids) pour une recherche en cours */
+static inline void vue_relacher(const VueReseau* vue, EspaceRecherche* e, int u, double du, int v, double poids,
+                                int arete, int cible, double vitesse, double borne) {
+    if (!vue_noeud_present(vue, v)) return;
+    double a = du + poids / vitesse;
+    a += vue_attente_feux(vue, v, a);
+    if (a < espace_dist(e, v)) {
+        espace_fixer(e, v, a, u, arete);
+        double h = 0.0;
+        if (borne > 0) {
+            int xv, yv, xc, yc;
+            vue_coordonnees(vue, v, &xv, &yv);
+            vue_coordonnees(vue, cible, &xc, &yc);
+            double dx = xv - xc, dy = yv - yc;
+            h = sqrt(dx * dx + dy * dy) * borne;
+        }
+        tas_inserer(&e->tas, a + h, v);
+    }
+}
+
+/**
+ * Itinéraire le plus rapide dans une vue (Dijkstra, ou A* si heuristique, les distances devant
+ * alors être >= euclidiennes), en tenant compte des feux. L'espace de travail doit couvrir
+ * vue->nbNoeuds nœuds (voir espace_agrandir). Le coût retourné est la date d'arrivée ; l'arête
+ * d'arrivée à chaque nœud est l'identifiant dynamique.
+ */
+Itineraire itineraire_vue(const VueReseau* vue, int source, int cible, double depart, double vitesse,
+                          int heuristique, EspaceRecherche* e) {
+    Itineraire vide = { NULL, 0, 0.0 };
+    const ReseauDynamique* d = vue->d;
+    const Reseau* r = vue->base->reseau;
+    if (source < 0 || source >= vue->nbNoeuds || cible < 0 || cible >= vue->nbNoeuds || vitesse <= 0 ||
+        e->nbNoeuds < vue->nbNoeuds || !vue_noeud_present(vue, source) || !vue_noeud_present(vue, cible))
+        return vide;
+    double borne = heuristique ? 1.0 / vitesse : 0.0;
+    espace_nouvelle_recherche(e);
+    espace_fixer(e, source, depart, -1, -1);
+    tas_inserer(&e->tas, depart, source);
+    while (e->tas.taille > 0) {
+        ElementTas x = tas_extraire(&e->tas);
+        int u = x.valeur, k, a;
+        double du = espace_dist(e, u), hu = 0.0;
+        if (borne > 0) {
+            int xu, yu, xc, yc;
+            vue_coordonnees(vue, u, &xu, &yu);
+            vue_coordonnees(vue, cible, &xc, &yc);
+            double dx = xu - xc, dy = yu - yc;
+            hu = sqrt(dx * dx + dy * dy) * borne;
+        }
+        if (x.cle > du + hu + 1e-9) continue; // Entrée périmée
+        if (u == cible) break;
+        // Arêtes de la base, sauf celles supprimées depuis sa construction
+        if (u < r->nbNoeuds)
+            for (k = r->debut[u]; k < r->debut[u + 1]; k++) {
+                if (vue->verifierBase && !dyn_present(dyn_lire_version(&d->areteSupprimee, r->idArete[k]), vue->version))
+                    continue;
+                vue_relacher(vue, e, u, du, r->cible[k], r->poids[k], r->idArete[k], cible, vitesse, borne);
+            }
+        // Surcouche : de la plus récente à la première postérieure à la base
+        for (a = dyn_lire_tete(&d->tete, u); a >= vue->base->nbAretes; a = *(int*)colonne_element(&d->suivante, a)) {
+            if (a >= vue->nbAretes || !dyn_present(dyn_lire_version(&d->areteSupprimee, a), vue->version))
+                continue;
+            vue_relacher(vue, e, u, du, *(int*)colonne_element(&d->cible, a), *(double*)colonne_element(&d->poids, a),
+                         a, cible, vitesse, borne);
+        }
+    }
+    return espace_itineraire(e, source, cible);
+}
+
+#endif
@@ -0,0 +1,644 @@
+#ifndef ROUTAGE_MULTINIVEAU_H
+#define ROUTAGE_MULTINIVEAU_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "Reseau.h"
+#include "Recherche.h"
+
+/* ===================== Routage multiniveau personnalisable ===================== */
+/*
+ * Le réseau est découpé en cellules emboîtées : chaque nœud reçoit une feuille, et sa cellule
+ * au niveau l est feuille >> (l x bitsParNiveau). Un découpage récursif donne directement cette
+ * numérotation (partition_emboitee, ou partition_coordonnees avec une puissance de 2 régions).
+ *
+ * Deux phases :
+ *  - préparation (indépendante des poids) : entrées et sorties de chaque cellule, place des
+ *    matrices ;
+ *  - personnalisation : pour chaque cellule, distance de chaque entrée à chaque sortie à travers
+ *    la cellule (clique). Le niveau 0 est calculé sur le réseau, les niveaux supérieurs sur les
+ *    cliques du niveau en dessous. Les cellules d'un même niveau sont réparties entre threads.
+ *
+ * La métrique est un poids par arête d'origine (idArete) ; INFINITY ferme l'arête. Elle est
+ * recopiée dans l'ordre du réseau à la personnalisation. Quand
+ * quelques poids changent (congestion, fermeture), seules les cellules qui contiennent les
+ * arêtes modifiées sont recalculées. Une requête n'explore le réseau que dans les cellules de
+ * niveau 0 de la source et de la cible, et passe ailleurs par les cliques du plus haut niveau
+ * qui ne les contient pas.
+ * Les recherches ne doivent pas tourner pendant une personnalisation.
+ */
+
+#define CRP_MAX_NIVEAUX 8
+
+typedef struct {
+    int decalage;          // Cellule d'un nœud : feuille >> decalage
+    int nbCellules;
+    int* debutEntrees;     // Entrées de la cellule c : entrees[debutEntrees[c] .. debutEntrees[c+1]-1]
+    int* entrees;          // Nœuds atteints par une arête venant d'une autre cellule
+    int* debutSorties;
+    int* sorties;          // Nœuds d'où part une arête vers une autre cellule
+    int* rangEntree;       // Rang du nœud parmi les entrées de sa cellule, -1 sinon
+    int* rangSortie;
+    long* debutClique;     // Matrice entrées x sorties de la cellule c à partir de clique[debutClique[c]]
+    double* clique;
+    unsigned char* aRecalculer;
+} NiveauCRP;
+
+typedef struct {
+    const Reseau* reseau;
+    int* feuille;          // Feuille de chaque nœud
+    int* debutNoeuds;      // Nœuds de la feuille f : noeuds[debutNoeuds[f] .. debutNoeuds[f+1]-1]
+    int* noeuds;
+    int bitsParNiveau;
+    int* positionArete;    // Position CSR de chaque arête d'origine, -1 si absente
+    int nbAretesOrigine;
+    int nbNiveaux;
+    NiveauCRP niveaux[CRP_MAX_NIVEAUX];
+    double* poids;         // Poids de la dernière personnalisation, dans l'ordre CSR
+    int personnalise;      // 0 tant qu'aucune personnalisation n'a eu lieu
+} RoutageCRP;
+
+static inline int crp_cellule(const RoutageCRP* crp, int niveau, int u) {
+    return crp->feuille[u] >> crp->niveaux[niveau].decalage;
+}
+
+void crp_liberer(RoutageCRP* crp) {
+    int l;
+    if (!crp) return;
+    for (l = 0; l < crp->nbNiveaux; l++) {
+        NiveauCRP* N = &crp->niveaux[l];
+        free(N->debutEntrees);
+        free(N->entrees);
+        free(N->debutSorties);
+        free(N->sorties);
+        free(N->rangEntree);
+        free(N->rangSortie);
+        free(N->debutClique);
+        free(N->clique);
+        free(N->aRecalculer);
+    }
+    free(crp->feuille);
+    free(crp->debutNoeuds);
+    free(crp->noeuds);
+    free(crp->positionArete);
+    free(crp->poids);
+    free(crp);
+}
+
+/* Range les nœuds marqués par cellule et donne à chacun son rang dans sa cellule */
+static int crp_grouper(const RoutageCRP* crp, int niveau, const unsigned char* marque, int** debut, int** liste,
+                       int** rang) {
+    const NiveauCRP* N = &crp->niveaux[niveau];
+    int n = crp->reseau->nbNoeuds, u, c;
+    *debut = (int*)calloc(N->nbCellules + 1, sizeof(int));
+    *rang = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    if (!*debut || !*rang) return 0;
+    for (u = 0; u < n; u++)
+        if (marque[u]) (*debut)[crp_cellule(crp, niveau, u) + 1]++;
+    for (c = 0; c < N->nbCellules; c++)
+        (*debut)[c + 1] += (*debut)[c];
+    *liste = (int*)malloc(sizeof(int) * ((*debut)[N->nbCellules] > 0 ? (*debut)[N->nbCellules] : 1));
+    int* curseur = (int*)malloc(sizeof(int) * (N->nbCellules > 0 ? N->nbCellules : 1));
+    if (!*liste || !curseur) {
+        free(curseur);
+        return 0;
+    }
+    memcpy(curseur, *debut, sizeof(int) * N->nbCellules);
+    for (u = 0; u < n; u++) {
+        if (!marque[u]) {
+            (*rang)[u] = -1;
+            continue;
+        }
+        c = crp_cellule(crp, niveau, u);
+        (*rang)[u] = curseur[c] - (*debut)[c];
+        (*liste)[curseur[c]++] = u;
+    }
+    free(curseur);
+    return 1;
+}
+
+/**
+ * Préparation : feuille[u] numérote la cellule de niveau 0 du nœud u, et la cellule du niveau l
+ * est feuille >> (l x bitsParNiveau). Aucun poids n'est lu ; appeler crp_personnaliser ensuite.
+ */
+RoutageCRP* crp_creer(const Reseau* r, const int* feuille, int bitsParNiveau, int nbNiveaux) {
+    int n = r->nbNoeuds, u, k, l, maxFeuille = 0, maxArete = -1;
+    if (nbNiveaux < 1) nbNiveaux = 1;
+    if (nbNiveaux > CRP_MAX_NIVEAUX) nbNiveaux = CRP_MAX_NIVEAUX;
+    RoutageCRP* crp = (RoutageCRP*)calloc(1, sizeof(RoutageCRP));
+    if (!crp) return NULL;
+    crp->reseau = r;
+    crp->nbNiveaux = nbNiveaux;
+    crp->bitsParNiveau = bitsParNiveau;
+    crp->feuille = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    unsigned char* entree = (unsigned char*)malloc(n > 0 ? n : 1);
+    unsigned char* sortie = (unsigned char*)malloc(n > 0 ? n : 1);
+    if (!crp->feuille || !entree || !sortie) goto echec;
+    for (u = 0; u < n; u++) {
+        crp->feuille[u] = feuille[u] > 0 ? feuille[u] : 0;
+        if (crp->feuille[u] > maxFeuille) maxFeuille = crp->feuille[u];
+    }
+    // Nœuds de chaque feuille (graphes locaux du niveau 0)
+    crp->debutNoeuds = (int*)calloc(maxFeuille + 2, sizeof(int));
+    crp->noeuds = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    if (!crp->debutNoeuds || !crp->noeuds) goto echec;
+    for (u = 0; u < n; u++) crp->debutNoeuds[crp->feuille[u] + 1]++;
+    for (k = 0; k <= maxFeuille; k++) crp->debutNoeuds[k + 1] += crp->debutNoeuds[k];
+    for (u = 0; u < n; u++) crp->noeuds[crp->debutNoeuds[crp->feuille[u]]++] = u;
+    for (k = maxFeuille; k > 0; k--) crp->debutNoeuds[k] = crp->debutNoeuds[k - 1];
+    crp->debutNoeuds[0] = 0;
+    // Position CSR des arêtes d'origine (personnalisation partielle)
+    for (k = 0; k < r->nbAretes; k++)
+        if (r->idArete[k] > maxArete) maxArete = r->idArete[k];
+    crp->nbAretesOrigine = maxArete + 1;
+    crp->positionArete = (int*)malloc(sizeof(int) * (maxArete >= 0 ? maxArete + 1 : 1));
+    crp->poids = (double*)malloc(sizeof(double) * (r->nbAretes > 0 ? r->nbAretes : 1));
+    if (!crp->positionArete || !crp->poids) goto echec;
+    for (k = 0; k <= maxArete; k++) crp->positionArete[k] = -1;
+    for (k = 0; k < r->nbAretes; k++) crp->positionArete[r->idArete[k]] = k;
+    for (l = 0; l < nbNiveaux; l++) {
+        NiveauCRP* N = &crp->niveaux[l];
+        N->decalage = l * bitsParNiveau;
+        N->nbCellules = (maxFeuille >> N->decalage) + 1;
+        memset(entree, 0, n);
+        memset(sortie, 0, n);
+        for (u = 0; u < n; u++)
+            for (k = r->debut[u]; k < r->debut[u + 1]; k++)
+                if (crp_cellule(crp, l, u) != crp_cellule(crp, l, r->cible[k])) {
+                    sortie[u] = 1;
+                    entree[r->cible[k]] = 1;
+                }
+        if (!crp_grouper(crp, l, entree, &N->debutEntrees, &N->entrees, &N->rangEntree) ||
+            !crp_grouper(crp, l, sortie, &N->debutSorties, &N->sorties, &N->rangSortie))
+            goto echec;
+        N->debutClique = (long*)malloc(sizeof(long) * (N->nbCellules + 1));
+        N->aRecalculer = (unsigned char*)calloc(N->nbCellules, 1);
+        if (!N->debutClique || !N->aRecalculer) goto echec;
+        N->debutClique[0] = 0;
+        int c;
+        for (c = 0; c < N->nbCellules; c++)
+            N->debutClique[c + 1] = N->debutClique[c] + (long)(N->debutEntrees[c + 1] - N->debutEntrees[c]) *
+                                                        (N->debutSorties[c + 1] - N->debutSorties[c]);
+        N->clique = (double*)malloc(sizeof(double) * (N->debutClique[N->nbCellules] > 0 ? N->debutClique[N->nbCellules] : 1));
+        if (!N->clique) goto echec;
+        for (c = 0; c < N->debutClique[N->nbCellules]; c++) N->clique[c] = INFINITY;
+    }
+    free(entree);
+    free(sortie);
+    return crp;
+echec:
+    free(entree);
+    free(sortie);
+    crp_liberer(crp);
+    return NULL;
+}
+
+/* Mémoire des cliques, en octets */
+size_t crp_octets_cliques(const RoutageCRP* crp) {
+    size_t total = 0;
+    int l;
+    for (l = 0; l < crp->nbNiveaux; l++)
+        total += sizeof(double) * crp->niveaux[l].debutClique[crp->niveaux[l].nbCellules];
+    return total;
+}
+
+/*
+ * Relâche les arcs du nœud u vus au niveau 'niveau' :
+ *  - niveau -1 : les arêtes du réseau ;
+ *  - niveau l >= 0 : la clique de la cellule de u (si u en est une entrée) et les arêtes qui
+ *    sortent de cette cellule.
+ * Si 'dans' >= 0, seules les cibles de la cellule 'cellule' du niveau 'dans' sont gardées.
+ * L'arc emprunté est noté dans parentArete : position CSR, ou -2 - l pour une clique du niveau l.
+ */
+static void crp_relacher(const RoutageCRP* crp, int niveau, int u, double du, int dans, int cellule,
+                         EspaceRecherche* e) {
+    const Reseau* r = crp->reseau;
+    const double* w = crp->poids;
+    int k;
+    if (niveau < 0) {
+        for (k = r->debut[u]; k < r->debut[u + 1]; k++) {
+            int v = r->cible[k];
+            if (dans >= 0 && crp_cellule(crp, dans, v) != cellule) continue;
+            double a = du + w[k];
+            if (a < espace_dist(e, v)) {
+                espace_fixer(e, v, a, u, k);
+                tas_inserer(&e->tas, a, v);
+            }
+        }
+        return;
+    }
+    const NiveauCRP* N = &crp->niveaux[niveau];
+    int c = crp_cellule(crp, niveau, u), i = N->rangEntree[u];
+    if (i >= 0) {
+        int nbSorties = N->debutSorties[c + 1] - N->debutSorties[c], j;
+        const double* ligne = N->clique + N->debutClique[c] + (long)i * nbSorties;
+        const int* sorties = N->sorties + N->debutSorties[c];
+        for (j = 0; j < nbSorties; j++) {
+            double a = du + ligne[j];
+            if (a < espace_dist(e, sorties[j])) {
+                espace_fixer(e, sorties[j], a, u, -2 - niveau);
+                tas_inserer(&e->tas, a, sorties[j]);
+            }
+        }
+    }
+    if (N->rangSortie[u] < 0) return;
+    for (k = r->debut[u]; k < r->debut[u + 1]; k++) {
+        int v = r->cible[k];
+        if (crp_cellule(crp, niveau, v) == c) continue;
+        if (dans >= 0 && crp_cellule(crp, dans, v) != cellule) continue;
+        double a = du + w[k];
+        if (a < espace_dist(e, v)) {
+            espace_fixer(e, v, a, u, k);
+            tas_inserer(&e->tas, a, v);
+        }
+    }
+}
+
+/* Graphe d'une cellule pendant sa personnalisation, en indices locaux (un par thread, agrandi au besoin) */
+typedef struct {
+    int* local;          // Indice local de chaque nœud du réseau, -1 hors de la cellule
+    int nbLocaux;
+    int* noeuds;         // Nœud du réseau de chaque indice local
+    int* debut;          // Arcs du nœud local i : [debut[i], debut[i+1])
+    int* cible;
+    double* poids;
+    double* dist;
+    double* relais;      // Distance du dernier relais (entrée-sortie de la cellule) sur le chemin, 0 si aucun
+    int capaciteNoeuds;
+    int capaciteArcs;
+    Tas tas;
+} EspaceCellule;
+
+static void espace_cellule_liberer(EspaceCellule* g) {
+    free(g->local);
+    free(g->noeuds);
+    free(g->debut);
+    free(g->cible);
+    free(g->poids);
+    free(g->dist);
+    free(g->relais);
+    tas_liberer(&g->tas);
+}
+
+static int espace_cellule_init(EspaceCellule* g, int nbNoeuds) {
+    int i;
+    memset(g, 0, sizeof(EspaceCellule));
+    g->local = (int*)malloc(sizeof(int) * (nbNoeuds > 0 ? nbNoeuds : 1));
+    if (!g->local || !tas_init(&g->tas, 256)) {
+        espace_cellule_liberer(g);
+        return 0;
+    }
+    for (i = 0; i < nbNoeuds; i++) g->local[i] = -1;
+    return 1;
+}
+
+static int espace_cellule_ajouter_noeud(EspaceCellule* g, int u) {
+    if (g->local[u] >= 0) return 1;
+    if (g->nbLocaux + 1 >= g->capaciteNoeuds) {
+        int capacite = g->capaciteNoeuds ? 2 * g->capaciteNoeuds : 256;
+        int* noeuds = (int*)realloc(g->noeuds, sizeof(int) * capacite);
+        if (noeuds) g->noeuds = noeuds;
+        int* debut = (int*)realloc(g->debut, sizeof(int) * (capacite + 1));
+        if (debut) g->debut = debut;
+        double* dist = (double*)realloc(g->dist, sizeof(double) * capacite);
+        if (dist) g->dist = dist;
+        double* relais = (double*)realloc(g->relais, sizeof(double) * capacite);
+        if (relais) g->relais = relais;
+        if (!noeuds || !debut || !dist || !relais) return 0;
+        g->capaciteNoeuds = capacite;
+    }
+    g->local[u] = g->nbLocaux;
+    g->noeuds[g->nbLocaux++] = u;
+    return 1;
+}
+
+static int espace_cellule_ajouter_arc(EspaceCellule* g, int* nbArcs, int v, double poids) {
+    if (*nbArcs == g->capaciteArcs) {
+        int capacite = g->capaciteArcs ? 2 * g->capaciteArcs : 1024;
+        int* cible = (int*)realloc(g->cible, sizeof(int) * capacite);
+        if (cible) g->cible = cible;
+        double* p = (double*)realloc(g->poids, sizeof(double) * capacite);
+        if (p) g->poids = p;
+        if (!cible || !p) return 0;
+        g->capaciteArcs = capacite;
+    }
+    g->cible[*nbArcs] = v;
+    g->poids[(*nbArcs)++] = poids;
+    return 1;
+}
+
+/*
+ * Graphe local de la cellule c du niveau l : au niveau 0, ses nœuds et les arêtes qui y restent ;
+ * au-dessus, les entrées et sorties de ses sous-cellules, reliées par leurs cliques et par les
+ * arêtes qui passent d'une sous-cellule à l'autre.
+ */
+static int crp_graphe_cellule(const RoutageCRP* crp, int l, int c, EspaceCellule* g) {
+    const Reseau* r = crp->reseau;
+    int i, k, j, nbArcs = 0;
+    g->nbLocaux = 0;
+    if (l == 0) {
+        for (i = crp->debutNoeuds[c]; i < crp->debutNoeuds[c + 1]; i++)
+            if (!espace_cellule_ajouter_noeud(g, crp->noeuds[i])) return 0;
+    } else {
+        const NiveauCRP* S = &crp->niveaux[l - 1];
+        int premiere = c << crp->bitsParNiveau, derniere = (c + 1) << crp->bitsParNiveau;
+        if (derniere > S->nbCellules) derniere = S->nbCellules;
+        for (i = S->debutEntrees[premiere]; i < S->debutEntrees[derniere]; i++)
+            if (!espace_cellule_ajouter_noeud(g, S->entrees[i])) return 0;
+        for (i = S->debutSorties[premiere]; i < S->debutSorties[derniere]; i++)
+            if (!espace_cellule_ajouter_noeud(g, S->sorties[i])) return 0;
+    }
+    for (i = 0; i < g->nbLocaux; i++) {
+        int u = g->noeuds[i];
+        g->debut[i] = nbArcs;
+        if (l == 0) {
+            for (k = r->debut[u]; k < r->debut[u + 1]; k++)
+                if (g->local[r->cible[k]] >= 0 && !espace_cellule_ajouter_arc(g, &nbArcs, g->local[r->cible[k]], crp->poids[k]))
+                    return 0;
+            continue;
+        }
+        const NiveauCRP* S = &crp->niveaux[l - 1];
+        int sc = crp_cellule(crp, l - 1, u);
+        if (S->rangEntree[u] >= 0) {
+            int nbSorties = S->debutSorties[sc + 1] - S->debutSorties[sc];
+            const double* ligne = S->clique + S->debutClique[sc] + (long)S->rangEntree[u] * nbSorties;
+            for (j = 0; j < nbSorties; j++)
+                if (ligne[j] < INFINITY &&
+                    !espace_cellule_ajouter_arc(g, &nbArcs, g->local[S->sorties[S->debutSorties[sc] + j]], ligne[j]))
+                    return 0;
+        }
+        if (S->rangSortie[u] < 0) continue;
+        for (k = r->debut[u]; k < r->debut[u + 1]; k++) {
+            int v = r->cible[k];
+            if (g->local[v] >= 0 && crp_cellule(crp, l - 1, v) != sc &&
+                !espace_cellule_ajouter_arc(g, &nbArcs, g->local[v], crp->poids[k]))
+                return 0;
+        }
+    }
+    g->debut[g->nbLocaux] = nbArcs;
+    return 1;
+}
+
+/* Recalcule la clique de la cellule c du niveau l : une recherche par entrée sur le graphe local */
+static int crp_calculer_cellule(RoutageCRP* crp, int l, int c, EspaceCellule* g) {
+    NiveauCRP* N = &crp->niveaux[l];
+    int nbSorties = N->debutSorties[c + 1] - N->debutSorties[c], i, j, k, ok;
+    const int* sorties = N->sorties + N->debutSorties[c];
+    ok = crp_graphe_cellule(crp, l, c, g);
+    for (i = N->debutEntrees[c]; ok && i < N->debutEntrees[c + 1]; i++) {
+        int restantes = nbSorties;
+        for (j = 0; j < g->nbLocaux; j++) {
+            g->dist[j] = INFINITY;
+            g->relais[j] = 0.0;
+        }
+        g->tas.taille = 0;
+        g->dist[g->local[N->entrees[i]]] = 0.0;
+        tas_inserer(&g->tas, 0.0, g->local[N->entrees[i]]);
+        while (g->tas.taille > 0 && restantes > 0) {
+            ElementTas x = tas_extraire(&g->tas);
+            int u = x.valeur;
+            if (x.cle > g->dist[u]) continue; // Entrée périmée
+            int w = g->noeuds[u];
+            if (N->rangSortie[w] >= 0) restantes--;
+            // Passage par une autre entrée-sortie de la cellule : les arcs de clique qui la relaient suffisent
+            double relais = (x.cle > 0 && N->rangEntree[w] >= 0 && N->rangSortie[w] >= 0) ? x.cle : g->relais[u];
+            for (k = g->debut[u]; k < g->debut[u + 1]; k++) {
+                int v = g->cible[k];
+                double a = x.cle + g->poids[k];
+                if (a < g->dist[v]) {
+                    g->dist[v] = a;
+                    g->relais[v] = relais;
+                    tas_inserer(&g->tas, a, v);
+                } else if (a == g->dist[v] && relais > 0 && g->relais[v] == 0) {
+                    g->relais[v] = relais;
+                }
+            }
+        }
+        double* ligne = N->clique + N->debutClique[c] + (long)(i - N->debutEntrees[c]) * nbSorties;
+        for (j = 0; j < nbSorties; j++) {
+            int v = g->local[sorties[j]];
+            ligne[j] = (g->relais[v] > 0 && g->relais[v] < g->dist[v]) ? INFINITY : g->dist[v];
+        }
+    }
+    for (j = 0; j < g->nbLocaux; j++) g->local[g->noeuds[j]] = -1;
+    return ok;
+}
+
+typedef struct {
+    RoutageCRP* crp;
+    int niveau;
+    atomic_int prochaine;   // Prochaine cellule à prendre
+    atomic_int nbCalculees;
+    atomic_int echec;       // Mémoire insuffisante
+} TravailCRP;
+
+static void* crp_travailleur(void* arg) {
+    TravailCRP* t = (TravailCRP*)arg;
+    NiveauCRP* N = &t->crp->niveaux[t->niveau];
+    EspaceCellule g;
+    if (!espace_cellule_init(&g, t->crp->reseau->nbNoeuds)) {
+        atomic_store(&t->echec, 1);
+        return NULL;
+    }
+    int c;
+    while ((c = atomic_fetch_add(&t->prochaine, 1)) < N->nbCellules) {
+        if (!N->aRecalculer[c]) continue;
+        if (!crp_calculer_cellule(t->crp, t->niveau, c, &g)) {
+            atomic_store(&t->echec, 1);
+            continue;
+        }
+        N->aRecalculer[c] = 0;
+        atomic_fetch_add(&t->nbCalculees, 1);
+    }
+    espace_cellule_liberer(&g);
+    return NULL;
+}
+
+/* Recalcule les cellules marquées, niveau par niveau. Retourne le nombre de cellules recalculées,
+   ou -1 si la mémoire a manqué (les cellules non recalculées restent marquées) */
+static int crp_executer(RoutageCRP* crp, int nbThreads) {
+    int l, i, total = 0;
+    pthread_t threads[64];
+    if (nbThreads < 1) nbThreads = 1;
+    if (nbThreads > 64) nbThreads = 64;
+    crp->personnalise = 1;
+    for (l = 0; l < crp->nbNiveaux; l++) {
+        TravailCRP t;
+        t.crp = crp;
+        t.niveau = l;
+        atomic_init(&t.prochaine, 0);
+        atomic_init(&t.nbCalculees, 0);
+        atomic_init(&t.echec, 0);
+        int lances = 0;
+        for (i = 1; i < nbThreads; i++)
+            if (pthread_create(&threads[lances], NULL, crp_travailleur, &t) == 0) lances++;
+        crp_travailleur(&t); // Le thread appelant travaille aussi
+        for (i = 0; i < lances; i++)
+            pthread_join(threads[i], NULL);
+        total += atomic_load(&t.nbCalculees);
+        if (atomic_load(&t.echec)) return -1;
+    }
+    return total;
+}
+
+/**
+ * Personnalisation complète pour une métrique (poids par arête d'origine, INFINITY = fermée).
+ */
+int crp_personnaliser(RoutageCRP* crp, const double* metrique, int nbThreads) {
+    int l, k;
+    for (k = 0; k < crp->reseau->nbAretes; k++)
+        crp->poids[k] = metrique[crp->reseau->idArete[k]];
+    for (l = 0; l < crp->nbNiveaux; l++)
+        memset(crp->niveaux[l].aRecalculer, 1, crp->niveaux[l].nbCellules);
+    return crp_executer(crp, nbThreads);
+}
+
+/**
+ * Personnalisation partielle après modification du poids de quelques arêtes d'origine : seules
+ * les cellules qui contiennent les deux extrémités d'une arête modifiée sont recalculées.
+ */
+int crp_personnaliser_aretes(RoutageCRP* crp, const double* metrique, const int* aretes, int nbAretes,
+                             int nbThreads) {
+    const Reseau* r = crp->reseau;
+    int i, l;
+    for (i = 0; i < nbAretes; i++) {
+        if (aretes[i] < 0 || aretes[i] >= crp->nbAretesOrigine) continue;
+        int k = crp->positionArete[aretes[i]];
+        if (k < 0) continue;
+        crp->poids[k] = metrique[aretes[i]];
+        // Source de l'arête CSR k : dernier nœud dont la plage commence avant k
+        int bas = 0, haut = r->nbNoeuds - 1;
+        while (bas < haut) {
+            int milieu = (bas + haut + 1) / 2;
+            if (r->debut[milieu] <= k) bas = milieu;
+            else haut = milieu - 1;
+        }
+        for (l = 0; l < crp->nbNiveaux; l++) {
+            int c = crp_cellule(crp, l, bas);
+            if (c == crp_cellule(crp, l, r->cible[k]))
+                crp->niveaux[l].aRecalculer[c] = 1;
+        }
+    }
+    return crp_executer(crp, nbThreads);
+}
+
+/* Plus haut niveau où la cellule de u ne contient ni la source ni la cible (-1 : aucun) */
+static inline int crp_niveau_requete(const RoutageCRP* crp, int u, int s, int t) {
+    int l;
+    for (l = crp->nbNiveaux - 1; l >= 0; l--) {
+        int d = crp->niveaux[l].decalage;
+        int cu = crp->feuille[u] >> d;
+        if (cu != (crp->feuille[s] >> d) && cu != (crp->feuille[t] >> d)) return l;
+    }
+    return -1;
+}
+
+/* Chemin en cours de reconstitution */
+typedef struct {
+    int* noeuds;
+    int longueur;
+    int capacite;
+} CheminCRP;
+
+static int crp_chemin_ajouter(CheminCRP* c, int u) {
+    if (c->longueur == c->capacite) {
+        int capacite = c->capacite ? 2 * c->capacite : 64;
+        int* t = (int*)realloc(c->noeuds, sizeof(int) * capacite);
+        if (!t) return 0;
+        c->noeuds = t;
+        c->capacite = capacite;
+    }
+    c->noeuds[c->longueur++] = u;
+    return 1;
+}
+
+/*
+ * Remplace l'arc de clique a -> b du niveau l par les nœuds du chemin (b compris, a non) : recherche
+ * dans la cellule avec les arcs du niveau l - 1, puis dépliage récursif de ses propres cliques.
+ */
+static int crp_deplier(const RoutageCRP* crp, int l, int a, int b, EspaceRecherche* e, CheminCRP* chemin) {
+    int c = crp_cellule(crp, l, a), n = 0, u, i, ok = 1;
+    espace_nouvelle_recherche(e);
+    espace_fixer(e, a, 0.0, -1, -1);
+    tas_inserer(&e->tas, 0.0, a);
+    while (e->tas.taille > 0) {
+        ElementTas x = tas_extraire(&e->tas);
+        u = x.valeur;
+        double du = espace_dist(e, u);
+        if (x.cle > du) continue;
+        if (u == b) break;
+        crp_relacher(crp, l - 1, u, du, l, c, e);
+    }
+    if (espace_dist(e, b) >= 1e300) return 0;
+    // Copie du sous-chemin (nœud, arc) avant de réutiliser l'espace dans les appels récursifs
+    for (u = b; u != a; u = e->parent[u]) n++;
+    int* noeuds = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    int* arcs = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    if (!noeuds || !arcs) {
+        free(noeuds);
+        free(arcs);
+        return 0;
+    }
+    for (u = b, i = n - 1; u != a; u = e->parent[u], i--) {
+        noeuds[i] = u;
+        arcs[i] = e->parentArete[u];
+    }
+    int precedent = a;
+    for (i = 0; i < n && ok; i++) {
+        if (arcs[i] >= 0) ok = crp_chemin_ajouter(chemin, noeuds[i]);
+        else ok = crp_deplier(crp, -2 - arcs[i], precedent, noeuds[i], e, chemin);
+        precedent = noeuds[i];
+    }
+    free(noeuds);
+    free(arcs);
+    return ok;
+}
+
+/**
+ * Plus court chemin pour la métrique de la dernière personnalisation. L'itinéraire donne tous
+ * les nœuds du réseau traversés ; l'espace doit couvrir les nœuds du réseau.
+ */
+Itineraire crp_itineraire(const RoutageCRP* crp, int source, int cible, EspaceRecherche* e) {
+    Itineraire it = { NULL, 0, 0.0 };
+    int n = crp->reseau->nbNoeuds;
+    if (!crp->personnalise || source < 0 || source >= n || cible < 0 || cible >= n) return it;
+    espace_nouvelle_recherche(e);
+    espace_fixer(e, source, 0.0, -1, -1);
+    tas_inserer(&e->tas, 0.0, source);
+    while (e->tas.taille > 0) {
+        ElementTas x = tas_extraire(&e->tas);
+        int u = x.valeur;
+        double du = espace_dist(e, u);
+        if (x.cle > du) continue;
+        if (u == cible) break;
+        crp_relacher(crp, crp_niveau_requete(crp, u, source, cible), u, du, -1, -1, e);
+    }
+    Itineraire sur = espace_itineraire(e, source, cible);
+    if (sur.longueur == 0) return it;
+    // Arcs du chemin sur la surcouche, puis dépliage des cliques
+    int* arcs = (int*)malloc(sizeof(int) * sur.longueur);
+    CheminCRP chemin = { NULL, 0, 0 };
+    int i, ok = arcs && crp_chemin_ajouter(&chemin, source);
+    for (i = 1; ok && i < sur.longueur; i++) arcs[i] = e->parentArete[sur.noeuds[i]];
+    for (i = 1; ok && i < sur.longueur; i++) {
+        if (arcs[i] >= 0) ok = crp_chemin_ajouter(&chemin, sur.noeuds[i]);
+        else ok = crp_deplier(crp, -2 - arcs[i], sur.noeuds[i - 1], sur.noeuds[i], e, &chemin);
+    }
+    free(arcs);
+    if (!ok) {
+        free(chemin.noeuds);
+        itineraire_liberer(&sur);
+        return it;
+    }
+    it.noeuds = chemin.noeuds;
+    it.longueur = chemin.longueur;
+    it.cout = sur.cout;
+    itineraire_liberer(&sur);
+    return it;
+}
+
+#endif
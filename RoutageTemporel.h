@@ -0,0 +1,222 @@
+#ifndef ROUTAGE_TEMPOREL_H
+#define ROUTAGE_TEMPOREL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "Reseau.h"
+#include "Recherche.h"
+#include "Feux.h"
+#include "Fermetures.h"
+
+/* ===================== Profils de congestion ===================== */
+/*
+ * Un profil est une fonction linéaire par morceaux, périodique sur la journée, qui donne
+ * le facteur multiplicatif du temps de parcours d'une arête selon l'heure.
+ * Les points (minute, facteur en millièmes) tiennent sur 4 octets et les arêtes partagent
+ * leurs profils : une arête ne stocke que le numéro de son profil (-1 = facteur 1).
+ */
+
+#define SECONDES_PAR_JOUR 86400.0
+#define MINUTES_PAR_JOUR 1440
+
+typedef struct {
+    unsigned short minute;   // Minute de la journée [0, 1440)
+    unsigned short facteur;  // Facteur en millièmes (1000 = temps de parcours nominal)
+} PointProfil;
+
+typedef struct {
+    int nbProfils;
+    int capaciteProfils;
+    int* debut;              // Points du profil p : points[debut[p] .. debut[p+1]-1]
+    PointProfil* points;
+    int nbPoints;
+    int capacitePoints;
+    int nbAretes;
+    int* profilArete;        // Profil de chaque arête (indice d'origine), -1 si aucun
+    double facteurMin;       // Plus petit facteur rencontré (pour l'heuristique A*)
+} ProfilsCongestion;
+
+void profils_liberer(ProfilsCongestion* p) {
+    free(p->debut);
+    free(p->points);
+    free(p->profilArete);
+    p->debut = NULL;
+    p->points = NULL;
+    p->profilArete = NULL;
+    p->nbProfils = p->nbPoints = p->nbAretes = 0;
+}
+
+/**
+ * Initialise un jeu de profils vide pour nbAretes arêtes (aucune congestion).
+ */
+int profils_init(ProfilsCongestion* p, int nbAretes) {
+    int i;
+    p->nbProfils = 0;
+    p->capaciteProfils = 8;
+    p->nbPoints = 0;
+    p->capacitePoints = 64;
+    p->nbAretes = nbAretes;
+    p->facteurMin = 1.0;
+    p->debut = (int*)malloc(sizeof(int) * (p->capaciteProfils + 1));
+    p->points = (PointProfil*)malloc(sizeof(PointProfil) * p->capacitePoints);
+    p->profilArete = (int*)malloc(sizeof(int) * (nbAretes > 0 ? nbAretes : 1));
+    if (!p->debut || !p->points || !p->profilArete) {
+        profils_liberer(p);
+        return 0;
+    }
+    p->debut[0] = 0;
+    for (i = 0; i < nbAretes; i++)
+        p->profilArete[i] = -1;
+    return 1;
+}
+
+/**
+ * Ajoute un profil défini par des points (minute, facteur) triés par minute croissante.
+ * Retourne le numéro du profil, ou -1 en cas d'erreur.
+ */
+int profils_ajouter(ProfilsCongestion* p, const int* minutes, const double* facteurs, int nbPoints) {
+    int i;
+    if (nbPoints <= 0)
+        return -1;
+    if (p->nbProfils + 1 > p->capaciteProfils) {
+        int* d = (int*)realloc(p->debut, sizeof(int) * (2 * p->capaciteProfils + 1));
+        if (!d) return -1;
+        p->debut = d;
+        p->capaciteProfils *= 2;
+    }
+    if (p->nbPoints + nbPoints > p->capacitePoints) {
+        int capacite = p->capacitePoints;
+        while (capacite < p->nbPoints + nbPoints) capacite *= 2;
+        PointProfil* pts = (PointProfil*)realloc(p->points, sizeof(PointProfil) * capacite);
+        if (!pts) return -1;
+        p->points = pts;
+        p->capacitePoints = capacite;
+    }
+    for (i = 0; i < nbPoints; i++) {
+        PointProfil* pt = &p->points[p->nbPoints++];
+        int m = minutes[i] % MINUTES_PAR_JOUR;
+        double f = facteurs[i] < 0.001 ? 0.001 : (facteurs[i] > 65.0 ? 65.0 : facteurs[i]);
+        pt->minute = (unsigned short)(m < 0 ? m + MINUTES_PAR_JOUR : m);
+        pt->facteur = (unsigned short)lround(f * 1000.0);
+        if (pt->facteur / 1000.0 < p->facteurMin)
+            p->facteurMin = pt->facteur / 1000.0;
+    }
+    p->debut[++p->nbProfils] = p->nbPoints;
+    return p->nbProfils - 1;
+}
+
+/**
+ * Associe un profil à une arête (indice d'origine).
+ */
+void profils_affecter(ProfilsCongestion* p, int arete, int profil) {
+    if (arete >= 0 && arete < p->nbAretes)
+        p->profilArete[arete] = profil;
+}
+
+/**
+ * Facteur de temps de parcours d'une arête à l'heure donnée (secondes depuis minuit).
+ * Interpolation linéaire entre les points qui encadrent l'heure, en bouclant sur la journée.
+ * Aucune allocation : appelée dans la boucle interne des recherches.
+ */
+double profils_facteur(const ProfilsCongestion* p, int arete, double heure) {
+    if (!p || arete < 0 || arete >= p->nbAretes || p->profilArete[arete] < 0)
+        return 1.0;
+    int prof = p->profilArete[arete];
+    const PointProfil* pts = &p->points[p->debut[prof]];
+    int n = p->debut[prof + 1] - p->debut[prof];
+    if (n == 1)
+        return pts[0].facteur / 1000.0;
+    double m = fmod(heure, SECONDES_PAR_JOUR) / 60.0;
+    if (m < 0) m += MINUTES_PAR_JOUR;
+    // Premier point strictement après m (les profils ont peu de points : parcours linéaire)
+    int k = 0;
+    while (k < n && pts[k].minute <= m) k++;
+    const PointProfil* a = (k == 0) ? &pts[n - 1] : &pts[k - 1];
+    const PointProfil* b = (k == n) ? &pts[0] : &pts[k];
+    double ma = a->minute, mb = b->minute;
+    if (mb <= ma) mb += MINUTES_PAR_JOUR;
+    if (m < ma) m += MINUTES_PAR_JOUR;
+    double t = (mb > ma) ? (m - ma) / (mb - ma) : 0.0;
+    return (a->facteur + t * (b->facteur - a->facteur)) / 1000.0;
+}
+
+/* ===================== Itinéraire dépendant du temps ===================== */
+
+/* Paramètres d'une recherche dépendante du temps */
+typedef struct {
+    double vitesse;              // Vitesse du véhicule (unités de distance par seconde)
+    double heureDepart;          // Heure de la journée au départ (s depuis minuit), pour les profils
+    const ProfilsCongestion* profils; // Peut être NULL
+    const double* facteurArete;  // Ralentissement fixe par arête d'origine (ex. 2 si embouteillage), peut être NULL
+    const double* penaliteArete; // Arrêt (s) en fin d'arête lorsque le feu est vert, peut être NULL
+    const IndexFeux* indexFeux;  // Feux par nœud, peut être NULL
+    const FeuRouge* feux;
+    int heuristique;             // 1 : A* (distance euclidienne / vitesse), les distances doivent être >= euclidiennes
+    const Fermetures* fermetures; // Arêtes fermées ou pénalisées, peut être NULL
+} ParametresTemporels;
+
+/* Date d'arrivée au bout de l'arête k (indice CSR) en partant à la date t */
+static double arrivee_arete(const Reseau* r, const ParametresTemporels* prm, int k, double t) {
+    int e = r->idArete[k];
+    double duree = r->poids[k] / prm->vitesse;
+    if (prm->facteurArete) duree *= prm->facteurArete[e];
+    if (arete_penalisee(prm->fermetures, e)) duree *= prm->fermetures->facteurPenalite;
+    duree *= profils_facteur(prm->profils, e, prm->heureDepart + t);
+    double a = t + duree;
+    // Au nœud atteint : attente du feu s'il est rouge, sinon arrêt propre à l'arête
+    double attente = prm->indexFeux ? feux_attente_noeud(prm->indexFeux, prm->feux, r->cible[k], a) : 0.0;
+    if (attente > 0)
+        return a + attente;
+    return a + (prm->penaliteArete ? prm->penaliteArete[e] : 0.0);
+}
+
+/**
+ * Dijkstra (ou A*) dépendant du temps : minimise la date d'arrivée à la cible pour un départ
+ * à la date 'depart' (secondes depuis le début de la simulation, référence des cycles de feux).
+ * Le coût de l'itinéraire retourné est la date d'arrivée.
+ */
+Itineraire itineraire_temporel(const Reseau* r, const ParametresTemporels* prm, int source, int cible,
+                               double depart, EspaceRecherche* e) {
+    Itineraire vide = { NULL, 0, 0.0 };
+    if (source < 0 || source >= r->nbNoeuds || cible < 0 || cible >= r->nbNoeuds || prm->vitesse <= 0)
+        return vide;
+    double borne = 0.0; // Borne inférieure du temps par unité de distance euclidienne
+    if (prm->heuristique) {
+        double fmin = prm->profils ? prm->profils->facteurMin : 1.0;
+        borne = (fmin < 1.0 ? fmin : 1.0) / prm->vitesse;
+    }
+    espace_nouvelle_recherche(e);
+    espace_fixer(e, source, depart, -1, -1);
+    tas_inserer(&e->tas, depart, source);
+    while (e->tas.taille > 0) {
+        ElementTas x = tas_extraire(&e->tas);
+        int u = x.valeur;
+        double du = espace_dist(e, u);
+        double hu = 0.0;
+        if (borne > 0) {
+            double dx = r->X[u] - r->X[cible], dy = r->Y[u] - r->Y[cible];
+            hu = sqrt(dx * dx + dy * dy) * borne;
+        }
+        if (x.cle > du + hu + 1e-9) continue; // Entrée périmée
+        if (u == cible) break;
+        int k;
+        for (k = r->debut[u]; k < r->debut[u + 1]; k++) {
+            if (arete_fermee(prm->fermetures, r->idArete[k])) continue;
+            int v = r->cible[k];
+            double a = arrivee_arete(r, prm, k, du);
+            if (a < espace_dist(e, v)) {
+                espace_fixer(e, v, a, u, k);
+                double h = 0.0;
+                if (borne > 0) {
+                    double dx = r->X[v] - r->X[cible], dy = r->Y[v] - r->Y[cible];
+                    h = sqrt(dx * dx + dy * dy) * borne;
+                }
+                tas_inserer(&e->tas, a + h, v);
+            }
+        }
+    }
+    return espace_itineraire(e, source, cible);
+}
+
+#endif
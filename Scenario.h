@@ -0,0 +1,174 @@
+#ifndef SCENARIO_H
+#define SCENARIO_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "FormatCarte.h"
+
+/* ===================== Scénarios sans interaction ===================== */
+/*
+ * Un scénario décrit un essai complet, joué sans saisie ni pause : graphe, véhicules, requêtes
+ * d'itinéraire, perturbations et simulations. Même format que les cartes : une ligne par
+ * commande, champs séparés par des virgules, '#' pour les commentaires.
+ *
+ *   G,carte                             graphe : fichier de carte, ou côté d'une grille synthétique
+ *   V,nom,vitesse[,virages]             véhicule (virages : 1 = coûts et interdictions de virage)
+ *   R,source,cible,vehicule[,depart]    requête d'itinéraire, départ à la date donnée (s)
+ *   P,arete,etat                        perturbation : 0 = rétablie, 1 = accident (fermée), 2 = panne
+ *   S,vehicules,duree[,vehicule]        simulation multi-thread de 'duree' secondes
+ *
+ * Les commandes sont jouées dans l'ordre du fichier : une perturbation vaut pour les requêtes
+ * et les simulations qui la suivent. Le fichier est lu en entier et vérifié avant de jouer la
+ * première commande ; les numéros d'arête et de nœud, qui dépendent du graphe, le sont au jeu.
+ */
+
+typedef struct {
+    int nom;          // Position du nom dans les textes du scénario
+    double vitesse;
+    int virages;
+} VehiculeScenario;
+
+typedef struct {
+    char type;        // 'G', 'V', 'R', 'P' ou 'S'
+    int ligne;        // Numéro de ligne dans le fichier
+    int a, b, c;      // G : fichier (texte) ; V : véhicule ; R : source, cible, véhicule ;
+                      // P : arête, état ; S : nombre de véhicules, véhicule (-1 : vitesse par défaut)
+    double x;         // R : départ ; S : durée
+} CommandeScenario;
+
+typedef struct {
+    CommandeScenario* commandes;
+    int nbCommandes, capaciteCommandes;
+    int nbGraphes;    // Commandes G
+    VehiculeScenario* vehicules;
+    int nbVehicules, capaciteVehicules;
+    char* textes;     // Noms des fichiers et des véhicules, terminés par '\0'
+    int tailleTextes, capaciteTextes;
+} Scenario;
+
+void scenario_init(Scenario* sc) {
+    memset(sc, 0, sizeof(Scenario));
+}
+
+void scenario_liberer(Scenario* sc) {
+    free(sc->commandes);
+    free(sc->vehicules);
+    free(sc->textes);
+    scenario_init(sc);
+}
+
+const char* scenario_texte(const Scenario* sc, int position) {
+    return sc->textes + position;
+}
+
+static int scenario_ajouter_texte(Scenario* sc, const char* s, int longueur) {
+    if (!carte_reserver((void**)&sc->textes, &sc->capaciteTextes, sc->tailleTextes + longueur + 1, 1))
+        return -1;
+    int position = sc->tailleTextes;
+    memcpy(sc->textes + position, s, longueur);
+    sc->textes[position + longueur] = '\0';
+    sc->tailleTextes += longueur + 1;
+    return position;
+}
+
+/* Dernier véhicule défini sous ce nom, -1 s'il n'y en a pas */
+static int scenario_vehicule(const Scenario* sc, const char* nom, int longueur) {
+    int i;
+    for (i = sc->nbVehicules - 1; i >= 0; i--) {
+        const char* s = scenario_texte(sc, sc->vehicules[i].nom);
+        if ((int)strlen(s) == longueur && memcmp(s, nom, longueur) == 0) return i;
+    }
+    return -1;
+}
+
+/* Traite une ligne ; retourne 0 si elle est invalide */
+static int scenario_ligne(Scenario* sc, char* ligne, char* fin, int numero) {
+    char* champs[6];
+    int longueurs[6];
+    int n = carte_champs(ligne, fin, champs, longueurs, 6);
+    if (longueurs[0] == 0 || champs[0][0] == '#')
+        return 1; // Ligne vide ou commentaire
+    if (longueurs[0] != 1) return 0;
+    CommandeScenario cmd = { champs[0][0], numero, 0, 0, 0, 0.0 };
+    // Une requête, une perturbation ou une simulation porte sur le graphe chargé avant elle
+    if (cmd.type != 'G' && cmd.type != 'V' && sc->nbGraphes == 0) return 0;
+    switch (cmd.type) {
+    case 'G':
+        if (n < 2 || longueurs[1] == 0) return 0;
+        cmd.a = scenario_ajouter_texte(sc, champs[1], longueurs[1]);
+        if (cmd.a < 0) return 0;
+        sc->nbGraphes++;
+        break;
+    case 'V': {
+        VehiculeScenario v = { 0, 0.0, 0 };
+        if (n < 3 || longueurs[1] == 0 || !carte_reel(champs[2], longueurs[2], &v.vitesse) || v.vitesse <= 0)
+            return 0;
+        if (n > 3 && longueurs[3] > 0 && !carte_entier(champs[3], longueurs[3], &v.virages)) return 0;
+        v.nom = scenario_ajouter_texte(sc, champs[1], longueurs[1]);
+        if (v.nom < 0 ||
+            !carte_reserver((void**)&sc->vehicules, &sc->capaciteVehicules, sc->nbVehicules + 1, sizeof(VehiculeScenario)))
+            return 0;
+        cmd.a = sc->nbVehicules;
+        sc->vehicules[sc->nbVehicules++] = v;
+        break;
+    }
+    case 'R':
+        if (n < 4 || !carte_entier(champs[1], longueurs[1], &cmd.a) || !carte_entier(champs[2], longueurs[2], &cmd.b))
+            return 0;
+        cmd.c = scenario_vehicule(sc, champs[3], longueurs[3]);
+        if (cmd.c < 0) return 0;
+        if (n > 4 && longueurs[4] > 0 && !carte_reel(champs[4], longueurs[4], &cmd.x)) return 0;
+        break;
+    case 'P':
+        if (n < 3 || !carte_entier(champs[1], longueurs[1], &cmd.a) || !carte_entier(champs[2], longueurs[2], &cmd.b) ||
+            cmd.b < 0 || cmd.b > 2)
+            return 0;
+        break;
+    case 'S':
+        cmd.b = -1;
+        if (n < 3 || !carte_entier(champs[1], longueurs[1], &cmd.a) || cmd.a < 0 ||
+            !carte_reel(champs[2], longueurs[2], &cmd.x) || cmd.x < 0)
+            return 0;
+        if (n > 3 && longueurs[3] > 0 && (cmd.b = scenario_vehicule(sc, champs[3], longueurs[3])) < 0) return 0;
+        break;
+    default:
+        return 0;
+    }
+    if (!carte_reserver((void**)&sc->commandes, &sc->capaciteCommandes, sc->nbCommandes + 1, sizeof(CommandeScenario)))
+        return 0;
+    sc->commandes[sc->nbCommandes++] = cmd;
+    return 1;
+}
+
+/**
+ * Lit un scénario ("-" : entrée standard). En cas d'erreur, 'erreur' reçoit un message avec le
+ * numéro de ligne et le scénario est vide.
+ */
+int scenario_charger(Scenario* sc, const char* fichier, char* erreur, size_t tailleErreur) {
+    int entree = strcmp(fichier, "-") == 0;
+    FILE* f = entree ? stdin : fopen(fichier, "r");
+    scenario_init(sc);
+    if (!f) {
+        if (erreur) snprintf(erreur, tailleErreur, "impossible d'ouvrir %s", fichier);
+        return 0;
+    }
+    char* ligne = NULL;
+    size_t capacite = 0;
+    ssize_t longueur;
+    int numero = 0, ok = 1;
+    while (ok && (longueur = getline(&ligne, &capacite, f)) >= 0) {
+        numero++;
+        if (longueur > 0 && ligne[longueur - 1] == '\n') longueur--;
+        ok = scenario_ligne(sc, ligne, ligne + longueur, numero);
+    }
+    free(ligne);
+    if (!entree) fclose(f);
+    if (!ok) {
+        if (erreur) snprintf(erreur, tailleErreur, "%s : ligne %d invalide", fichier, numero);
+        scenario_liberer(sc);
+    }
+    return ok;
+}
+
+#endif
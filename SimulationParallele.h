@@ -0,0 +1,446 @@
+#ifndef SIMULATION_PARALLELE_H
+#define SIMULATION_PARALLELE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <limits.h>
+#include <math.h>
+#include "Reseau.h"
+#include "Tas.h"
+#include "Fermetures.h"
+
+/* ===================== Simulation parallèle par régions ===================== */
+/*
+ * Le réseau est découpé en régions ; chaque région est simulée par son propre thread
+ * avec sa propre file d'événements (tas ordonné par date puis par ID de véhicule).
+ * Un véhicule qui passe dans une autre région est transmis par une boîte aux lettres
+ * sans verrou. Les threads avancent par fenêtres de temps dont la largeur est le plus
+ * petit temps de parcours d'une arête frontière : un message envoyé pendant une fenêtre
+ * ne peut donc concerner que la fenêtre suivante, et les boîtes sont vidées à la
+ * barrière de synchronisation. Chaque nœud n'est traité que par sa région, dans l'ordre
+ * (date, ID) : le résultat est identique à une exécution sur un seul thread.
+ */
+
+#define INTERVALLE_DEPART 2.0   // Écart minimal (s) entre deux départs d'un même nœud
+#define TEMPS_MIN_ARETE 0.001   // Temps de parcours minimal d'une arête (s)
+
+/* Véhicule de la simulation à grande échelle */
+typedef struct {
+    int ID;
+    int noeud;           // Nœud atteint (ou en cours d'approche) à la date 'temps'
+    int precedent;       // Nœud quitté (évite les demi-tours)
+    double temps;        // Date d'arrivée au nœud 'noeud'
+    double vitesse;
+    double distance;     // Distance totale parcourue
+    int nbDeplacements;
+    int termine;         // 1 si le véhicule est bloqué ou a dépassé la durée simulée
+    unsigned long long graine; // Générateur aléatoire propre au véhicule
+} VehiculeSim;
+
+/* Message échangé entre deux régions : un véhicule et sa date d'arrivée */
+typedef struct {
+    double temps;
+    int vehicule;
+} MessageSim;
+
+/* Boîte aux lettres à un producteur et un consommateur.
+   Le producteur écrit librement puis publie le nombre de messages (release) ;
+   le consommateur lit ce nombre (acquire) après la barrière. */
+typedef struct {
+    MessageSim* messages;
+    int capacite;
+    int nbEcrits;
+    atomic_int nbPublies;
+} BoiteAuxLettres;
+
+/* État d'une région (un thread) */
+typedef struct {
+    int id;
+    Tas evenements;
+    long nbEvenements;   // Arrivées traitées
+    long nbEnvoyes;      // Véhicules transmis à une autre région
+    int parite;          // Parité de la fenêtre en cours (choix des boîtes)
+    struct SimulationParallele* sim;
+} RegionSim;
+
+typedef struct SimulationParallele {
+    const Reseau* reseau;
+    const int* region;        // Région de chaque nœud
+    int nbRegions;
+    VehiculeSim* vehicules;
+    int nbVehicules;
+    double* derniereSortie;   // Date du dernier départ de chaque nœud
+    double (*attenteNoeud)(void* contexte, int noeud, double temps); // Attente imposée à un nœud (optionnelle)
+    void* contexteAttente;
+    const Fermetures* fermetures; // Arêtes fermées (jamais prises) ou pénalisées, peut être NULL
+    BoiteAuxLettres* boites;  // [parité][source][destination]
+    RegionSim* regions;
+    double fenetre;
+    double duree;
+    atomic_int echec;         // Un message n'a pas pu être déposé (mémoire épuisée) : résultat faux
+    pthread_barrier_t barriere;
+    pthread_mutex_t verrouDepart;
+    pthread_cond_t signalDepart;
+    int depart;               // 0 : threads en attente, 1 : départ, -1 : abandon (un thread n'a pas démarré)
+} SimulationParallele;
+
+/* ===================== Générateur aléatoire ===================== */
+
+static unsigned long long sim_splitmix(unsigned long long x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+static unsigned int sim_aleatoire(unsigned long long* graine) {
+    unsigned long long x = *graine;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *graine = x;
+    return (unsigned int)((x * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+/**
+ * Place les véhicules sur des nœuds tirés au hasard, avec un départ échelonné.
+ * Le tirage ne dépend que de la graine : deux appels identiques donnent le même état.
+ */
+void vehicules_sim_init(VehiculeSim* vehicules, int nb, const Reseau* r, double vitesse, unsigned long long graine) {
+    int i;
+    for (i = 0; i < nb; i++) {
+        VehiculeSim* v = &vehicules[i];
+        unsigned long long g = sim_splitmix(graine ^ sim_splitmix((unsigned long long)i));
+        v->ID = i;
+        v->graine = g ? g : 1;
+        v->noeud = (int)(sim_aleatoire(&v->graine) % (unsigned int)r->nbNoeuds);
+        v->precedent = -1;
+        v->temps = (sim_aleatoire(&v->graine) % 1000) / 100.0;
+        v->vitesse = vitesse;
+        v->distance = 0.0;
+        v->nbDeplacements = 0;
+        v->termine = 0;
+    }
+}
+
+/**
+ * Empreinte de l'état final des véhicules (pour comparer deux exécutions).
+ */
+unsigned long long simulation_empreinte(const VehiculeSim* vehicules, int nb) {
+    unsigned long long h = 1469598103934665603ULL;
+    int i;
+    for (i = 0; i < nb; i++) {
+        unsigned long long bits;
+        memcpy(&bits, &vehicules[i].temps, sizeof(bits));
+        h = (h ^ (unsigned long long)vehicules[i].noeud) * 1099511628211ULL;
+        h = (h ^ (unsigned long long)vehicules[i].nbDeplacements) * 1099511628211ULL;
+        h = (h ^ bits) * 1099511628211ULL;
+    }
+    return h;
+}
+
+/* ===================== Découpage en régions ===================== */
+
+typedef struct {
+    int cle;
+    int noeud;
+} CleNoeud;
+
+static int comparer_cle_noeud(const void* a, const void* b) {
+    const CleNoeud* x = (const CleNoeud*)a;
+    const CleNoeud* y = (const CleNoeud*)b;
+    if (x->cle != y->cle) return (x->cle < y->cle) ? -1 : 1;
+    return x->noeud - y->noeud;
+}
+
+/* Bissection récursive : coupe selon l'axe le plus étendu, proportionnellement au nombre de régions */
+static void bissection_coordonnees(const Reseau* r, CleNoeud* t, int n, int premiere, int nbRegions, int* region) {
+    int i;
+    if (nbRegions <= 1 || n <= 1) {
+        for (i = 0; i < n; i++) region[t[i].noeud] = premiere;
+        return;
+    }
+    int minX = INT_MAX, maxX = INT_MIN, minY = INT_MAX, maxY = INT_MIN;
+    for (i = 0; i < n; i++) {
+        int u = t[i].noeud;
+        if (r->X[u] < minX) minX = r->X[u];
+        if (r->X[u] > maxX) maxX = r->X[u];
+        if (r->Y[u] < minY) minY = r->Y[u];
+        if (r->Y[u] > maxY) maxY = r->Y[u];
+    }
+    int selonX = (maxX - minX) >= (maxY - minY);
+    for (i = 0; i < n; i++)
+        t[i].cle = selonX ? r->X[t[i].noeud] : r->Y[t[i].noeud];
+    qsort(t, n, sizeof(CleNoeud), comparer_cle_noeud);
+    int gauche = nbRegions / 2;
+    int coupe = (int)((long long)n * gauche / nbRegions);
+    bissection_coordonnees(r, t, coupe, premiere, gauche, region);
+    bissection_coordonnees(r, t + coupe, n - coupe, premiere + gauche, nbRegions - gauche, region);
+}
+
+/**
+ * Découpe le réseau en régions de tailles équilibrées d'après les coordonnées des nœuds.
+ * Retourne un tableau (à libérer) donnant la région de chaque nœud.
+ */
+int* partition_coordonnees(const Reseau* r, int nbRegions) {
+    int* region = (int*)malloc(sizeof(int) * (r->nbNoeuds > 0 ? r->nbNoeuds : 1));
+    CleNoeud* t = (CleNoeud*)malloc(sizeof(CleNoeud) * (r->nbNoeuds > 0 ? r->nbNoeuds : 1));
+    if (!region || !t) {
+        free(region);
+        free(t);
+        return NULL;
+    }
+    int i;
+    for (i = 0; i < r->nbNoeuds; i++)
+        t[i].noeud = i;
+    bissection_coordonnees(r, t, r->nbNoeuds, 0, nbRegions < 1 ? 1 : nbRegions, region);
+    free(t);
+    return region;
+}
+
+/* ===================== Boîtes aux lettres ===================== */
+
+static BoiteAuxLettres* sim_boite(SimulationParallele* sim, int parite, int source, int destination) {
+    return &sim->boites[(parite * sim->nbRegions + source) * sim->nbRegions + destination];
+}
+
+/* Écriture côté producteur : seul le thread de la région source touche à la boîte */
+static int boite_deposer(BoiteAuxLettres* b, double temps, int vehicule) {
+    if (b->nbEcrits == b->capacite) {
+        int capacite = b->capacite ? b->capacite * 2 : 64;
+        MessageSim* m = (MessageSim*)realloc(b->messages, sizeof(MessageSim) * capacite);
+        if (!m) return 0;
+        b->messages = m;
+        b->capacite = capacite;
+    }
+    b->messages[b->nbEcrits].temps = temps;
+    b->messages[b->nbEcrits].vehicule = vehicule;
+    b->nbEcrits++;
+    return 1;
+}
+
+/* ===================== Traitement d'une région ===================== */
+
+/* Arrivée d'un véhicule à un nœud : choix de l'arête suivante et planification */
+static void region_traiter_arrivee(RegionSim* reg, ElementTas ev) {
+    SimulationParallele* sim = reg->sim;
+    const Reseau* r = sim->reseau;
+    VehiculeSim* v = &sim->vehicules[ev.valeur];
+    int u = v->noeud;
+    int debut = r->debut[u], degre = r->debut[u + 1] - r->debut[u];
+    reg->nbEvenements++;
+    if (degre == 0) {
+        v->termine = 1;
+        return;
+    }
+    // Choix aléatoire d'une arête sortante, sans demi-tour si possible
+    int k = debut + (int)(sim_aleatoire(&v->graine) % (unsigned int)degre);
+    if (degre > 1 && r->cible[k] == v->precedent)
+        k = debut + (k - debut + 1) % degre;
+    // Arête fermée : la suivante ouverte, dans l'ordre ; le véhicule s'arrête si toutes le sont
+    if (sim->fermetures) {
+        int essais = 0;
+        while (essais < degre && arete_fermee(sim->fermetures, r->idArete[k])) {
+            k = debut + (k - debut + 1) % degre;
+            essais++;
+        }
+        if (essais == degre) {
+            v->termine = 1;
+            return;
+        }
+    }
+    // Attente au nœud (feu rouge...) puis respect de l'écart minimal entre départs
+    double depart = ev.cle;
+    if (sim->attenteNoeud)
+        depart += sim->attenteNoeud(sim->contexteAttente, u, depart);
+    if (depart < sim->derniereSortie[u] + INTERVALLE_DEPART)
+        depart = sim->derniereSortie[u] + INTERVALLE_DEPART;
+    sim->derniereSortie[u] = depart;
+    double parcours = r->poids[k] / v->vitesse;
+    if (arete_penalisee(sim->fermetures, r->idArete[k])) parcours *= sim->fermetures->facteurPenalite;
+    if (parcours < TEMPS_MIN_ARETE) parcours = TEMPS_MIN_ARETE;
+    int w = r->cible[k];
+    v->precedent = u;
+    v->noeud = w;
+    v->temps = depart + parcours;
+    v->distance += r->poids[k];
+    v->nbDeplacements++;
+    if (v->temps >= sim->duree) {
+        v->termine = 1;
+        return;
+    }
+    int dest = sim->region[w];
+    if (dest == reg->id) {
+        tas_inserer(&reg->evenements, v->temps, ev.valeur);
+    } else {
+        if (!boite_deposer(sim_boite(sim, reg->parite, reg->id, dest), v->temps, ev.valeur)) {
+            atomic_store_explicit(&sim->echec, 1, memory_order_relaxed);
+            return;
+        }
+        reg->nbEnvoyes++;
+    }
+}
+
+static void* region_executer(void* arg) {
+    RegionSim* reg = (RegionSim*)arg;
+    SimulationParallele* sim = reg->sim;
+    int nbFenetres = (int)ceil(sim->duree / sim->fenetre);
+    int w, s;
+    for (w = 0; w < nbFenetres; w++) {
+        int parite = w & 1;
+        reg->parite = parite;
+        double fin = (w + 1) * sim->fenetre;
+        // Les boîtes de cette parité ont été vidées avant la barrière précédente
+        for (s = 0; s < sim->nbRegions; s++)
+            sim_boite(sim, parite, reg->id, s)->nbEcrits = 0;
+        while (reg->evenements.taille > 0 && reg->evenements.elements[0].cle < fin) {
+            ElementTas ev = tas_extraire(&reg->evenements);
+            region_traiter_arrivee(reg, ev);
+        }
+        if (sim->nbRegions == 1)
+            continue;
+        // Publication des messages de la fenêtre puis synchronisation
+        for (s = 0; s < sim->nbRegions; s++) {
+            BoiteAuxLettres* b = sim_boite(sim, parite, reg->id, s);
+            atomic_store_explicit(&b->nbPublies, b->nbEcrits, memory_order_release);
+        }
+        pthread_barrier_wait(&sim->barriere);
+        for (s = 0; s < sim->nbRegions; s++) {
+            BoiteAuxLettres* b = sim_boite(sim, parite, s, reg->id);
+            int n = atomic_load_explicit(&b->nbPublies, memory_order_acquire), i;
+            for (i = 0; i < n; i++)
+                tas_inserer(&reg->evenements, b->messages[i].temps, b->messages[i].vehicule);
+        }
+    }
+    return NULL;
+}
+
+/* Thread d'une région : n'utilise la barrière qu'une fois tous les threads créés */
+static void* region_thread(void* arg) {
+    SimulationParallele* sim = ((RegionSim*)arg)->sim;
+    pthread_mutex_lock(&sim->verrouDepart);
+    while (sim->depart == 0) pthread_cond_wait(&sim->signalDepart, &sim->verrouDepart);
+    int depart = sim->depart;
+    pthread_mutex_unlock(&sim->verrouDepart);
+    return depart > 0 ? region_executer(arg) : NULL;
+}
+
+static void simulation_donner_depart(SimulationParallele* sim, int depart) {
+    pthread_mutex_lock(&sim->verrouDepart);
+    sim->depart = depart;
+    pthread_cond_broadcast(&sim->signalDepart);
+    pthread_mutex_unlock(&sim->verrouDepart);
+}
+
+/* ===================== Création, exécution, libération ===================== */
+
+void simulation_parallele_liberer(SimulationParallele* sim) {
+    if (!sim) return;
+    int i;
+    if (sim->regions)
+        for (i = 0; i < sim->nbRegions; i++)
+            tas_liberer(&sim->regions[i].evenements);
+    if (sim->boites)
+        for (i = 0; i < 2 * sim->nbRegions * sim->nbRegions; i++)
+            free(sim->boites[i].messages);
+    free(sim->regions);
+    free(sim->boites);
+    free(sim->derniereSortie);
+    free(sim);
+}
+
+/**
+ * Prépare une simulation : les véhicules sont répartis dans la file d'événements
+ * de la région de leur nœud de départ.
+ */
+SimulationParallele* simulation_parallele_creer(const Reseau* r, const int* region, int nbRegions,
+                                                VehiculeSim* vehicules, int nbVehicules, double duree) {
+    SimulationParallele* sim = (SimulationParallele*)calloc(1, sizeof(SimulationParallele));
+    if (!sim) return NULL;
+    sim->reseau = r;
+    sim->region = region;
+    sim->nbRegions = nbRegions;
+    sim->vehicules = vehicules;
+    sim->nbVehicules = nbVehicules;
+    sim->duree = duree;
+    sim->derniereSortie = (double*)malloc(sizeof(double) * (r->nbNoeuds > 0 ? r->nbNoeuds : 1));
+    sim->boites = (BoiteAuxLettres*)calloc(2 * nbRegions * nbRegions, sizeof(BoiteAuxLettres));
+    sim->regions = (RegionSim*)calloc(nbRegions, sizeof(RegionSim));
+    if (!sim->derniereSortie || !sim->boites || !sim->regions) {
+        simulation_parallele_liberer(sim);
+        return NULL;
+    }
+    int i, u, k;
+    for (u = 0; u < r->nbNoeuds; u++)
+        sim->derniereSortie[u] = -1e18;
+    for (i = 0; i < 2 * nbRegions * nbRegions; i++)
+        atomic_init(&sim->boites[i].nbPublies, 0);
+    atomic_init(&sim->echec, 0);
+    // Largeur de fenêtre : plus petit temps de parcours d'une arête entre deux régions
+    double vmax = 0.0;
+    for (i = 0; i < nbVehicules; i++)
+        if (vehicules[i].vitesse > vmax) vmax = vehicules[i].vitesse;
+    sim->fenetre = duree;
+    for (u = 0; u < r->nbNoeuds && vmax > 0; u++) {
+        for (k = r->debut[u]; k < r->debut[u + 1]; k++) {
+            if (region[u] == region[r->cible[k]]) continue;
+            double t = r->poids[k] / vmax;
+            if (t < TEMPS_MIN_ARETE) t = TEMPS_MIN_ARETE;
+            if (t < sim->fenetre) sim->fenetre = t;
+        }
+    }
+    // Légère marge pour que les arrondis ne fassent jamais tomber un message dans la fenêtre courante
+    sim->fenetre *= 0.999;
+    for (i = 0; i < nbRegions; i++) {
+        sim->regions[i].id = i;
+        sim->regions[i].sim = sim;
+        tas_init(&sim->regions[i].evenements, nbVehicules / nbRegions + 16);
+    }
+    for (i = 0; i < nbVehicules; i++)
+        if (!vehicules[i].termine)
+            tas_inserer(&sim->regions[region[vehicules[i].noeud]].evenements, vehicules[i].temps, i);
+    return sim;
+}
+
+/**
+ * Exécute la simulation jusqu'à sa durée : un thread par région
+ * (aucun thread supplémentaire s'il n'y a qu'une région). Une durée nulle ne fait rien.
+ * Retourne 0 si la simulation n'a pas pu être faite en entier : un thread n'a pas démarré
+ * (rien n'est alors simulé) ou un véhicule n'a pas pu passer à une autre région.
+ */
+int simulation_parallele_executer(SimulationParallele* sim) {
+    int i, lances = 0;
+    if (sim->duree <= 0)
+        return 1; // Rien à simuler (et la fenêtre serait nulle : nombre de fenêtres indéfini)
+    if (sim->nbRegions == 1) {
+        region_executer(&sim->regions[0]);
+        return !atomic_load(&sim->echec);
+    }
+    pthread_t* threads = (pthread_t*)malloc(sizeof(pthread_t) * sim->nbRegions);
+    if (!threads) return 0;
+    if (pthread_barrier_init(&sim->barriere, NULL, sim->nbRegions) != 0) {
+        free(threads);
+        return 0;
+    }
+    pthread_mutex_init(&sim->verrouDepart, NULL);
+    pthread_cond_init(&sim->signalDepart, NULL);
+    sim->depart = 0;
+    // Chaque région attend toutes les autres à la barrière : une région sans thread les bloquerait
+    for (i = 0; i < sim->nbRegions; i++) {
+        if (pthread_create(&threads[i], NULL, region_thread, &sim->regions[i]) != 0) break;
+        lances++;
+    }
+    simulation_donner_depart(sim, lances == sim->nbRegions ? 1 : -1);
+    for (i = 0; i < lances; i++)
+        pthread_join(threads[i], NULL);
+    pthread_cond_destroy(&sim->signalDepart);
+    pthread_mutex_destroy(&sim->verrouDepart);
+    pthread_barrier_destroy(&sim->barriere);
+    free(threads);
+    return lances == sim->nbRegions && !atomic_load(&sim->echec);
+}
+
+#endif
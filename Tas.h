@@ -0,0 +1,91 @@
+#ifndef TAS_H
+#define TAS_H
+
+#include <stdlib.h>
+
+/* ===================== Tas binaire (file de priorité) ===================== */
+
+/* Élément du tas : une clé (distance, date...) et une valeur (nœud, véhicule...) */
+typedef struct {
+    double cle;
+    int valeur;
+} ElementTas;
+
+/* Tas minimum. À clé égale, la plus petite valeur sort en premier,
+   ce qui rend l'ordre de traitement totalement déterministe. */
+typedef struct {
+    ElementTas* elements;
+    int taille;
+    int capacite;
+} Tas;
+
+/**
+ * Initialise un tas vide avec une capacité de départ.
+ */
+int tas_init(Tas* tas, int capacite) {
+    if (capacite < 16) capacite = 16;
+    tas->elements = (ElementTas*)malloc(sizeof(ElementTas) * capacite);
+    tas->taille = 0;
+    tas->capacite = tas->elements ? capacite : 0;
+    return tas->elements != NULL;
+}
+
+/**
+ * Libère la mémoire du tas.
+ */
+void tas_liberer(Tas* tas) {
+    free(tas->elements);
+    tas->elements = NULL;
+    tas->taille = tas->capacite = 0;
+}
+
+/* Ordre strict utilisé par le tas : clé puis valeur */
+static int tas_avant(const ElementTas* a, const ElementTas* b) {
+    if (a->cle != b->cle) return a->cle < b->cle;
+    return a->valeur < b->valeur;
+}
+
+/**
+ * Insère un élément. Retourne 0 si l'agrandissement du tas échoue.
+ */
+int tas_inserer(Tas* tas, double cle, int valeur) {
+    if (tas->taille == tas->capacite) {
+        int capacite = tas->capacite ? tas->capacite * 2 : 16;
+        ElementTas* e = (ElementTas*)realloc(tas->elements, sizeof(ElementTas) * capacite);
+        if (!e) return 0;
+        tas->elements = e;
+        tas->capacite = capacite;
+    }
+    int i = tas->taille++;
+    ElementTas x = { cle, valeur };
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!tas_avant(&x, &tas->elements[parent])) break;
+        tas->elements[i] = tas->elements[parent];
+        i = parent;
+    }
+    tas->elements[i] = x;
+    return 1;
+}
+
+/**
+ * Retire le plus petit élément. Le tas ne doit pas être vide.
+ */
+ElementTas tas_extraire(Tas* tas) {
+    ElementTas min = tas->elements[0];
+    ElementTas x = tas->elements[--tas->taille];
+    int i = 0, n = tas->taille;
+    while (1) {
+        int enfant = 2 * i + 1;
+        if (enfant >= n) break;
+        if (enfant + 1 < n && tas_avant(&tas->elements[enfant + 1], &tas->elements[enfant]))
+            enfant++;
+        if (!tas_avant(&tas->elements[enfant], &x)) break;
+        tas->elements[i] = tas->elements[enfant];
+        i = enfant;
+    }
+    if (n > 0) tas->elements[i] = x;
+    return min;
+}
+
+#endif
@@ -0,0 +1,257 @@
+#ifndef TRAJECTOIRES_H
+#define TRAJECTOIRES_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ===================== Enregistreur de trajectoires ===================== */
+/*
+ * Chaque déplacement (véhicule, date, nœud atteint, arête empruntée) est rangé en colonnes
+ * dans des blocs de taille fixe : une requête sur un véhicule ne lit que la colonne des
+ * véhicules, et les dates min/max de chaque bloc permettent de sauter les blocs hors période.
+ *
+ * La mémoire est bornée par un budget fixé à l'initialisation. Quand le budget est atteint ou
+ * qu'un bloc sort de la fenêtre de rétention, le bloc le plus ancien est écrit sur disque (si un
+ * fichier est configuré) ou oublié, puis réutilisé.
+ */
+
+#define TRAJ_TAILLE_BLOC 16384
+#define TRAJ_OCTETS_PAR_DEPLACEMENT (3 * sizeof(int) + sizeof(unsigned int))
+
+typedef struct BlocTrajectoires {
+    int nb;
+    unsigned int tMin, tMax;   // Dates extrêmes du bloc (centièmes de seconde)
+    int* vehicule;             // Colonnes, dans une seule allocation
+    unsigned int* temps;
+    int* noeud;
+    int* arete;                // -1 si le déplacement n'emprunte pas d'arête
+    struct BlocTrajectoires* suivant;
+} BlocTrajectoires;
+
+typedef struct {
+    int maxBlocs;              // Budget mémoire exprimé en blocs
+    int nbBlocs;               // Blocs alloués (jamais plus de maxBlocs)
+    BlocTrajectoires* premier; // Blocs en mémoire, du plus ancien au plus récent
+    BlocTrajectoires* dernier;
+    BlocTrajectoires* libres;  // Blocs sortis, prêts à resservir
+    double retention;          // Durée (s) conservée en mémoire, <= 0 : tant que le budget le permet
+    FILE* disque;              // Fichier de débordement, NULL : les blocs sortis sont oubliés
+    long nbEnregistres;
+    long nbEcrits;             // Déplacements écrits sur disque
+    long nbOublies;            // Déplacements perdus (ni en mémoire ni sur disque)
+    int erreurDisque;          // Une écriture a échoué : le fichier est fermé, les blocs suivants sont oubliés
+} Trajectoires;
+
+/* Conversion des dates en centièmes de seconde (plus de 490 jours avant débordement) */
+static inline unsigned int traj_date(double date) {
+    return date <= 0 ? 0u : (unsigned int)(date * 100.0 + 0.5);
+}
+
+/**
+ * Prépare l'enregistreur avec un budget mémoire (octets), une rétention (s) et un fichier de
+ * débordement optionnel (NULL). Retourne 0 en cas d'échec.
+ */
+int trajectoires_init(Trajectoires* t, size_t budgetOctets, double retention, const char* fichier) {
+    size_t parBloc = sizeof(BlocTrajectoires) + TRAJ_TAILLE_BLOC * TRAJ_OCTETS_PAR_DEPLACEMENT;
+    memset(t, 0, sizeof(Trajectoires));
+    t->maxBlocs = (int)(budgetOctets / parBloc);
+    if (t->maxBlocs < 2) t->maxBlocs = 2;
+    t->retention = retention;
+    if (fichier) {
+        t->disque = fopen(fichier, "wb");
+        if (!t->disque) return 0;
+        int version = 1, taille = TRAJ_TAILLE_BLOC;
+        if (fwrite("TRAJ", 1, 4, t->disque) != 4 || fwrite(&version, sizeof(int), 1, t->disque) != 1 ||
+            fwrite(&taille, sizeof(int), 1, t->disque) != 1 || fflush(t->disque) != 0) {
+            fclose(t->disque);
+            t->disque = NULL;
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/*
+ * Écrit un bloc sur disque : en-tête puis chaque colonne à la suite. Le tampon est vidé à chaque
+ * bloc pour qu'un disque plein se voie ici : le bloc compte alors parmi les oubliés et le fichier
+ * est fermé (il s'arrête au dernier bloc complet, la lecture ignore le bloc tronqué).
+ */
+static void traj_ecrire_bloc(Trajectoires* t, const BlocTrajectoires* b) {
+    size_t n = (size_t)b->nb;
+    int ok = fwrite(&b->nb, sizeof(int), 1, t->disque) == 1 &&
+             fwrite(&b->tMin, sizeof(unsigned int), 1, t->disque) == 1 &&
+             fwrite(&b->tMax, sizeof(unsigned int), 1, t->disque) == 1 &&
+             fwrite(b->vehicule, sizeof(int), n, t->disque) == n &&
+             fwrite(b->temps, sizeof(unsigned int), n, t->disque) == n &&
+             fwrite(b->noeud, sizeof(int), n, t->disque) == n &&
+             fwrite(b->arete, sizeof(int), n, t->disque) == n && fflush(t->disque) == 0;
+    if (ok) {
+        t->nbEcrits += b->nb;
+        return;
+    }
+    t->nbOublies += b->nb;
+    t->erreurDisque = 1;
+    fclose(t->disque);
+    t->disque = NULL;
+}
+
+/* Sort le bloc le plus ancien de la mémoire (écrit ou oublié) et le place dans la liste libre */
+static void traj_sortir_premier(Trajectoires* t) {
+    BlocTrajectoires* b = t->premier;
+    if (!b) return;
+    t->premier = b->suivant;
+    if (!t->premier) t->dernier = NULL;
+    if (t->disque) traj_ecrire_bloc(t, b);
+    else t->nbOublies += b->nb;
+    b->nb = 0;
+    b->suivant = t->libres;
+    t->libres = b;
+}
+
+/* Bloc vide pour de nouveaux déplacements : recyclé, alloué dans le budget, ou pris au plus ancien */
+static BlocTrajectoires* traj_nouveau_bloc(Trajectoires* t) {
+    BlocTrajectoires* b;
+    if (!t->libres && t->nbBlocs >= t->maxBlocs)
+        traj_sortir_premier(t);
+    if (t->libres) {
+        b = t->libres;
+        t->libres = b->suivant;
+    } else {
+        b = (BlocTrajectoires*)malloc(sizeof(BlocTrajectoires) + TRAJ_TAILLE_BLOC * TRAJ_OCTETS_PAR_DEPLACEMENT);
+        if (!b) return NULL;
+        b->vehicule = (int*)(b + 1);
+        b->temps = (unsigned int*)(b->vehicule + TRAJ_TAILLE_BLOC);
+        b->noeud = (int*)(b->temps + TRAJ_TAILLE_BLOC);
+        b->arete = b->noeud + TRAJ_TAILLE_BLOC;
+        t->nbBlocs++;
+    }
+    b->nb = 0;
+    b->suivant = NULL;
+    if (t->dernier) t->dernier->suivant = b;
+    else t->premier = b;
+    t->dernier = b;
+    return b;
+}
+
+/**
+ * Enregistre un déplacement. Les dates doivent être croissantes (horloge de la simulation).
+ */
+void trajectoires_enregistrer(Trajectoires* t, int vehicule, double date, int noeud, int arete) {
+    unsigned int d = traj_date(date);
+    // Blocs sortis de la fenêtre de rétention (le bloc en cours reste en mémoire)
+    if (t->retention > 0) {
+        unsigned int limite = traj_date(date - t->retention);
+        while (t->premier && t->premier != t->dernier && t->premier->tMax < limite)
+            traj_sortir_premier(t);
+    }
+    BlocTrajectoires* b = t->dernier;
+    if (!b || b->nb == TRAJ_TAILLE_BLOC) {
+        b = traj_nouveau_bloc(t);
+        if (!b) {
+            t->nbOublies++;
+            return;
+        }
+    }
+    if (b->nb == 0) b->tMin = d;
+    b->tMax = d;
+    b->vehicule[b->nb] = vehicule;
+    b->temps[b->nb] = d;
+    b->noeud[b->nb] = noeud;
+    b->arete[b->nb] = arete;
+    b->nb++;
+    t->nbEnregistres++;
+}
+
+/**
+ * Parcourt les déplacements en mémoire d'un véhicule (-1 : tous) entre deux dates incluses,
+ * dans l'ordre chronologique. Retourne le nombre de déplacements trouvés.
+ */
+long trajectoires_parcourir(const Trajectoires* t, int vehicule, double debut, double fin,
+                            void (*visiter)(void* contexte, int vehicule, double date, int noeud, int arete), void* contexte) {
+    unsigned int d0 = traj_date(debut), d1 = traj_date(fin);
+    long trouves = 0;
+    const BlocTrajectoires* b;
+    for (b = t->premier; b; b = b->suivant) {
+        if (b->nb == 0 || b->tMax < d0 || b->tMin > d1) continue;
+        int i;
+        for (i = 0; i < b->nb; i++) {
+            if ((vehicule >= 0 && b->vehicule[i] != vehicule) || b->temps[i] < d0 || b->temps[i] > d1)
+                continue;
+            trouves++;
+            if (visiter) visiter(contexte, b->vehicule[i], b->temps[i] / 100.0, b->noeud[i], b->arete[i]);
+        }
+    }
+    return trouves;
+}
+
+/**
+ * Même parcours sur un fichier de débordement : les colonnes des blocs hors période ne sont pas lues.
+ * Retourne -1 si le fichier est illisible.
+ */
+long trajectoires_parcourir_fichier(const char* fichier, int vehicule, double debut, double fin,
+                                    void (*visiter)(void* contexte, int vehicule, double date, int noeud, int arete), void* contexte) {
+    FILE* f = fopen(fichier, "rb");
+    if (!f) return -1;
+    char magie[4];
+    int version, taille;
+    if (fread(magie, 1, 4, f) != 4 || memcmp(magie, "TRAJ", 4) != 0 ||
+        fread(&version, sizeof(int), 1, f) != 1 || version != 1 || fread(&taille, sizeof(int), 1, f) != 1 ||
+        taille != TRAJ_TAILLE_BLOC) {
+        fclose(f);
+        return -1;
+    }
+    unsigned int d0 = traj_date(debut), d1 = traj_date(fin);
+    long trouves = 0;
+    int* colonnes = (int*)malloc(TRAJ_TAILLE_BLOC * TRAJ_OCTETS_PAR_DEPLACEMENT);
+    int nb;
+    unsigned int tMin, tMax;
+    while (colonnes && fread(&nb, sizeof(int), 1, f) == 1 && nb >= 0 && nb <= TRAJ_TAILLE_BLOC &&
+           fread(&tMin, sizeof(unsigned int), 1, f) == 1 && fread(&tMax, sizeof(unsigned int), 1, f) == 1) {
+        if (tMax < d0 || tMin > d1) {
+            fseek(f, (long)nb * TRAJ_OCTETS_PAR_DEPLACEMENT, SEEK_CUR);
+            continue;
+        }
+        if (fread(colonnes, TRAJ_OCTETS_PAR_DEPLACEMENT, nb, f) != (size_t)nb) break;
+        int* vehicules = colonnes;
+        unsigned int* temps = (unsigned int*)(colonnes + nb);
+        int* noeuds = (int*)(temps + nb);
+        int* aretes = noeuds + nb;
+        int i;
+        for (i = 0; i < nb; i++) {
+            if ((vehicule >= 0 && vehicules[i] != vehicule) || temps[i] < d0 || temps[i] > d1)
+                continue;
+            trouves++;
+            if (visiter) visiter(contexte, vehicules[i], temps[i] / 100.0, noeuds[i], aretes[i]);
+        }
+    }
+    free(colonnes);
+    fclose(f);
+    return trouves;
+}
+
+/**
+ * Libère l'enregistreur. Avec un fichier de débordement, les blocs encore en mémoire y sont écrits
+ * d'abord, de sorte que le fichier contienne toute la journée.
+ */
+void trajectoires_liberer(Trajectoires* t) {
+    if (t->disque || t->erreurDisque) {
+        while (t->premier) traj_sortir_premier(t); // Oubliés si une écriture a échoué
+        if (t->disque && fclose(t->disque) != 0) t->erreurDisque = 1;
+        t->disque = NULL;
+    }
+    BlocTrajectoires* listes[2] = { t->premier, t->libres };
+    int k;
+    for (k = 0; k < 2; k++) {
+        BlocTrajectoires* b = listes[k];
+        while (b) {
+            BlocTrajectoires* suivant = b->suivant;
+            free(b);
+            b = suivant;
+        }
+    }
+    t->premier = t->dernier = t->libres = NULL;
+    t->nbBlocs = 0;
+}
+
+#endif
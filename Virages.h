@@ -0,0 +1,366 @@
+#ifndef VIRAGES_H
+#define VIRAGES_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "Reseau.h"
+#include "Recherche.h"
+#include "RoutageTemporel.h"
+
+/* ===================== Coûts de virage ===================== */
+/*
+ * Le coût d'un virage au nœud v, de l'arête entrante a -> v vers l'arête sortante v -> w, vient de
+ * sa classe (tout droit, droite, gauche, demi-tour), déduite des coordonnées des trois nœuds, et
+ * des exceptions propres au nœud (virage interdit ou coût fixé). Les exceptions sont rangées par
+ * nœud : un carrefour ordinaire ne coûte qu'un test, et le graphe des arêtes n'est jamais construit.
+ * Les coordonnées sont celles de l'écran (Y vers le bas) : le virage est à droite quand le produit
+ * vectoriel (v - a) x (w - v) est positif.
+ */
+
+typedef enum { VIRAGE_TOUT_DROIT, VIRAGE_DROITE, VIRAGE_GAUCHE, VIRAGE_DEMI_TOUR } ClasseVirage;
+
+typedef struct {
+    int noeud;
+    int entree;          // Arête d'origine qui arrive au nœud
+    int sortie;          // Arête d'origine qui en repart
+    double cout;         // Coût du virage (s), INFINITY s'il est interdit
+} ExceptionVirage;
+
+typedef struct {
+    double cout[4];          // Coût (s) de chaque classe de virage, INFINITY : interdit
+    double supplementFeu;    // Ajouté à un virage à gauche ou un demi-tour sur un nœud à feux
+    double cosToutDroit;     // Cosinus de l'angle entre les deux directions au-delà duquel on va tout droit
+    int nbExceptions;
+    int capacite;
+    ExceptionVirage* exceptions;
+    int nbIndexees;          // Exceptions rangées par nœud ; les suivantes attendent virages_indexer
+    int nbNoeuds;
+    int* debut;              // Exceptions du nœud v : exceptions[debut[v] .. debut[v+1]-1]
+} Virages;
+
+void virages_liberer(Virages* v) {
+    free(v->exceptions);
+    free(v->debut);
+    v->exceptions = NULL;
+    v->debut = NULL;
+    v->nbExceptions = v->capacite = v->nbIndexees = v->nbNoeuds = 0;
+}
+
+/**
+ * Tables de virages sans exception : coûts (s) d'un virage à droite, à gauche et d'un demi-tour,
+ * supplément d'un virage à gauche aux feux. Tout droit est gratuit.
+ */
+void virages_init(Virages* v, double droite, double gauche, double demiTour, double supplementFeu) {
+    memset(v, 0, sizeof(Virages));
+    v->cout[VIRAGE_TOUT_DROIT] = 0.0;
+    v->cout[VIRAGE_DROITE] = droite;
+    v->cout[VIRAGE_GAUCHE] = gauche;
+    v->cout[VIRAGE_DEMI_TOUR] = demiTour;
+    v->supplementFeu = supplementFeu;
+    v->cosToutDroit = 0.866; // 30 degrés
+}
+
+/* Exception (noeud, entree, sortie) déjà connue, ou NULL */
+static ExceptionVirage* virages_chercher(const Virages* v, int noeud, int entree, int sortie) {
+    int i;
+    if (noeud >= 0 && noeud < v->nbNoeuds)
+        for (i = v->debut[noeud]; i < v->debut[noeud + 1]; i++)
+            if (v->exceptions[i].entree == entree && v->exceptions[i].sortie == sortie)
+                return &v->exceptions[i];
+    for (i = v->nbIndexees; i < v->nbExceptions; i++)
+        if (v->exceptions[i].noeud == noeud && v->exceptions[i].entree == entree && v->exceptions[i].sortie == sortie)
+            return &v->exceptions[i];
+    return NULL;
+}
+
+/**
+ * Fixe le coût du virage de l'arête entree vers l'arête sortie au nœud (INFINITY : interdit).
+ * Un nouveau virage n'est vu des recherches qu'après virages_indexer. Retourne 0 si la mémoire manque.
+ */
+int virages_fixer(Virages* v, int noeud, int entree, int sortie, double cout) {
+    ExceptionVirage* x = virages_chercher(v, noeud, entree, sortie);
+    if (x) {
+        x->cout = cout;
+        return 1;
+    }
+    if (v->nbExceptions == v->capacite) {
+        int capacite = v->capacite ? 2 * v->capacite : 16;
+        ExceptionVirage* t = (ExceptionVirage*)realloc(v->exceptions, sizeof(ExceptionVirage) * capacite);
+        if (!t) return 0;
+        v->exceptions = t;
+        v->capacite = capacite;
+    }
+    x = &v->exceptions[v->nbExceptions++];
+    x->noeud = noeud;
+    x->entree = entree;
+    x->sortie = sortie;
+    x->cout = cout;
+    return 1;
+}
+
+static inline int virages_interdire(Virages* v, int noeud, int entree, int sortie) {
+    return virages_fixer(v, noeud, entree, sortie, INFINITY);
+}
+
+static inline int virages_a_indexer(const Virages* v, int nbNoeuds) {
+    return v->nbIndexees < v->nbExceptions || v->nbNoeuds < nbNoeuds;
+}
+
+/**
+ * Range les exceptions par nœud (tri par comptage) pour un réseau de nbNoeuds nœuds. Les exceptions
+ * sur un nœud hors du réseau sont ignorées. Retourne 0 si la mémoire manque.
+ */
+int virages_indexer(Virages* v, int nbNoeuds) {
+    int* debut = (int*)calloc(nbNoeuds + 1, sizeof(int));
+    ExceptionVirage* t = (ExceptionVirage*)malloc(sizeof(ExceptionVirage) * (v->nbExceptions > 0 ? v->nbExceptions : 1));
+    int i, n = 0;
+    if (!debut || !t) {
+        free(debut);
+        free(t);
+        return 0;
+    }
+    for (i = 0; i < v->nbExceptions; i++)
+        if (v->exceptions[i].noeud >= 0 && v->exceptions[i].noeud < nbNoeuds) debut[v->exceptions[i].noeud + 1]++;
+    for (i = 0; i < nbNoeuds; i++) debut[i + 1] += debut[i];
+    for (i = 0; i < v->nbExceptions; i++)
+        if (v->exceptions[i].noeud >= 0 && v->exceptions[i].noeud < nbNoeuds) {
+            t[debut[v->exceptions[i].noeud]++] = v->exceptions[i];
+            n++;
+        }
+    for (i = nbNoeuds; i > 0; i--) debut[i] = debut[i - 1];
+    debut[0] = 0;
+    if (n > 0) memcpy(v->exceptions, t, sizeof(ExceptionVirage) * n);
+    free(t);
+    free(v->debut);
+    v->debut = debut;
+    v->nbNoeuds = nbNoeuds;
+    v->nbExceptions = v->nbIndexees = n;
+    return 1;
+}
+
+/* Classe du virage a -> noeud -> w d'après les coordonnées */
+static inline ClasseVirage virage_classe(const Virages* v, const Reseau* r, int a, int noeud, int w) {
+    if (w == a) return VIRAGE_DEMI_TOUR;
+    double ax = r->X[noeud] - r->X[a], ay = r->Y[noeud] - r->Y[a];
+    double bx = r->X[w] - r->X[noeud], by = r->Y[w] - r->Y[noeud];
+    // Comparaisons des cosinus au carré : pas de racine dans la boucle des recherches
+    double produit = ax * bx + ay * by, normes2 = (ax * ax + ay * ay) * (bx * bx + by * by);
+    if (produit >= 0 && produit * produit >= v->cosToutDroit * v->cosToutDroit * normes2) return VIRAGE_TOUT_DROIT;
+    if (produit < 0 && produit * produit >= 0.970 * normes2) return VIRAGE_DEMI_TOUR; // Plus de 170 degrés
+    return ax * by - ay * bx > 0 ? VIRAGE_DROITE : VIRAGE_GAUCHE;
+}
+
+/**
+ * Coût (s) du virage au nœud de l'arête entree (venant de a) vers l'arête sortie (allant à w) ;
+ * INFINITY s'il est interdit. feu : le nœud porte un feu. v peut être NULL (virages gratuits).
+ */
+static inline double virage_cout(const Virages* v, const Reseau* r, int a, int noeud, int w, int entree, int sortie,
+                                 int feu) {
+    int i;
+    if (!v) return 0.0;
+    if (noeud < v->nbNoeuds)
+        for (i = v->debut[noeud]; i < v->debut[noeud + 1]; i++)
+            if (v->exceptions[i].entree == entree && v->exceptions[i].sortie == sortie)
+                return v->exceptions[i].cout;
+    ClasseVirage c = virage_classe(v, r, a, noeud, w);
+    double cout = v->cout[c];
+    if (feu && (c == VIRAGE_GAUCHE || c == VIRAGE_DEMI_TOUR)) cout += v->supplementFeu;
+    return cout;
+}
+
+/* ===================== Recherche sur les arêtes ===================== */
+
+/* Espace de travail : un état par arête, et la meilleure arrivée à chaque nœud */
+typedef struct {
+    EspaceRecherche aretes;
+    int nbNoeuds;
+    double* premiere;        // Meilleure date d'arrivée connue au nœud pendant le passage
+    int* premiereArete;      // Arête qui la donne
+    unsigned int* marque;    // Passage (de aretes) qui a fixé premiere
+} EspaceVirages;
+
+void espace_virages_liberer(EspaceVirages* e) {
+    espace_liberer(&e->aretes);
+    free(e->premiere);
+    free(e->premiereArete);
+    free(e->marque);
+    e->premiere = NULL;
+    e->premiereArete = NULL;
+    e->marque = NULL;
+    e->nbNoeuds = 0;
+}
+
+int espace_virages_init(EspaceVirages* e, int nbNoeuds, int nbAretes) {
+    e->nbNoeuds = nbNoeuds;
+    e->premiere = (double*)malloc(sizeof(double) * (nbNoeuds > 0 ? nbNoeuds : 1));
+    e->premiereArete = (int*)malloc(sizeof(int) * (nbNoeuds > 0 ? nbNoeuds : 1));
+    e->marque = (unsigned int*)calloc(nbNoeuds > 0 ? nbNoeuds : 1, sizeof(unsigned int));
+    if (!e->premiere || !e->premiereArete || !e->marque || !espace_init(&e->aretes, nbAretes)) {
+        free(e->premiere);
+        free(e->premiereArete);
+        free(e->marque);
+        e->premiere = NULL;
+        e->premiereArete = NULL;
+        e->marque = NULL;
+        e->nbNoeuds = 0;
+        return 0;
+    }
+    return 1;
+}
+
+/* Plus grand coût d'un virage permis sans exception (INFINITY si une classe est interdite) */
+static double virages_cout_max(const Virages* v) {
+    double max = 0.0;
+    int c;
+    if (!v) return 0.0;
+    for (c = 0; c < 4; c++)
+        if (v->cout[c] > max) max = v->cout[c];
+    return max + (v->supplementFeu > 0 ? v->supplementFeu : 0.0);
+}
+
+/*
+ * Arrivée par l'arête j à la date 'date' : ignorée si une autre arête arrive au même nœud (sans
+ * exception) au moins 'marge' plus tôt, car celle-ci fait au moins aussi bien dans toutes les
+ * directions ; sinon mise dans le tas.
+ */
+static inline void virages_relacher(const Reseau* r, const Virages* v, EspaceVirages* ev, int j, double date,
+                                    int parent, double marge, double borne, int cible) {
+    EspaceRecherche* e = &ev->aretes;
+    int w = r->cible[j];
+    if (date >= espace_dist(e, j)) return;
+    if (ev->marque[w] == e->passage) {
+        if (date < ev->premiere[w]) {
+            ev->premiere[w] = date;
+            ev->premiereArete[w] = j;
+        } else if (ev->premiereArete[w] != j && date >= ev->premiere[w] + marge &&
+                   (!v || w >= v->nbNoeuds || v->debut[w] == v->debut[w + 1])) {
+            return;
+        }
+    } else {
+        ev->marque[w] = e->passage;
+        ev->premiere[w] = date;
+        ev->premiereArete[w] = j;
+    }
+    espace_fixer(e, j, date, parent, j);
+    double h = 0.0;
+    if (borne > 0) {
+        double dx = r->X[w] - r->X[cible], dy = r->Y[w] - r->Y[cible];
+        h = sqrt(dx * dx + dy * dy) * borne;
+    }
+    tas_inserer(&e->tas, date + h, j);
+}
+
+/**
+ * Itinéraire dépendant du temps qui fait payer les virages : l'état de la recherche est l'arête
+ * (indice CSR) par laquelle on arrive à un nœud, et les arêtes sortantes sont parcourues sur le
+ * réseau lui-même. Les virages n'ont pas de coût au départ ni à l'arrivée. Le coût de
+ * l'itinéraire est la date d'arrivée ; v peut être NULL (même résultat qu'itineraire_temporel).
+ *
+ * Une arête qui arrive à un nœud sans exception plus tard que la meilleure arrivée, augmentée du
+ * plus cher des virages, n'est ni mise dans le tas ni prolongée. Avec des virages gratuits, la
+ * recherche ne fait donc guère plus de travail que sur les nœuds.
+ */
+Itineraire itineraire_virages(const Reseau* r, const ParametresTemporels* prm, const Virages* v, int source,
+                              int cible, double depart, EspaceVirages* ev) {
+    Itineraire it = { NULL, 0, 0.0 };
+    EspaceRecherche* e = &ev->aretes;
+    if (source < 0 || source >= r->nbNoeuds || cible < 0 || cible >= r->nbNoeuds || prm->vitesse <= 0 ||
+        e->nbNoeuds < r->nbAretes || ev->nbNoeuds < r->nbNoeuds)
+        return it;
+    if (source == cible) {
+        it.noeuds = (int*)malloc(sizeof(int));
+        if (!it.noeuds) return it;
+        it.noeuds[0] = source;
+        it.longueur = 1;
+        it.cout = depart;
+        return it;
+    }
+    double borne = 0.0; // Borne inférieure du temps par unité de distance euclidienne
+    if (prm->heuristique) {
+        double fmin = prm->profils ? prm->profils->facteurMin : 1.0;
+        borne = (fmin < 1.0 ? fmin : 1.0) / prm->vitesse;
+    }
+    double marge = virages_cout_max(v);
+    int k, j, arrivee = -1;
+    espace_nouvelle_recherche(e);
+    if (e->passage == 1) memset(ev->marque, 0, sizeof(unsigned int) * ev->nbNoeuds); // Numéros recommencés
+    // Départ : chaque arête sortante de la source, sans virage
+    for (k = r->debut[source]; k < r->debut[source + 1]; k++)
+        if (!arete_fermee(prm->fermetures, r->idArete[k]))
+            virages_relacher(r, v, ev, k, arrivee_arete(r, prm, k, depart), -1, marge, borne, cible);
+    while (e->tas.taille > 0) {
+        ElementTas x = tas_extraire(&e->tas);
+        k = x.valeur;
+        int noeud = r->cible[k];
+        double dk = espace_dist(e, k), hk = 0.0;
+        if (borne > 0) {
+            double dx = r->X[noeud] - r->X[cible], dy = r->Y[noeud] - r->Y[cible];
+            hk = sqrt(dx * dx + dy * dy) * borne;
+        }
+        if (x.cle > dk + hk + 1e-9) continue; // Entrée périmée
+        if (noeud == cible) {
+            arrivee = k;
+            break;
+        }
+        // Arrivée dominée par une meilleure au même nœud, trouvée depuis la mise dans le tas
+        if (ev->premiereArete[noeud] != k && dk >= ev->premiere[noeud] + marge &&
+            (!v || noeud >= v->nbNoeuds || v->debut[noeud] == v->debut[noeud + 1]))
+            continue;
+        int a = e->parent[k] >= 0 ? r->cible[e->parent[k]] : source;
+        int feu = prm->indexFeux && prm->indexFeux->debut[noeud] < prm->indexFeux->debut[noeud + 1];
+        for (j = r->debut[noeud]; j < r->debut[noeud + 1]; j++) {
+            if (arete_fermee(prm->fermetures, r->idArete[j])) continue;
+            double virage = virage_cout(v, r, a, noeud, r->cible[j], r->idArete[k], r->idArete[j], feu);
+            if (virage == INFINITY) continue;
+            virages_relacher(r, v, ev, j, arrivee_arete(r, prm, j, dk + virage), k, marge, borne, cible);
+        }
+    }
+    if (arrivee < 0) return it;
+    // Chemin : la source, puis le bout de chaque arête en remontant les parents
+    int n = 1;
+    for (k = arrivee; k >= 0; k = e->parent[k]) n++;
+    it.noeuds = (int*)malloc(sizeof(int) * n);
+    if (!it.noeuds) return it;
+    it.longueur = n;
+    it.cout = e->dist[arrivee];
+    for (k = arrivee; k >= 0; k = e->parent[k]) it.noeuds[--n] = r->cible[k];
+    it.noeuds[0] = source;
+    return it;
+}
+
+/**
+ * Date d'arrivée en suivant les nœuds de l'itinéraire, virages compris (entre deux nœuds, l'arête
+ * ouverte la plus rapide). INFINITY si un virage est interdit ou si deux nœuds ne sont pas reliés.
+ * Sert à chiffrer un itinéraire calculé sans les virages.
+ */
+double itineraire_duree_virages(const Reseau* r, const ParametresTemporels* prm, const Virages* v,
+                                const Itineraire* it, double depart) {
+    double t = depart;
+    int i, k, precedente = -1;
+    for (i = 1; i < it->longueur; i++) {
+        int u = it->noeuds[i - 1], w = it->noeuds[i], meilleure = -1;
+        double meilleur = INFINITY;
+        for (k = r->debut[u]; k < r->debut[u + 1]; k++) {
+            if (r->cible[k] != w || arete_fermee(prm->fermetures, r->idArete[k])) continue;
+            double virage = 0.0;
+            if (precedente >= 0) {
+                int feu = prm->indexFeux && prm->indexFeux->debut[u] < prm->indexFeux->debut[u + 1];
+                virage = virage_cout(v, r, it->noeuds[i - 2], u, w, r->idArete[precedente], r->idArete[k], feu);
+            }
+            if (virage == INFINITY) continue;
+            double a = arrivee_arete(r, prm, k, t + virage);
+            if (a < meilleur) {
+                meilleur = a;
+                meilleure = k;
+            }
+        }
+        if (meilleure < 0) return INFINITY;
+        t = meilleur;
+        precedente = meilleure;
+    }
+    return t;
+}
+
+#endif